@@ -3,6 +3,7 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include "py/mphal.h"
 #include "py/runtime.h"
 #include "py/stream.h"
 #include "extmod/vfs_posix.h"
@@ -73,6 +73,10 @@
 #include "shared-module/displayio/__init__.h"
 #endif
 
+#if CIRCUITPY_IOT
+#include "shared-module/iot/__init__.h"
+#endif
+
 #if CIRCUITPY_MEMORYMONITOR
 #include "shared-module/memorymonitor/__init__.h"
 #endif
@@ -227,6 +231,9 @@ STATIC void cleanup_after_vm(supervisor_allocation* heap) {
     #if CIRCUITPY_MEMORYMONITOR
     memorymonitor_reset();
     #endif
+    #if CIRCUITPY_IOT
+    iot_reset();
+    #endif
     filesystem_flush();
     stop_mp();
     free_memory(heap);
@@ -88,6 +88,8 @@ STATIC int usage(char **argv) {
 "-msmall-int-bits=number : set the maximum bits used to encode a small-int\n"
 "-mno-unicode : don't support unicode in compiled strings\n"
 "-mcache-lookup-bc : cache map lookups in the bytecode\n"
+"-msuperinstructions : fuse common opcode sequences into superinstructions\n"
+"-mno-superinstructions : don't fuse common opcode sequences into superinstructions (the default)\n"
 "\n"
 "Implementation specific options:\n", argv[0]
 );
@@ -172,6 +174,7 @@ MP_NOINLINE int main_(int argc, char **argv) {
     mp_dynamic_compiler.small_int_bits = 31;
     mp_dynamic_compiler.opt_cache_map_lookup_in_bytecode = 0;
     mp_dynamic_compiler.py_builtins_str_unicode = 1;
+    mp_dynamic_compiler.opt_superinstructions = 0;
 
     const char *input_file = NULL;
     const char *output_file = NULL;
@@ -215,6 +218,10 @@ MP_NOINLINE int main_(int argc, char **argv) {
                 mp_dynamic_compiler.opt_cache_map_lookup_in_bytecode = 0;
             } else if (strcmp(argv[a], "-mcache-lookup-bc") == 0) {
                 mp_dynamic_compiler.opt_cache_map_lookup_in_bytecode = 1;
+            } else if (strcmp(argv[a], "-mno-superinstructions") == 0) {
+                mp_dynamic_compiler.opt_superinstructions = 0;
+            } else if (strcmp(argv[a], "-msuperinstructions") == 0) {
+                mp_dynamic_compiler.opt_superinstructions = 1;
             } else if (strcmp(argv[a], "-mno-unicode") == 0) {
                 mp_dynamic_compiler.py_builtins_str_unicode = 0;
             } else if (strcmp(argv[a], "-municode") == 0) {
@@ -60,6 +60,10 @@ STATIC uint emit_opt = MP_EMIT_OPT_NONE;
 // Heap size of GC heap (if enabled)
 // Make it larger on a 64 bit machine, because pointers are larger.
 long heap_size = 1024*1024 * (sizeof(mp_uint_t) / 4);
+#if MICROPY_GC_SPLIT_HEAP
+// Size of a second heap area, for large objects (0 for none)
+long large_heap_size = 1024*1024 * (sizeof(mp_uint_t) / 4);
+#endif
 #endif
 
 STATIC void stderr_print_strn(void *env, const char *str, size_t len) {
@@ -321,6 +325,11 @@ STATIC int usage(char **argv) {
 "  heapsize=<n>[w][K|M] -- set the heap size for the GC (default %ld)\n"
 , heap_size);
     impl_opts_cnt++;
+#endif
+#if MICROPY_GC_SPLIT_HEAP
+    printf(
+"  largeheap=<n>[w][K|M] -- set the size of the GC heap area for large objects (default %ld)\n"
+, large_heap_size);
 #endif
 
     if (impl_opts_cnt == 0) {
@@ -330,6 +339,40 @@ STATIC int usage(char **argv) {
     return 1;
 }
 
+#if MICROPY_ENABLE_GC
+// Parse a heap size given as <n>[w][K|M], returning -1 if it is invalid
+STATIC long parse_heap_size(const char *arg) {
+    char *end;
+    long size = strtol(arg, &end, 0);
+    // Don't bring unneeded libc dependencies like tolower()
+    // If there's 'w' immediately after number, adjust it for
+    // target word size. Note that it should be *before* size
+    // suffix like K or M, to avoid confusion with kilowords,
+    // etc. the size is still in bytes, just can be adjusted
+    // for word size (taking 32bit as baseline).
+    bool word_adjust = false;
+    if ((*end | 0x20) == 'w') {
+        word_adjust = true;
+        end++;
+    }
+    if ((*end | 0x20) == 'k') {
+        size *= 1024;
+    } else if ((*end | 0x20) == 'm') {
+        size *= 1024 * 1024;
+    } else {
+        // Compensate for ++ below
+        --end;
+    }
+    if (*++end != 0) {
+        return -1;
+    }
+    if (word_adjust) {
+        size = size * BYTES_PER_WORD / 4;
+    }
+    return size;
+}
+#endif
+
 // Process options which set interpreter init options
 STATIC void pre_process_options(int argc, char **argv) {
     for (int a = 1; a < argc; a++) {
@@ -349,37 +392,19 @@ STATIC void pre_process_options(int argc, char **argv) {
                     emit_opt = MP_EMIT_OPT_VIPER;
 #if MICROPY_ENABLE_GC
                 } else if (strncmp(argv[a + 1], "heapsize=", sizeof("heapsize=") - 1) == 0) {
-                    char *end;
-                    heap_size = strtol(argv[a + 1] + sizeof("heapsize=") - 1, &end, 0);
-                    // Don't bring unneeded libc dependencies like tolower()
-                    // If there's 'w' immediately after number, adjust it for
-                    // target word size. Note that it should be *before* size
-                    // suffix like K or M, to avoid confusion with kilowords,
-                    // etc. the size is still in bytes, just can be adjusted
-                    // for word size (taking 32bit as baseline).
-                    bool word_adjust = false;
-                    if ((*end | 0x20) == 'w') {
-                        word_adjust = true;
-                        end++;
-                    }
-                    if ((*end | 0x20) == 'k') {
-                        heap_size *= 1024;
-                    } else if ((*end | 0x20) == 'm') {
-                        heap_size *= 1024 * 1024;
-                    } else {
-                        // Compensate for ++ below
-                        --end;
-                    }
-                    if (*++end != 0) {
-                        goto invalid_arg;
-                    }
-                    if (word_adjust) {
-                        heap_size = heap_size * BYTES_PER_WORD / 4;
-                    }
+                    heap_size = parse_heap_size(argv[a + 1] + sizeof("heapsize=") - 1);
                     // If requested size too small, we'll crash anyway
                     if (heap_size < 700) {
                         goto invalid_arg;
                     }
+#endif
+#if MICROPY_GC_SPLIT_HEAP
+                } else if (strncmp(argv[a + 1], "largeheap=", sizeof("largeheap=") - 1) == 0) {
+                    large_heap_size = parse_heap_size(argv[a + 1] + sizeof("largeheap=") - 1);
+                    // 0 means no area for large objects
+                    if (large_heap_size != 0 && large_heap_size < 700) {
+                        goto invalid_arg;
+                    }
 #endif
                 } else {
 invalid_arg:
@@ -442,6 +467,14 @@ MP_NOINLINE int main_(int argc, char **argv) {
     char *heap = malloc(heap_size);
     gc_init(heap, heap + heap_size);
 #endif
+#if MICROPY_GC_SPLIT_HEAP
+    // a separate arena stands in for external RAM
+    char *large_heap = NULL;
+    if (large_heap_size != 0) {
+        large_heap = malloc(large_heap_size);
+        gc_add(large_heap, large_heap + large_heap_size);
+    }
+#endif
 
     #if MICROPY_ENABLE_PYSTACK
     static mp_obj_t pystack[1024];
@@ -665,6 +698,9 @@ MP_NOINLINE int main_(int argc, char **argv) {
     // We don't really need to free memory since we are about to exit the
     // process, but doing so helps to find memory leaks.
     free(heap);
+    #if MICROPY_GC_SPLIT_HEAP
+    free(large_heap);
+    #endif
 #endif
 
     //printf("total bytes = %d\n", m_get_total_bytes_allocated());
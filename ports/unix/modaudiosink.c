@@ -0,0 +1,208 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2021 MicroPython & CircuitPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Plays audio samples into files on the unix port, for benchmarking and
+// testing the audiocore and audiomixer code without audio hardware. Buffers
+// are pulled from the sample the same way an audio output does.
+
+#include <time.h>
+
+#include "py/mperrno.h"
+#include "py/mphal.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+#include "shared-module/audiocore/__init__.h"
+#include "supervisor/background_callback.h"
+#include "supervisor/shared/translate.h"
+
+#if MICROPY_PY_AUDIO
+
+// The unix port has no supervisor, so the queue of background callbacks lives
+// here. audiosink.play runs it between buffers, like the supervisor does
+// between the bytecodes of the running program.
+STATIC background_callback_t *callback_head, *callback_tail;
+
+void background_callback_add_core(background_callback_t *cb) {
+    if (cb->prev || callback_head == cb) {
+        return;
+    }
+    cb->next = NULL;
+    cb->prev = callback_tail;
+    if (callback_tail) {
+        callback_tail->next = cb;
+    }
+    if (!callback_head) {
+        callback_head = cb;
+    }
+    callback_tail = cb;
+}
+
+void background_callback_add(background_callback_t *cb, background_callback_fun fun, void *data) {
+    cb->fun = fun;
+    cb->data = data;
+    background_callback_add_core(cb);
+}
+
+void background_callback_run_all(void) {
+    background_callback_t *cb = callback_head;
+    callback_head = NULL;
+    callback_tail = NULL;
+    while (cb) {
+        background_callback_t *next = cb->next;
+        cb->next = cb->prev = NULL;
+        cb->fun(cb->data);
+        cb = next;
+    }
+}
+
+STATIC uint64_t cpu_time_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//| def write(sample: audiosample, stream: Optional[stream], frames: int) -> int:
+//|     """Reads up to ``frames`` frames from ``sample`` and writes them to
+//|     ``stream``, or drops them when it is None. Like an audio output that keeps
+//|     playing, each call carries on from where the last one stopped; the sample
+//|     isn't reset, so voices started on a Mixer keep playing. Returns the number
+//|     of frames read, which is fewer than ``frames`` when the sample ends."""
+//|     ...
+//|
+STATIC mp_obj_t audiosink_write(mp_obj_t sample, mp_obj_t stream, mp_obj_t frames_in) {
+    mp_int_t frames = mp_obj_get_int(frames_in);
+    uint32_t frame_size = audiosample_channel_count(sample) * audiosample_bits_per_sample(sample) / 8;
+    uint64_t remaining = frames * frame_size;
+
+    while (remaining > 0) {
+        uint8_t *buffer;
+        uint32_t buffer_length;
+        audioio_get_buffer_result_t result = audiosample_get_buffer(sample, false, 0, &buffer, &buffer_length);
+        if (result == GET_BUFFER_ERROR) {
+            mp_raise_OSError(MP_EIO);
+        }
+        buffer_length = MIN(buffer_length, remaining);
+        if (stream != mp_const_none) {
+            mp_stream_write(stream, buffer, buffer_length, MP_STREAM_RW_WRITE);
+        }
+        remaining -= buffer_length;
+        if (result == GET_BUFFER_DONE) {
+            break;
+        }
+    }
+    return MP_OBJ_NEW_SMALL_INT(frames - remaining / frame_size);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(audiosink_write_obj, audiosink_write);
+
+//| def play(sample: audiosample, stream: Optional[stream], frames: int) -> Tuple[int, int, int]:
+//|     """Plays up to ``frames`` frames of ``sample`` from the start in real time,
+//|     writing them to ``stream`` like `write`. Buffers are requested the way a
+//|     double buffered DMA output does: the next buffer is requested when one
+//|     starts playing and must be ready before it finishes. Background callbacks
+//|     run while waiting for the next request.
+//|
+//|     Returns a tuple of the number of frames played, the number of underruns,
+//|     which are buffers that weren't ready in time, and the CPU time in
+//|     microseconds spent getting buffers and running background callbacks."""
+//|     ...
+//|
+STATIC mp_obj_t audiosink_play(mp_obj_t sample, mp_obj_t stream, mp_obj_t frames_in) {
+    mp_int_t frames = mp_obj_get_int(frames_in);
+    uint32_t frame_size = audiosample_channel_count(sample) * audiosample_bits_per_sample(sample) / 8;
+    uint32_t sample_rate = audiosample_sample_rate(sample);
+    uint64_t remaining = frames * frame_size;
+    mp_uint_t underruns = 0;
+    uint64_t cpu_time = 0;
+
+    audiosample_reset_buffer(sample, false, 0);
+    // When the buffer being played started and when the buffers queued after it run out.
+    mp_uint_t playing_start = mp_hal_ticks_us();
+    mp_uint_t queue_end = playing_start;
+    for (uint32_t count = 0; remaining > 0; count++) {
+        // The output asks for two buffers when it starts and another each time one starts.
+        if (count >= 2) {
+            uint64_t start = cpu_time_us();
+            background_callback_run_all();
+            cpu_time += cpu_time_us() - start;
+            mp_int_t wait = (mp_int_t)(playing_start - mp_hal_ticks_us());
+            if (wait > 0) {
+                mp_hal_delay_us(wait);
+            }
+        }
+
+        uint8_t *buffer;
+        uint32_t buffer_length;
+        uint64_t start = cpu_time_us();
+        audioio_get_buffer_result_t result = audiosample_get_buffer(sample, false, 0, &buffer, &buffer_length);
+        cpu_time += cpu_time_us() - start;
+        if (result == GET_BUFFER_ERROR) {
+            mp_raise_OSError(MP_EIO);
+        }
+        mp_uint_t now = mp_hal_ticks_us();
+        if (count == 0) {
+            queue_end = now;
+        } else if (count >= 2 && (mp_int_t)(now - queue_end) > 0) {
+            underruns++;
+            queue_end = now;
+        }
+        if (count > 0) {
+            playing_start = queue_end;
+        }
+        buffer_length = MIN(buffer_length, remaining);
+        queue_end += (uint64_t)buffer_length / frame_size * 1000000 / sample_rate;
+
+        if (stream != mp_const_none) {
+            mp_stream_write(stream, buffer, buffer_length, MP_STREAM_RW_WRITE);
+        }
+        remaining -= buffer_length;
+        if (result == GET_BUFFER_DONE) {
+            break;
+        }
+    }
+    background_callback_run_all();
+
+    mp_obj_t tuple[3] = {
+        MP_OBJ_NEW_SMALL_INT(frames - remaining / frame_size),
+        MP_OBJ_NEW_SMALL_INT(underruns),
+        mp_obj_new_int_from_ull(cpu_time),
+    };
+    return mp_obj_new_tuple(3, tuple);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(audiosink_play_obj, audiosink_play);
+
+STATIC const mp_rom_map_elem_t audiosink_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_audiosink) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&audiosink_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_play), MP_ROM_PTR(&audiosink_play_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(audiosink_module_globals, audiosink_module_globals_table);
+
+const mp_obj_module_t mp_module_audiosink = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&audiosink_module_globals,
+};
+
+#endif // MICROPY_PY_AUDIO
@@ -0,0 +1,266 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2021 MicroPython & CircuitPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// A subset of displayio for benchmarking and testing the renderer on the unix
+// port. Groups are drawn into an RGB565 framebuffer in RAM by MemoryDisplay,
+// which refreshes dirty areas the same way displayio.Display does but without
+// a display bus.
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/displayio/ColorConverter.h"
+#include "shared-bindings/displayio/Group.h"
+#include "shared-bindings/displayio/OnDiskBitmap.h"
+#include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/Shape.h"
+#include "shared-bindings/displayio/TileGrid.h"
+#include "shared-module/displayio/display_core.h"
+#include "shared-module/displayio/tiles.h"
+#include "supervisor/shared/translate.h"
+
+#if MICROPY_PY_DISPLAYIO
+
+typedef struct {
+    mp_obj_base_t base;
+    displayio_display_core_t core;
+    uint16_t *framebuffer;
+    uint16_t tile_size;
+} displayio_memorydisplay_obj_t;
+
+STATIC const mp_obj_type_t displayio_memorydisplay_type;
+
+STATIC bool _refresh_area(void *display, const displayio_area_t* area) {
+    displayio_memorydisplay_obj_t *self = display;
+    uint16_t buffer_size = 128; // In uint32_ts, matching displayio.Display
+
+    displayio_area_t clipped;
+    if (!displayio_area_compute_overlap(&self->core.area, area, &clipped)) {
+        return true;
+    }
+    uint16_t width = displayio_area_width(&clipped);
+    uint16_t rows_per_buffer = buffer_size * 2 / width;
+    if (rows_per_buffer == 0) {
+        rows_per_buffer = 1;
+    }
+    uint32_t buffer[(rows_per_buffer * width + 1) / 2];
+    uint32_t mask_length = (rows_per_buffer * width / 32) + 1;
+    uint32_t mask[mask_length];
+
+    for (int16_t y = clipped.y1; y < clipped.y2; y += rows_per_buffer) {
+        displayio_area_t subrectangle = {
+            .x1 = clipped.x1,
+            .y1 = y,
+            .x2 = clipped.x2,
+            .y2 = MIN(y + rows_per_buffer, clipped.y2)
+        };
+        memset(mask, 0, sizeof(mask));
+        memset(buffer, 0, sizeof(buffer));
+        // Same as displayio_display_core_fill_area, which needs the bus code.
+        if (self->core.layers != NULL) {
+            displayio_layers_fill_area(self->core.layers, self->core.layer_count, &self->core.colorspace, &subrectangle, mask, buffer);
+        } else {
+            displayio_group_fill_area(self->core.current_group, &self->core.colorspace, &subrectangle, mask, buffer);
+        }
+
+        uint16_t *pixels = (uint16_t *)buffer;
+        for (int16_t row = subrectangle.y1; row < subrectangle.y2; row++) {
+            memcpy(self->framebuffer + row * self->core.width + subrectangle.x1, pixels, width * sizeof(uint16_t));
+            pixels += width;
+        }
+    }
+    return true;
+}
+
+//| class MemoryDisplay:
+//|     """Draws a Group into an RGB565 framebuffer in RAM. Only available on
+//|     the unix port."""
+//|
+//|     def __init__(self, width: int, height: int, *, tile_size: int = 0) -> None:
+//|         """Create a display of the given size. tile_size > 0 refreshes in
+//|         tiles of that many pixels, 0 refreshes each dirty area against the
+//|         whole Group like the default build."""
+//|         ...
+//|
+STATIC mp_obj_t displayio_memorydisplay_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_width, ARG_height, ARG_tile_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_INT | MP_ARG_REQUIRED },
+        { MP_QSTR_height, MP_ARG_INT | MP_ARG_REQUIRED },
+        { MP_QSTR_tile_size, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t width = args[ARG_width].u_int;
+    mp_int_t height = args[ARG_height].u_int;
+    if (width <= 0 || width > 0x7fff) {
+        mp_raise_ValueError_varg(translate("%q out of range"), MP_QSTR_width);
+    }
+    if (height <= 0 || height > 0x7fff) {
+        mp_raise_ValueError_varg(translate("%q out of range"), MP_QSTR_height);
+    }
+    if (args[ARG_tile_size].u_int < 0 || args[ARG_tile_size].u_int > 0x7fff) {
+        mp_raise_ValueError_varg(translate("%q out of range"), MP_QSTR_tile_size);
+    }
+
+    displayio_memorydisplay_obj_t *self = m_new_obj(displayio_memorydisplay_obj_t);
+    self->base.type = &displayio_memorydisplay_type;
+    self->framebuffer = m_new(uint16_t, width * height);
+    memset(self->framebuffer, 0, width * height * sizeof(uint16_t));
+    self->tile_size = args[ARG_tile_size].u_int;
+
+    displayio_display_core_t *core = &self->core;
+    memset(core, 0, sizeof(*core));
+    core->colorspace.depth = 16;
+    core->colorspace.pixels_in_byte_share_row = true;
+    core->colorspace.bytes_per_cell = 1;
+    core->width = width;
+    core->height = height;
+    core->ram_width = width;
+    core->ram_height = height;
+    core->transform.scale = 1;
+    core->transform.dx = 1;
+    core->transform.dy = 1;
+    core->area.x2 = width;
+    core->area.y2 = height;
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def show(self, group: Group) -> None:
+//|         """Switch to displaying the given group. The whole display is
+//|         redrawn on the next refresh."""
+//|         ...
+//|
+STATIC mp_obj_t displayio_memorydisplay_obj_show(mp_obj_t self_in, mp_obj_t group_in) {
+    displayio_memorydisplay_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    displayio_group_t *group = native_group(group_in);
+    if (group == self->core.current_group) {
+        return mp_const_none;
+    }
+    if (group->in_group) {
+        mp_raise_ValueError(translate("Group already used"));
+    }
+    if (self->core.current_group != NULL) {
+        self->core.current_group->in_group = false;
+    }
+    displayio_group_update_transform(group, &self->core.transform);
+    group->in_group = true;
+    self->core.current_group = group;
+    self->core.full_refresh = true;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(displayio_memorydisplay_show_obj, displayio_memorydisplay_obj_show);
+
+//|     def refresh(self) -> None:
+//|         """Redraw the areas of the group that changed since the last
+//|         refresh."""
+//|         ...
+//|
+STATIC mp_obj_t displayio_memorydisplay_obj_refresh(mp_obj_t self_in) {
+    displayio_memorydisplay_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    displayio_display_core_t *core = &self->core;
+    if (core->current_group == NULL) {
+        return mp_const_none;
+    }
+    const displayio_area_t* areas;
+    if (core->full_refresh) {
+        core->area.next = NULL;
+        areas = &core->area;
+    } else {
+        areas = displayio_group_get_refresh_areas(core->current_group, NULL);
+    }
+    if (self->tile_size > 0) {
+        displayio_tiles_refresh(core, areas, self->tile_size, _refresh_area, self);
+    } else {
+        for (const displayio_area_t* area = areas; area != NULL; area = area->next) {
+            _refresh_area(self, area);
+        }
+    }
+    displayio_group_finish_refresh(core->current_group);
+    core->full_refresh = false;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(displayio_memorydisplay_refresh_obj, displayio_memorydisplay_obj_refresh);
+
+//|     def pixel(self, x: int, y: int) -> int:
+//|         """The RGB565 value of the pixel at x, y."""
+//|         ...
+//|
+STATIC mp_obj_t displayio_memorydisplay_obj_pixel(mp_obj_t self_in, mp_obj_t x_in, mp_obj_t y_in) {
+    displayio_memorydisplay_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_int_t x = mp_obj_get_int(x_in);
+    mp_int_t y = mp_obj_get_int(y_in);
+    if (x < 0 || x >= self->core.width || y < 0 || y >= self->core.height) {
+        mp_raise_IndexError(translate("pixel coordinates out of bounds"));
+    }
+    return MP_OBJ_NEW_SMALL_INT(self->framebuffer[y * self->core.width + x]);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(displayio_memorydisplay_pixel_obj, displayio_memorydisplay_obj_pixel);
+
+STATIC mp_int_t displayio_memorydisplay_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo, mp_uint_t flags) {
+    displayio_memorydisplay_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    bufinfo->buf = self->framebuffer;
+    bufinfo->len = self->core.width * self->core.height * sizeof(uint16_t);
+    bufinfo->typecode = 'H';
+    return 0;
+}
+
+STATIC const mp_rom_map_elem_t displayio_memorydisplay_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_show), MP_ROM_PTR(&displayio_memorydisplay_show_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh), MP_ROM_PTR(&displayio_memorydisplay_refresh_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pixel), MP_ROM_PTR(&displayio_memorydisplay_pixel_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(displayio_memorydisplay_locals_dict, displayio_memorydisplay_locals_dict_table);
+
+STATIC const mp_obj_type_t displayio_memorydisplay_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_MemoryDisplay,
+    .make_new = displayio_memorydisplay_make_new,
+    .buffer_p = { .get_buffer = displayio_memorydisplay_get_buffer },
+    .locals_dict = (mp_obj_dict_t*)&displayio_memorydisplay_locals_dict,
+};
+
+STATIC const mp_rom_map_elem_t displayio_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_displayio) },
+    { MP_ROM_QSTR(MP_QSTR_Bitmap), MP_ROM_PTR(&displayio_bitmap_type) },
+    { MP_ROM_QSTR(MP_QSTR_ColorConverter), MP_ROM_PTR(&displayio_colorconverter_type) },
+    { MP_ROM_QSTR(MP_QSTR_Group), MP_ROM_PTR(&displayio_group_type) },
+    { MP_ROM_QSTR(MP_QSTR_OnDiskBitmap), MP_ROM_PTR(&displayio_ondiskbitmap_type) },
+    { MP_ROM_QSTR(MP_QSTR_Palette), MP_ROM_PTR(&displayio_palette_type) },
+    { MP_ROM_QSTR(MP_QSTR_Shape), MP_ROM_PTR(&displayio_shape_type) },
+    { MP_ROM_QSTR(MP_QSTR_TileGrid), MP_ROM_PTR(&displayio_tilegrid_type) },
+    { MP_ROM_QSTR(MP_QSTR_MemoryDisplay), MP_ROM_PTR(&displayio_memorydisplay_type) },
+};
+STATIC MP_DEFINE_CONST_DICT(displayio_module_globals, displayio_module_globals_table);
+
+const mp_obj_module_t mp_module_displayio = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&displayio_module_globals,
+};
+
+#endif // MICROPY_PY_DISPLAYIO
@@ -0,0 +1,115 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2021 MicroPython & CircuitPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Support for testing iot on the unix port, with usocket.socketpair().
+// Console output goes to the iot dupterm terminal, whose buffer is
+// flushed from the VM hook instead of the supervisor's background tasks.
+
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+
+#include "py/objtuple.h"
+#include "py/runtime.h"
+#include "shared-bindings/iot/EventLoop.h"
+#include "shared-bindings/time/__init__.h"
+#include "supervisor/shared/tick.h"
+#include "fdfile.h"
+
+#if MICROPY_PY_SOCKET
+extern const mp_obj_type_t mp_type_socket;
+#endif
+
+#if MICROPY_PY_IOT
+
+uint64_t common_hal_time_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+uint64_t common_hal_time_monotonic_ms(void) {
+    return common_hal_time_monotonic_ns() / 1000000;
+}
+
+// There is no tick to keep running.
+void supervisor_enable_tick(void) {
+}
+
+void supervisor_disable_tick(void) {
+}
+
+// The file descriptor of a file or socket, as moduselect.c gets it, or -1.
+STATIC int stream_fd(mp_obj_t stream) {
+    if (MP_OBJ_IS_TYPE(stream, &mp_type_fileio)
+        #if MICROPY_PY_SOCKET
+        || MP_OBJ_IS_TYPE(stream, &mp_type_socket)
+        #endif
+        ) {
+        mp_obj_fdfile_t *fdfile = MP_OBJ_TO_PTR(stream);
+        return fdfile->fd;
+    }
+    return -1;
+}
+
+// Block in poll() rather than have EventLoop check the streams every millisecond.
+bool iot_event_loop_wait_streams(mp_map_t *readers, mp_map_t *writers, mp_int_t timeout_ms) {
+    mp_map_t *maps[2] = {readers, writers};
+    const short events[2] = {POLLIN, POLLOUT};
+    size_t n_fds = readers->used + writers->used;
+    struct pollfd *fds = m_new(struct pollfd, n_fds);
+    size_t n = 0;
+    for (size_t m = 0; m < 2; m++) {
+        for (size_t i = 0; i < maps[m]->alloc; i++) {
+            if (!MP_MAP_SLOT_IS_FILLED(maps[m], i)) {
+                continue;
+            }
+            mp_obj_tuple_t *waiter = MP_OBJ_TO_PTR(maps[m]->table[i].value);
+            int fd = stream_fd(waiter->items[0]);
+            if (fd < 0) {
+                // not something poll() knows, or closed
+                m_del(struct pollfd, fds, n_fds);
+                return false;
+            }
+            fds[n].fd = fd;
+            fds[n].events = events[m];
+            n++;
+        }
+    }
+    int ret = poll(fds, n, timeout_ms);
+    int err = errno;
+    m_del(struct pollfd, fds, n_fds);
+    if (ret == -1) {
+        if (err != EINTR) {
+            mp_raise_OSError(err);
+        }
+        // raise KeyboardInterrupt for ctrl-C, otherwise EventLoop waits again
+        mp_handle_pending();
+    }
+    return true;
+}
+
+#endif // MICROPY_PY_IOT
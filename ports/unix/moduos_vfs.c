@@ -30,6 +30,7 @@
 #include "extmod/vfs.h"
 #include "extmod/vfs_posix.h"
 #include "extmod/vfs_fat.h"
+#include "extmod/misc.h"
 
 #if MICROPY_VFS
 
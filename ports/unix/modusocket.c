@@ -30,6 +30,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -112,7 +113,6 @@ STATIC mp_uint_t socket_write(mp_obj_t o_in, const void *buf, mp_uint_t size, in
 
 STATIC mp_uint_t socket_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
     mp_obj_socket_t *self = MP_OBJ_TO_PTR(o_in);
-    (void)arg;
     switch (request) {
         case MP_STREAM_CLOSE:
             // There's a POSIX drama regarding return value of close in general,
@@ -125,6 +125,34 @@ STATIC mp_uint_t socket_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, i
             close(self->fd);
             return 0;
 
+        case MP_STREAM_POLL: {
+            // for pollers that go through the stream protocol, like iot.EventLoop
+            struct pollfd pfd = { .fd = self->fd, .events = 0 };
+            if (arg & MP_STREAM_POLL_RD) {
+                pfd.events |= POLLIN;
+            }
+            if (arg & MP_STREAM_POLL_WR) {
+                pfd.events |= POLLOUT;
+            }
+            mp_uint_t ret = 0;
+            if (poll(&pfd, 1, 0) > 0) {
+                if (pfd.revents & POLLIN) {
+                    ret |= MP_STREAM_POLL_RD;
+                }
+                if (pfd.revents & POLLOUT) {
+                    ret |= MP_STREAM_POLL_WR;
+                }
+                if (pfd.revents & (POLLERR | POLLNVAL)) {
+                    // POLLNVAL if the socket has been closed
+                    ret |= MP_STREAM_POLL_ERR;
+                }
+                if (pfd.revents & POLLHUP) {
+                    ret |= MP_STREAM_POLL_HUP;
+                }
+            }
+            return ret;
+        }
+
         default:
             *errcode = MP_EINVAL;
             return MP_STREAM_ERROR;
@@ -391,6 +419,29 @@ const mp_obj_type_t mp_type_socket = {
     .locals_dict = (mp_obj_dict_t*)&usocket_locals_dict,
 };
 
+STATIC mp_obj_t mod_socket_socketpair(size_t n_args, const mp_obj_t *args) {
+    int family = AF_UNIX;
+    int type = SOCK_STREAM;
+    int proto = 0;
+
+    if (n_args > 0) {
+        family = mp_obj_get_int(args[0]);
+        if (n_args > 1) {
+            type = mp_obj_get_int(args[1]);
+            if (n_args > 2) {
+                proto = mp_obj_get_int(args[2]);
+            }
+        }
+    }
+
+    int fds[2];
+    int r = socketpair(family, type, proto, fds);
+    RAISE_ERRNO(r, errno);
+    mp_obj_t pair[2] = {MP_OBJ_FROM_PTR(socket_new(fds[0])), MP_OBJ_FROM_PTR(socket_new(fds[1]))};
+    return mp_obj_new_tuple(2, pair);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_socket_socketpair_obj, 0, 3, mod_socket_socketpair);
+
 #define BINADDR_MAX_LEN sizeof(struct in6_addr)
 STATIC mp_obj_t mod_socket_inet_pton(mp_obj_t family_in, mp_obj_t addr_in) {
     int family = mp_obj_get_int(family_in);
@@ -534,6 +585,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_socket_sockaddr_obj, mod_socket_sockaddr);
 STATIC const mp_rom_map_elem_t mp_module_socket_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_usocket) },
     { MP_ROM_QSTR(MP_QSTR_socket), MP_ROM_PTR(&mp_type_socket) },
+    { MP_ROM_QSTR(MP_QSTR_socketpair), MP_ROM_PTR(&mod_socket_socketpair_obj) },
     { MP_ROM_QSTR(MP_QSTR_getaddrinfo), MP_ROM_PTR(&mod_socket_getaddrinfo_obj) },
     { MP_ROM_QSTR(MP_QSTR_inet_pton), MP_ROM_PTR(&mod_socket_inet_pton_obj) },
     { MP_ROM_QSTR(MP_QSTR_inet_ntop), MP_ROM_PTR(&mod_socket_inet_ntop_obj) },
@@ -70,6 +70,22 @@
 #ifndef MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (1)
 #endif
+#ifndef MICROPY_OPT_SUPERINSTRUCTIONS
+#define MICROPY_OPT_SUPERINSTRUCTIONS (1)
+#endif
+#define MICROPY_OPT_QSTR_HASH_INDEX (1)
+#define MICROPY_OPT_GC_ATB_WORD_SCAN (1)
+#define MICROPY_OPT_TYPE_ATTR_CACHE (1)
+#define MICROPY_OPT_TYPE_ATTR_CACHE_SIZE (64)
+#define MICROPY_OPT_INSTANCE_SHAPES (1)
+#define MICROPY_OPT_MAP_LOOKUP_CACHE (1)
+#define MICROPY_OPT_MPZ_KARATSUBA (1)
+#define MICROPY_OPT_MPZ_MONTGOMERY (1)
+#define MICROPY_GC_INCREMENTAL      (1)
+#define MICROPY_GC_SLAB             (1)
+#define MICROPY_GC_SLAB_MAX_LEN     (256)
+#define MICROPY_GC_GENERATIONAL     (1)
+#define MICROPY_GC_SPLIT_HEAP       (1)
 #define MICROPY_CAN_OVERRIDE_BUILTINS (1)
 #define MICROPY_PY_FUNCTION_ATTRS   (1)
 #define MICROPY_PY_DESCRIPTORS      (1)
@@ -178,6 +194,14 @@ extern const struct _mp_obj_module_t mp_module_termios;
 extern const struct _mp_obj_module_t mp_module_socket;
 extern const struct _mp_obj_module_t mp_module_ffi;
 extern const struct _mp_obj_module_t mp_module_jni;
+extern const struct _mp_obj_module_t mp_module_displayio;
+extern const struct _mp_obj_module_t vectorio_module;
+extern const struct _mp_obj_module_t audiocore_module;
+extern const struct _mp_obj_module_t audiomixer_module;
+extern const struct _mp_obj_module_t mp_module_audiosink;
+extern const struct _mp_obj_module_t pixelbuf_module;
+extern const struct _mp_obj_module_t iot_module;
+extern const struct _mp_obj_module_t msgpack_module;
 
 #if MICROPY_PY_UOS_VFS
 #define MICROPY_PY_UOS_DEF { MP_ROM_QSTR(MP_QSTR_uos), MP_ROM_PTR(&mp_module_uos_vfs) },
@@ -215,6 +239,46 @@ extern const struct _mp_obj_module_t mp_module_jni;
 #define MICROPY_PY_USELECT_DEF
 #endif
 
+#if MICROPY_PY_DISPLAYIO
+#define MICROPY_PY_DISPLAYIO_DEF \
+    { MP_ROM_QSTR(MP_QSTR_displayio), MP_ROM_PTR(&mp_module_displayio) }, \
+    { MP_ROM_QSTR(MP_QSTR_vectorio), MP_ROM_PTR(&vectorio_module) },
+#else
+#define MICROPY_PY_DISPLAYIO_DEF
+#endif
+
+#if MICROPY_PY_AUDIO
+#define MICROPY_PY_AUDIO_DEF \
+    { MP_ROM_QSTR(MP_QSTR_audiocore), MP_ROM_PTR(&audiocore_module) }, \
+    { MP_ROM_QSTR(MP_QSTR_audiomixer), MP_ROM_PTR(&audiomixer_module) }, \
+    { MP_ROM_QSTR(MP_QSTR_audiosink), MP_ROM_PTR(&mp_module_audiosink) },
+#else
+#define MICROPY_PY_AUDIO_DEF
+#endif
+
+#if MICROPY_PY_PIXELBUF
+#define MICROPY_PY_PIXELBUF_DEF { MP_ROM_QSTR(MP_QSTR__pixelbuf), MP_ROM_PTR(&pixelbuf_module) },
+#else
+#define MICROPY_PY_PIXELBUF_DEF
+#endif
+
+#if MICROPY_PY_IOT
+#define MICROPY_PY_IOT_DEF { MP_ROM_QSTR(MP_QSTR_iot), MP_ROM_PTR(&iot_module) },
+#define MICROPY_PY_IOT_ROOT_POINTERS struct _iot_dupterm_buffer_t *iot_dupterm_buffer;
+void iot_dupterm_background(void);
+#define MICROPY_VM_HOOK_LOOP iot_dupterm_background();
+#define MICROPY_VM_HOOK_RETURN iot_dupterm_background();
+#else
+#define MICROPY_PY_IOT_DEF
+#define MICROPY_PY_IOT_ROOT_POINTERS
+#endif
+
+#if MICROPY_PY_MSGPACK
+#define MICROPY_PY_MSGPACK_DEF { MP_ROM_QSTR(MP_QSTR_msgpack), MP_ROM_PTR(&msgpack_module) },
+#else
+#define MICROPY_PY_MSGPACK_DEF
+#endif
+
 #define MICROPY_PORT_BUILTIN_MODULES \
     MICROPY_PY_FFI_DEF \
     MICROPY_PY_JNI_DEF \
@@ -224,6 +288,11 @@ extern const struct _mp_obj_module_t mp_module_jni;
     MICROPY_PY_UOS_DEF \
     MICROPY_PY_USELECT_DEF \
     MICROPY_PY_TERMIOS_DEF \
+    MICROPY_PY_DISPLAYIO_DEF \
+    MICROPY_PY_AUDIO_DEF \
+    MICROPY_PY_PIXELBUF_DEF \
+    MICROPY_PY_IOT_DEF \
+    MICROPY_PY_MSGPACK_DEF \
 
 // type definitions for the specific machine
 
@@ -293,6 +362,7 @@ void mp_unix_mark_exec(void);
 #define MICROPY_PORT_ROOT_POINTERS \
     const char *readline_hist[50]; \
     void *mmap_region_head; \
+    MICROPY_PY_IOT_ROOT_POINTERS \
 
 // We need to provide a declaration/definition of alloca()
 // unless support for it is disabled.
@@ -37,6 +37,21 @@ MICROPY_SSL_MBEDTLS = 0
 # jni module requires JVM/JNI
 MICROPY_PY_JNI = 0
 
+# subset of displayio drawing into RAM, see the displayio target
+MICROPY_PY_DISPLAYIO = 0
+
+# audiocore, audiomixer and a sink writing to files, see the audio target
+MICROPY_PY_AUDIO = 0
+
+# _pixelbuf, see the pixelbuf target
+MICROPY_PY_PIXELBUF = 0
+
+# iot, see the iot and coverage targets
+MICROPY_PY_IOT = 0
+
+# msgpack, see the coverage target
+MICROPY_PY_MSGPACK = 0
+
 # Avoid using system libraries, use copies bundled with MicroPython
 # as submodules (currently affects only libffi).
 MICROPY_STANDALONE = 0
@@ -33,6 +33,12 @@
 void mp_hal_set_interrupt_char(char c);
 bool mp_hal_is_interrupted(void);
 
+#if MICROPY_PY_OS_DUPTERM
+// Used by extmod/uos_dupterm.c for ctrl-C read from a dupterm stream
+extern int mp_interrupt_char;
+void mp_keyboard_interrupt(void);
+#endif
+
 void mp_hal_stdio_mode_raw(void);
 void mp_hal_stdio_mode_orig(void);
 
@@ -33,6 +33,10 @@
 #include "py/runtime.h"
 #include "extmod/misc.h"
 
+#if MICROPY_PY_IOT
+#include "shared-bindings/iot/__init__.h"
+#endif
+
 #ifndef _WIN32
 #include <signal.h>
 
@@ -85,6 +89,14 @@ bool mp_hal_is_interrupted(void) {
     return false;
 }
 
+#if MICROPY_PY_OS_DUPTERM
+int mp_interrupt_char = CHAR_CTRL_C;
+
+void mp_keyboard_interrupt(void) {
+    MP_STATE_VM(mp_pending_exception) = MP_OBJ_FROM_PTR(&MP_STATE_VM(mp_kbd_exception));
+}
+#endif
+
 #if MICROPY_USE_READLINE == 1
 
 #include <termios.h>
@@ -149,17 +161,17 @@ int mp_hal_stdin_rx_chr(void) {
 #if MICROPY_PY_OS_DUPTERM
     // TODO only support dupterm one slot at the moment
     if (MP_STATE_VM(dupterm_objs[0]) != MP_OBJ_NULL) {
-        int c;
+        int dupterm_c;
         do {
-             c = call_dupterm_read(0);
-        } while (c == -2);
-        if (c == -1) {
+             dupterm_c = call_dupterm_read(0);
+        } while (dupterm_c == -2);
+        if (dupterm_c == -1) {
             goto main_term;
         }
-        if (c == '\n') {
-            c = '\r';
+        if (dupterm_c == '\n') {
+            dupterm_c = '\r';
         }
-        return c;
+        return dupterm_c;
     } else {
         main_term:;
 #endif
@@ -177,7 +189,12 @@ int mp_hal_stdin_rx_chr(void) {
 
 void mp_hal_stdout_tx_strn(const char *str, size_t len) {
     int ret = write(1, str, len);
+    #if MICROPY_PY_IOT
+    // as supervisor/shared/serial.c does
+    common_hal_dupterm_write_substring((uint8_t*)str, len);
+    #else
     mp_uos_dupterm_tx_strn(str, len);
+    #endif
     (void)ret; // to suppress compiler warning
 }
 
@@ -307,6 +307,11 @@ continue2:;
 //     MP_BC_LOAD_GLOBAL
 //     MP_BC_LOAD_ATTR
 //     MP_BC_STORE_ATTR
+// The superinstructions have extra bytes as follows:
+//     MP_BC_LOAD_FAST_FAST: 1
+//     MP_BC_BINARY_OP_FAST_FAST: 2
+//     MP_BC_LOAD_FAST_ATTR: 1, plus 1 as for MP_BC_LOAD_ATTR
+//     MP_BC_BINARY_OP_POP_JUMP_IF_TRUE/FALSE: 1
 #define OC4(a, b, c, d) (a | (b << 2) | (c << 4) | (d << 6))
 #define U (0) // undefined opcode
 #define B (MP_OPCODE_BYTE) // single byte
@@ -332,8 +337,8 @@ STATIC const byte opcode_format_table[64] = {
     OC4(U, O, B, O), // 0x3c-0x3f
     OC4(O, B, B, O), // 0x40-0x43
     OC4(B, B, O, B), // 0x44-0x47
-    OC4(U, U, U, U), // 0x48-0x4b
-    OC4(U, U, U, U), // 0x4c-0x4f
+    OC4(B, B, Q, O), // 0x48-0x4b
+    OC4(O, U, U, U), // 0x4c-0x4f
     OC4(V, V, U, V), // 0x50-0x53
     OC4(B, U, V, V), // 0x54-0x57
     OC4(V, V, V, B), // 0x58-0x5b
@@ -397,6 +402,9 @@ uint mp_opcode_format(const byte *ip, size_t *opcode_size) {
     const byte *ip_start = ip;
     if (f == MP_OPCODE_QSTR) {
         ip += 3;
+        if (*ip_start == MP_BC_LOAD_FAST_ATTR) {
+            ip += 1 + MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC;
+        }
     } else {
         int extra_byte = (
             *ip == MP_BC_RAISE_VARARGS
@@ -408,7 +416,13 @@ uint mp_opcode_format(const byte *ip, size_t *opcode_size) {
             || *ip == MP_BC_LOAD_ATTR
             || *ip == MP_BC_STORE_ATTR
             #endif
+            || *ip == MP_BC_LOAD_FAST_FAST
+            || *ip == MP_BC_BINARY_OP_POP_JUMP_IF_TRUE
+            || *ip == MP_BC_BINARY_OP_POP_JUMP_IF_FALSE
         );
+        if (*ip == MP_BC_BINARY_OP_FAST_FAST) {
+            extra_byte = 2;
+        }
         ip += 1;
         if (f == MP_OPCODE_VAR_UINT) {
             while ((*ip++ & 0x80) != 0) {
@@ -82,6 +82,14 @@
 #define MP_BC_UNWIND_JUMP        (0x46) // rel byte code offset, 16-bit signed, in excess; then a byte
 #define MP_BC_GET_ITER_STACK     (0x47)
 
+// Superinstructions, emitted in place of common sequences of the above when
+// MICROPY_OPT_SUPERINSTRUCTIONS is enabled.  Locals are numbered 0-15.
+#define MP_BC_LOAD_FAST_FAST     (0x48) // byte: local0 << 4 | local1
+#define MP_BC_BINARY_OP_FAST_FAST    (0x49) // byte: local0 << 4 | local1; then byte: op
+#define MP_BC_LOAD_FAST_ATTR     (0x4a) // qstr; then byte: local
+#define MP_BC_BINARY_OP_POP_JUMP_IF_TRUE (0x4b) // rel byte code offset, 16-bit signed, in excess; then byte: op
+#define MP_BC_BINARY_OP_POP_JUMP_IF_FALSE (0x4c) // rel byte code offset, 16-bit signed, in excess; then byte: op
+
 #define MP_BC_BUILD_TUPLE        (0x50) // uint
 #define MP_BC_BUILD_LIST         (0x51) // uint
 #define MP_BC_BUILD_MAP          (0x53) // uint
@@ -444,7 +444,9 @@ $(filter $(SRC_PATTERNS), \
 	microcontroller/RunMode.c \
 	msgpack/__init__.c \
 	msgpack/ExtType.c \
+	msgpack/Unpacker.c \
 	iot/Chronometer.c \
+	iot/EventLoop.c \
 	iot/Ticker.c \
 	iot/TimeQueue.c \
 	iot/FinaliserProxy.c \
@@ -593,7 +595,9 @@ endif
 # All possible sources are listed here, and are filtered by SRC_PATTERNS.
 SRC_SHARED_MODULE_INTERNAL = \
 $(filter $(SRC_PATTERNS), \
+	displayio/area.c \
 	displayio/display_core.c \
+	displayio/tiles.c \
 )
 
 SRC_COMMON_HAL_INTERNAL = \
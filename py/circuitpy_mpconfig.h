@@ -68,6 +68,7 @@
 #define MICROPY_FLOAT_HIGH_QUALITY_HASH  (0)
 #define MICROPY_FLOAT_IMPL               (MICROPY_FLOAT_IMPL_FLOAT)
 #define MICROPY_GC_ALLOC_THRESHOLD       (0)
+#define MICROPY_GC_SLAB                  (CIRCUITPY_FULL_BUILD)
 #define MICROPY_HELPER_LEXER_UNIX        (0)
 #define MICROPY_HELPER_REPL              (1)
 #define MICROPY_KBD_EXCEPTION            (1)
@@ -75,6 +76,14 @@
 #define MICROPY_MODULE_BUILTIN_INIT      (1)
 #define MICROPY_NONSTANDARD_TYPECODES    (0)
 #define MICROPY_OPT_COMPUTED_GOTO        (1)
+// Lets every build run .mpy files made with mpy-cross -msuperinstructions.
+#define MICROPY_OPT_SUPERINSTRUCTIONS    (1)
+#define MICROPY_OPT_GC_ATB_WORD_SCAN     (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_TYPE_ATTR_CACHE      (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_INSTANCE_SHAPES      (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_MAP_LOOKUP_CACHE     (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_MPZ_KARATSUBA        (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_MPZ_MONTGOMERY       (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PERSISTENT_CODE_LOAD     (1)
 
 #define MICROPY_PY_ARRAY                 (1)
@@ -264,6 +273,15 @@ extern const struct _mp_obj_module_t audiobusio_module;
 #if CIRCUITPY_AUDIOCORE
 #define AUDIOCORE_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_audiocore), (mp_obj_t)&audiocore_module },
 extern const struct _mp_obj_module_t audiocore_module;
+// Number of buffers each WaveFile splits its memory into. The audio output holds two
+// of them and the rest are read ahead of playback in the background.
+#ifndef CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS
+#if CIRCUITPY_FULL_BUILD
+#define CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS (4)
+#else
+#define CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS (2)
+#endif
+#endif
 #else
 #define AUDIOCORE_MODULE
 #endif
@@ -388,6 +406,18 @@ extern const struct _mp_obj_module_t terminalio_module;
 #ifndef CIRCUITPY_DISPLAY_LIMIT
 #define CIRCUITPY_DISPLAY_LIMIT (1)
 #endif
+// Refresh displays in square tiles of this many pixels, compositing only the
+// layers that overlap each run of dirty tiles. 0 refreshes each dirty area
+// against the whole group. Off by default; a board opts in by setting it in
+// its mpconfigboard.h, eg to 16.
+#ifndef CIRCUITPY_DISPLAYIO_TILE_SIZE
+#define CIRCUITPY_DISPLAYIO_TILE_SIZE (0)
+#endif
+// Number of decoded rows each OnDiskBitmap keeps in RAM. Each row is read from the
+// file with a single read. 0 reads every pixel from the file separately.
+#ifndef CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHED_ROWS
+#define CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHED_ROWS (2)
+#endif
 #else
 #define DISPLAYIO_MODULE
 #define CIRCUITPY_DISPLAY_LIMIT (0)
@@ -805,8 +835,10 @@ extern const struct _mp_obj_module_t msgpack_module;
 #define MICROPY_PY_OS_DUPTERM (1)
 extern const struct _mp_obj_module_t iot_module;
 #define IOT_MODULE { MP_ROM_QSTR(MP_QSTR_iot), MP_ROM_PTR(&iot_module) },
+#define IOT_ROOT_POINTERS struct _iot_dupterm_buffer_t *iot_dupterm_buffer;
 #else
 #define IOT_MODULE
+#define IOT_ROOT_POINTERS
 #endif
 
 #if CIRCUITPY_GPIO
@@ -941,6 +973,7 @@ struct _supervisor_allocation_node;
     mp_obj_t pew_singleton; \
     BOARD_UART_ROOT_POINTER \
     FLASH_ROOT_POINTERS \
+    IOT_ROOT_POINTERS \
     MEMORYMONITOR_ROOT_POINTERS \
     NETWORK_ROOT_POINTERS \
     struct _supervisor_allocation_node* first_embedded_allocation; \
@@ -963,6 +996,11 @@ void supervisor_run_background_tasks_if_tick(void);
 #define CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS 1000
 #endif
 
+// How long output to a buffered iot.dupterm terminal may wait to be coalesced.
+#ifndef CIRCUITPY_IOT_DUPTERM_FLUSH_INTERVAL_MS
+#define CIRCUITPY_IOT_DUPTERM_FLUSH_INTERVAL_MS 10
+#endif
+
 #ifndef CIRCUITPY_PYSTACK_SIZE
 #define CIRCUITPY_PYSTACK_SIZE 1536
 #endif
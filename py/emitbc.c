@@ -64,6 +64,13 @@ struct _emit_t {
     size_t bytecode_size;
     byte *code_base; // stores both byte code and code info
 
+    // The last instruction emitted, if it can be fused with the next one into
+    // a superinstruction: its kind (0 if none), argument and bytecode extent.
+    byte fuse_kind;
+    byte fuse_arg;
+    size_t fuse_start;
+    size_t fuse_end;
+
     #if MICROPY_PERSISTENT_CODE
     uint16_t ct_cur_obj;
     uint16_t ct_num_obj;
@@ -306,6 +313,46 @@ STATIC void emit_write_bytecode_byte_signed_label(emit_t *emit, byte b1, mp_uint
     c[2] = bytecode_offset >> 8;
 }
 
+// signed label followed by a byte, relative to ip following that byte
+STATIC void emit_write_bytecode_byte_signed_label_byte(emit_t *emit, byte b1, mp_uint_t label, byte b2) {
+    int bytecode_offset;
+    if (emit->pass < MP_PASS_EMIT) {
+        bytecode_offset = 0;
+    } else {
+        bytecode_offset = emit->label_offsets[label] - emit->bytecode_offset - 4 + 0x8000;
+    }
+    byte *c = emit_get_cur_to_write_bytecode(emit, 4);
+    c[0] = b1;
+    c[1] = bytecode_offset;
+    c[2] = bytecode_offset >> 8;
+    c[3] = b2;
+}
+
+// Record that the instruction written from bytecode offset start up to the
+// current offset may be fused with the next one.  kind is the opcode it was
+// written with (without any MULTI argument) and arg its argument.
+STATIC void emit_bc_set_fusable(emit_t *emit, size_t start, byte kind, byte arg) {
+    emit->fuse_kind = kind;
+    emit->fuse_arg = arg;
+    emit->fuse_start = start;
+    emit->fuse_end = emit->bytecode_offset;
+}
+
+// If the last instruction is of the given kind and nothing (no other
+// instruction, label or line-number boundary) came after it, remove it so a
+// superinstruction can be written in its place.  The caller takes its
+// argument from emit->fuse_arg.  This is deterministic so every pass makes
+// the same choices and label offsets agree between passes.
+STATIC bool emit_bc_fuse_with_last(emit_t *emit, byte kind) {
+    if (MICROPY_OPT_SUPERINSTRUCTIONS_DYNAMIC
+        && emit->fuse_kind == kind && emit->fuse_end == emit->bytecode_offset) {
+        emit->fuse_kind = 0;
+        emit->bytecode_offset = emit->fuse_start;
+        return true;
+    }
+    return false;
+}
+
 void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     emit->pass = pass;
     emit->stack_size = 0;
@@ -321,6 +368,7 @@ void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     #endif
     emit->bytecode_offset = 0;
     emit->code_info_offset = 0;
+    emit->fuse_kind = 0;
 
     // Write local state size and exception stack size.
     {
@@ -481,6 +529,7 @@ void mp_emit_bc_set_source_line(emit_t *emit, mp_uint_t source_line) {
         emit_write_code_info_bytes_lines(emit, bytes_to_skip, lines_to_skip);
         emit->last_source_line_offset = emit->bytecode_offset;
         emit->last_source_line = source_line;
+        emit->fuse_kind = 0;
     }
 #else
     (void)emit;
@@ -493,6 +542,7 @@ void mp_emit_bc_label_assign(emit_t *emit, mp_uint_t l) {
     if (emit->pass == MP_PASS_SCOPE) {
         return;
     }
+    emit->fuse_kind = 0;
     assert(l < emit->max_num_labels);
     if (emit->pass < MP_PASS_EMIT) {
         // assign label offset
@@ -562,7 +612,16 @@ void mp_emit_bc_load_local(emit_t *emit, qstr qst, mp_uint_t local_num, int kind
     (void)qst;
     emit_bc_pre(emit, 1);
     if (kind == MP_EMIT_IDOP_LOCAL_FAST && local_num <= 15) {
-        emit_write_bytecode_byte(emit, MP_BC_LOAD_FAST_MULTI + local_num);
+        size_t start = emit->bytecode_offset;
+        if (emit_bc_fuse_with_last(emit, MP_BC_LOAD_FAST_MULTI)) {
+            byte locals = emit->fuse_arg << 4 | local_num;
+            start = emit->bytecode_offset;
+            emit_write_bytecode_byte_byte(emit, MP_BC_LOAD_FAST_FAST, locals);
+            emit_bc_set_fusable(emit, start, MP_BC_LOAD_FAST_FAST, locals);
+        } else {
+            emit_write_bytecode_byte(emit, MP_BC_LOAD_FAST_MULTI + local_num);
+            emit_bc_set_fusable(emit, start, MP_BC_LOAD_FAST_MULTI, local_num);
+        }
     } else {
         emit_write_bytecode_byte_uint(emit, MP_BC_LOAD_FAST_N + kind, local_num);
     }
@@ -606,7 +665,18 @@ void mp_emit_bc_subscr(emit_t *emit, int kind) {
 void mp_emit_bc_attr(emit_t *emit, qstr qst, int kind) {
     if (kind == MP_EMIT_ATTR_LOAD) {
         emit_bc_pre(emit, 0);
-        emit_write_bytecode_byte_qstr(emit, MP_BC_LOAD_ATTR, qst);
+        if (emit_bc_fuse_with_last(emit, MP_BC_LOAD_FAST_FAST)) {
+            // Split the pair so the second local is fused with the attribute.
+            byte locals = emit->fuse_arg;
+            emit_write_bytecode_byte(emit, MP_BC_LOAD_FAST_MULTI + (locals >> 4));
+            emit_write_bytecode_byte_qstr(emit, MP_BC_LOAD_FAST_ATTR, qst);
+            emit_write_bytecode_byte(emit, locals & 0xf);
+        } else if (emit_bc_fuse_with_last(emit, MP_BC_LOAD_FAST_MULTI)) {
+            emit_write_bytecode_byte_qstr(emit, MP_BC_LOAD_FAST_ATTR, qst);
+            emit_write_bytecode_byte(emit, emit->fuse_arg);
+        } else {
+            emit_write_bytecode_byte_qstr(emit, MP_BC_LOAD_ATTR, qst);
+        }
     } else {
         if (kind == MP_EMIT_ATTR_DELETE) {
             mp_emit_bc_load_null(emit);
@@ -685,7 +755,11 @@ void mp_emit_bc_jump(emit_t *emit, mp_uint_t label) {
 
 void mp_emit_bc_pop_jump_if(emit_t *emit, bool cond, mp_uint_t label) {
     emit_bc_pre(emit, -1);
-    if (cond) {
+    if (emit_bc_fuse_with_last(emit, MP_BC_BINARY_OP_MULTI)) {
+        emit_write_bytecode_byte_signed_label_byte(emit,
+            cond ? MP_BC_BINARY_OP_POP_JUMP_IF_TRUE : MP_BC_BINARY_OP_POP_JUMP_IF_FALSE,
+            label, emit->fuse_arg);
+    } else if (cond) {
         emit_write_bytecode_byte_signed_label(emit, MP_BC_POP_JUMP_IF_TRUE, label);
     } else {
         emit_write_bytecode_byte_signed_label(emit, MP_BC_POP_JUMP_IF_FALSE, label);
@@ -786,7 +860,19 @@ void mp_emit_bc_binary_op(emit_t *emit, mp_binary_op_t op) {
         op = MP_BINARY_OP_IS;
     }
     emit_bc_pre(emit, -1);
-    emit_write_bytecode_byte(emit, MP_BC_BINARY_OP_MULTI + op);
+    if (emit_bc_fuse_with_last(emit, MP_BC_LOAD_FAST_FAST)) {
+        byte *c = emit_get_cur_to_write_bytecode(emit, 3);
+        c[0] = MP_BC_BINARY_OP_FAST_FAST;
+        c[1] = emit->fuse_arg;
+        c[2] = op;
+    } else {
+        size_t start = emit->bytecode_offset;
+        emit_write_bytecode_byte(emit, MP_BC_BINARY_OP_MULTI + op);
+        if (op <= MP_BINARY_OP_IS) {
+            // a comparison, which may be fused with a following POP_JUMP_IF
+            emit_bc_set_fusable(emit, start, MP_BC_BINARY_OP_MULTI, op);
+        }
+    }
     if (invert) {
         emit_bc_pre(emit, 0);
         emit_write_bytecode_byte(emit, MP_BC_UNARY_OP_MULTI + MP_UNARY_OP_NOT);
@@ -30,6 +30,7 @@
 
 #include "py/gc.h"
 #include "py/runtime.h"
+#include "py/mphal.h"
 
 #include "supervisor/shared/safe_mode.h"
 
@@ -71,26 +72,98 @@
 #define BLOCKS_PER_ATB (4)
 
 #define BLOCK_SHIFT(block) (2 * ((block) & (BLOCKS_PER_ATB - 1)))
-#define ATB_GET_KIND(block) ((MP_STATE_MEM(gc_alloc_table_start)[(block) / BLOCKS_PER_ATB] >> BLOCK_SHIFT(block)) & 3)
-#define ATB_ANY_TO_FREE(block) do { MP_STATE_MEM(gc_alloc_table_start)[(block) / BLOCKS_PER_ATB] &= (~(AT_MARK << BLOCK_SHIFT(block))); } while (0)
-#define ATB_FREE_TO_HEAD(block) do { MP_STATE_MEM(gc_alloc_table_start)[(block) / BLOCKS_PER_ATB] |= (AT_HEAD << BLOCK_SHIFT(block)); } while (0)
-#define ATB_FREE_TO_TAIL(block) do { MP_STATE_MEM(gc_alloc_table_start)[(block) / BLOCKS_PER_ATB] |= (AT_TAIL << BLOCK_SHIFT(block)); } while (0)
-#define ATB_HEAD_TO_MARK(block) do { MP_STATE_MEM(gc_alloc_table_start)[(block) / BLOCKS_PER_ATB] |= (AT_MARK << BLOCK_SHIFT(block)); } while (0)
-#define ATB_MARK_TO_HEAD(block) do { MP_STATE_MEM(gc_alloc_table_start)[(block) / BLOCKS_PER_ATB] &= (~(AT_TAIL << BLOCK_SHIFT(block))); } while (0)
-
-#define BLOCK_FROM_PTR(ptr) (((byte*)(ptr) - MP_STATE_MEM(gc_pool_start)) / BYTES_PER_BLOCK)
-#define PTR_FROM_BLOCK(block) (((block) * BYTES_PER_BLOCK + (uintptr_t)MP_STATE_MEM(gc_pool_start)))
+#define ATB_GET_KIND(area, block) (((area)->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] >> BLOCK_SHIFT(block)) & 3)
+#define ATB_ANY_TO_FREE(area, block) do { (area)->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] &= (~(AT_MARK << BLOCK_SHIFT(block))); } while (0)
+#define ATB_FREE_TO_HEAD(area, block) do { (area)->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] |= (AT_HEAD << BLOCK_SHIFT(block)); } while (0)
+#define ATB_FREE_TO_TAIL(area, block) do { (area)->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] |= (AT_TAIL << BLOCK_SHIFT(block)); } while (0)
+#define ATB_HEAD_TO_MARK(area, block) do { (area)->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] |= (AT_MARK << BLOCK_SHIFT(block)); } while (0)
+#define ATB_MARK_TO_HEAD(area, block) do { (area)->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] &= (~(AT_TAIL << BLOCK_SHIFT(block))); } while (0)
+
+#if MICROPY_GC_INCREMENTAL
+// Outside of a collection, blocks not yet reached by a pending incremental
+// sweep keep their mark bit, so a marked block is also the head of a chain.
+#define ATB_KIND_IS_HEAD(kind) ((kind) == AT_HEAD || (kind) == AT_MARK)
+#else
+#define ATB_KIND_IS_HEAD(kind) ((kind) == AT_HEAD)
+#endif
+
+#define BLOCK_FROM_PTR(area, ptr) (((byte*)(ptr) - (area)->gc_pool_start) / BYTES_PER_BLOCK)
+#define PTR_FROM_BLOCK(area, block) (((block) * BYTES_PER_BLOCK + (uintptr_t)(area)->gc_pool_start))
 #define ATB_FROM_BLOCK(bl) ((bl) / BLOCKS_PER_ATB)
 
+// The number of blocks in an area.
+#define AREA_BLOCKS(area) ((area)->gc_alloc_table_byte_len * BLOCKS_PER_ATB)
+
+#if MICROPY_GC_SPLIT_HEAP
+#define NEXT_AREA(area) ((area)->next)
+#else
+#define NEXT_AREA(area) (NULL)
+#endif
+
 #if MICROPY_ENABLE_FINALISER
 // FTB = finaliser table byte
 // if set, then the corresponding block may have a finaliser
 
 #define BLOCKS_PER_FTB (8)
 
-#define FTB_GET(block) ((MP_STATE_MEM(gc_finaliser_table_start)[(block) / BLOCKS_PER_FTB] >> ((block) & 7)) & 1)
-#define FTB_SET(block) do { MP_STATE_MEM(gc_finaliser_table_start)[(block) / BLOCKS_PER_FTB] |= (1 << ((block) & 7)); } while (0)
-#define FTB_CLEAR(block) do { MP_STATE_MEM(gc_finaliser_table_start)[(block) / BLOCKS_PER_FTB] &= (~(1 << ((block) & 7))); } while (0)
+#define FTB_GET(area, block) (((area)->gc_finaliser_table_start[(block) / BLOCKS_PER_FTB] >> ((block) & 7)) & 1)
+#define FTB_SET(area, block) do { (area)->gc_finaliser_table_start[(block) / BLOCKS_PER_FTB] |= (1 << ((block) & 7)); } while (0)
+#define FTB_CLEAR(area, block) do { (area)->gc_finaliser_table_start[(block) / BLOCKS_PER_FTB] &= (~(1 << ((block) & 7))); } while (0)
+#endif
+
+#if MICROPY_GC_GENERATIONAL
+// AGE = age table, packed like the ATB
+// the number of collections a head block has survived, up to AGE_OLD; old
+// heads stay marked in the ATB, as heads ahead of an incremental sweep do
+
+#if MICROPY_GC_GEN_PROMOTE_AGE < 1 || MICROPY_GC_GEN_PROMOTE_AGE > 3
+#error MICROPY_GC_GEN_PROMOTE_AGE must be 1, 2 or 3
+#endif
+#if !MICROPY_GC_INCREMENTAL
+#error MICROPY_GC_GENERATIONAL requires MICROPY_GC_INCREMENTAL
+#endif
+#define AGE_OLD (MICROPY_GC_GEN_PROMOTE_AGE)
+
+#define AGE_GET(area, block) (((area)->gc_age_table_start[(block) / BLOCKS_PER_ATB] >> BLOCK_SHIFT(block)) & 3)
+#define AGE_SET(area, block, age) do { byte *a = &(area)->gc_age_table_start[(block) / BLOCKS_PER_ATB]; *a = (*a & ~(3 << BLOCK_SHIFT(block))) | ((age) << BLOCK_SHIFT(block)); } while (0)
+#define AGE_TABLE_BITS (BITS_PER_BYTE)
+
+// Mark an unmarked head found by the mark phase, which it has survived.  Heads
+// that gc_alloc marks ahead of an incremental sweep haven't survived anything
+// yet, so only the mark phase ages heads, not the sweep.
+#define ATB_HEAD_TO_SURVIVOR(area, block) do { ATB_HEAD_TO_MARK(area, block); if (AGE_GET(area, block) < AGE_OLD) { AGE_SET(area, block, AGE_GET(area, block) + 1); } } while (0)
+
+// Widen the range of blocks known to hold the heads of all young objects.
+STATIC void gc_note_young(mp_state_mem_area_t *area, size_t block) {
+    if (block < area->gc_young_lo) {
+        area->gc_young_lo = block;
+    }
+    if (block > area->gc_young_hi) {
+        area->gc_young_hi = block;
+    }
+}
+#else
+#define AGE_TABLE_BITS (0)
+#define ATB_HEAD_TO_SURVIVOR(area, block) ATB_HEAD_TO_MARK(area, block)
+#endif
+
+#if MICROPY_GC_SPLIT_HEAP
+mp_state_mem_area_t *gc_get_ptr_area(const void *ptr) {
+    if (((uintptr_t)(ptr) & (BYTES_PER_BLOCK - 1)) != 0) {
+        // must be aligned on a block
+        return NULL;
+    }
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        if (ptr >= (void*)area->gc_pool_start && ptr < (void*)area->gc_pool_end) {
+            return area;
+        }
+    }
+    return NULL;
+}
+#else
+static inline mp_state_mem_area_t *gc_get_ptr_area(const void *ptr) {
+    return VERIFY_PTR(ptr) ? &MP_STATE_MEM(area) : NULL;
+}
 #endif
 
 #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
@@ -112,8 +185,100 @@ void __attribute__ ((noinline)) gc_log_change(uint32_t start_block, uint32_t len
 #pragma GCC pop_options
 #endif
 
+#if MICROPY_GC_SLAB
+// Objects on the slab free lists stay heads (and tails) in the ATB, so that
+// only gc_alloc hands them out again, from the list for their exact size.  The
+// first word of each holds the next block in its list plus one, which can't be
+// mistaken for a heap pointer by the mark phase.  Every sweep finds the listed
+// objects unmarked and so rebuilds the lists from scratch.
+
+STATIC void gc_slab_reset(mp_state_mem_area_t *area) {
+    for (size_t i = 0; i < MICROPY_GC_SLAB_CLASSES; i++) {
+        area->gc_slab_head[i] = 0;
+        area->gc_slab_len[i] = 0;
+    }
+}
+
+// Put the dead object at block on the free list for its size if there is room,
+// returning its length in blocks, or 0 if it was left alone.
+STATIC size_t gc_slab_take(mp_state_mem_area_t *area, size_t block) {
+    #if MICROPY_ENABLE_FINALISER
+    if (FTB_GET(area, block)) {
+        return 0;
+    }
+    #endif
+    if (block >= BLOCK_FROM_PTR(area, area->gc_lowest_long_lived_ptr)) {
+        // the long lived end of the heap is filled from gc_last_free_atb_index
+        return 0;
+    }
+    size_t end_block = AREA_BLOCKS(area);
+    size_t n_blocks = 1;
+    while (block + n_blocks < end_block && ATB_GET_KIND(area, block + n_blocks) == AT_TAIL) {
+        if (++n_blocks > MICROPY_GC_SLAB_CLASSES) {
+            return 0;
+        }
+    }
+    size_t c = n_blocks - 1;
+    if (area->gc_slab_len[c] >= MICROPY_GC_SLAB_MAX_LEN) {
+        return 0;
+    }
+    #if MICROPY_GC_GENERATIONAL
+    // an old object freed by gc_free keeps its mark, which would keep it alive
+    ATB_MARK_TO_HEAD(area, block);
+    AGE_SET(area, block, 0);
+    #endif
+    *(size_t*)PTR_FROM_BLOCK(area, block) = area->gc_slab_head[c];
+    area->gc_slab_head[c] = block + 1;
+    area->gc_slab_len[c] += 1;
+    return n_blocks;
+}
+
+// Take an object of n_blocks off its free list, returning its first block,
+// or (size_t)-1 if the list is empty.
+STATIC size_t gc_slab_pop(mp_state_mem_area_t *area, size_t n_blocks) {
+    size_t c = n_blocks - 1;
+    size_t head = area->gc_slab_head[c];
+    if (head == 0) {
+        return (size_t)-1;
+    }
+    area->gc_slab_head[c] = *(size_t*)PTR_FROM_BLOCK(area, head - 1);
+    area->gc_slab_len[c] -= 1;
+    return head - 1;
+}
+
+// Free all the objects on the free lists of an area, so that they can be
+// merged into bigger runs.  Returns false if the lists were all empty.
+STATIC bool gc_slab_flush(mp_state_mem_area_t *area) {
+    size_t lowest_atb = (size_t)-1;
+    for (size_t n_blocks = 1; n_blocks <= MICROPY_GC_SLAB_CLASSES; n_blocks++) {
+        size_t block;
+        while ((block = gc_slab_pop(area, n_blocks)) != (size_t)-1) {
+            for (size_t bl = block; bl < block + n_blocks; bl++) {
+                ATB_ANY_TO_FREE(area, bl);
+            }
+            size_t atb = block / BLOCKS_PER_ATB;
+            if (atb < lowest_atb) {
+                lowest_atb = atb;
+            }
+            if (atb > area->gc_last_free_atb_index) {
+                area->gc_last_free_atb_index = atb;
+            }
+        }
+    }
+    if (lowest_atb == (size_t)-1) {
+        return false;
+    }
+    for (size_t i = 0; i < MICROPY_ATB_INDICES; i++) {
+        if (lowest_atb < area->gc_first_free_atb_index[i]) {
+            area->gc_first_free_atb_index[i] = lowest_atb;
+        }
+    }
+    return true;
+}
+#endif
+
 // TODO waste less memory; currently requires that all entries in alloc_table have a corresponding block in pool
-void gc_init(void *start, void *end) {
+STATIC void gc_setup_area(mp_state_mem_area_t *area, void *start, void *end) {
     // align end pointer on block boundary
     end = (void*)((uintptr_t)end & (~(BYTES_PER_BLOCK - 1)));
     DEBUG_printf("Initializing GC heap: %p..%p = " UINT_FMT " bytes\n", start, end, (byte*)end - (byte*)start);
@@ -124,46 +289,91 @@ void gc_init(void *start, void *end) {
     //     P = A * BLOCKS_PER_ATB * BYTES_PER_BLOCK
     // => T = A * (1 + BLOCKS_PER_ATB / BLOCKS_PER_FTB + BLOCKS_PER_ATB * BYTES_PER_BLOCK)
     size_t total_byte_len = (byte*)end - (byte*)start;
+    // (the age table, if any, is the same size as the alloc table)
 #if MICROPY_ENABLE_FINALISER
-    MP_STATE_MEM(gc_alloc_table_byte_len) = total_byte_len * BITS_PER_BYTE / (BITS_PER_BYTE + BITS_PER_BYTE * BLOCKS_PER_ATB / BLOCKS_PER_FTB + BITS_PER_BYTE * BLOCKS_PER_ATB * BYTES_PER_BLOCK);
+    area->gc_alloc_table_byte_len = total_byte_len * BITS_PER_BYTE / (BITS_PER_BYTE + AGE_TABLE_BITS + BITS_PER_BYTE * BLOCKS_PER_ATB / BLOCKS_PER_FTB + BITS_PER_BYTE * BLOCKS_PER_ATB * BYTES_PER_BLOCK);
 #else
-    MP_STATE_MEM(gc_alloc_table_byte_len) = total_byte_len / (1 + BITS_PER_BYTE / 2 * BYTES_PER_BLOCK);
+    area->gc_alloc_table_byte_len = total_byte_len * BITS_PER_BYTE / (BITS_PER_BYTE + AGE_TABLE_BITS + BITS_PER_BYTE * BLOCKS_PER_ATB * BYTES_PER_BLOCK);
 #endif
 
-    MP_STATE_MEM(gc_alloc_table_start) = (byte*)start;
+    area->gc_alloc_table_start = (byte*)start;
 
 #if MICROPY_ENABLE_FINALISER
-    size_t gc_finaliser_table_byte_len = (MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB + BLOCKS_PER_FTB - 1) / BLOCKS_PER_FTB;
-    MP_STATE_MEM(gc_finaliser_table_start) = MP_STATE_MEM(gc_alloc_table_start) + MP_STATE_MEM(gc_alloc_table_byte_len);
+    size_t gc_finaliser_table_byte_len = (area->gc_alloc_table_byte_len * BLOCKS_PER_ATB + BLOCKS_PER_FTB - 1) / BLOCKS_PER_FTB;
+    area->gc_finaliser_table_start = area->gc_alloc_table_start + area->gc_alloc_table_byte_len;
 #endif
 
-    size_t gc_pool_block_len = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
-    MP_STATE_MEM(gc_pool_start) = (byte*)end - gc_pool_block_len * BYTES_PER_BLOCK;
-    MP_STATE_MEM(gc_pool_end) = end;
+#if MICROPY_GC_GENERATIONAL
+    area->gc_age_table_start = area->gc_alloc_table_start + area->gc_alloc_table_byte_len;
+    #if MICROPY_ENABLE_FINALISER
+    area->gc_age_table_start += gc_finaliser_table_byte_len;
+    #endif
+#endif
+
+    size_t gc_pool_block_len = AREA_BLOCKS(area);
+    area->gc_pool_start = (byte*)end - gc_pool_block_len * BYTES_PER_BLOCK;
+    area->gc_pool_end = end;
 
 #if MICROPY_ENABLE_FINALISER
-    assert(MP_STATE_MEM(gc_pool_start) >= MP_STATE_MEM(gc_finaliser_table_start) + gc_finaliser_table_byte_len);
+    assert(area->gc_pool_start >= area->gc_finaliser_table_start + gc_finaliser_table_byte_len);
+#endif
+#if MICROPY_GC_GENERATIONAL
+    assert(area->gc_pool_start >= area->gc_age_table_start + area->gc_alloc_table_byte_len);
 #endif
 
     // clear ATBs
-    memset(MP_STATE_MEM(gc_alloc_table_start), 0, MP_STATE_MEM(gc_alloc_table_byte_len));
+    memset(area->gc_alloc_table_start, 0, area->gc_alloc_table_byte_len);
 
 #if MICROPY_ENABLE_FINALISER
     // clear FTBs
-    memset(MP_STATE_MEM(gc_finaliser_table_start), 0, gc_finaliser_table_byte_len);
+    memset(area->gc_finaliser_table_start, 0, gc_finaliser_table_byte_len);
+#endif
+
+#if MICROPY_GC_GENERATIONAL
+    // clear the age table
+    memset(area->gc_age_table_start, 0, area->gc_alloc_table_byte_len);
 #endif
 
     // Set first free ATB index to the start of the heap.
     for (size_t i = 0; i < MICROPY_ATB_INDICES; i++) {
-        MP_STATE_MEM(gc_first_free_atb_index)[i] = 0;
+        area->gc_first_free_atb_index[i] = 0;
     }
 
     // Set last free ATB index to the end of the heap.
-    MP_STATE_MEM(gc_last_free_atb_index) = MP_STATE_MEM(gc_alloc_table_byte_len) - 1;
+    area->gc_last_free_atb_index = area->gc_alloc_table_byte_len - 1;
 
     // Set the lowest long lived ptr to the end of the heap to start. This will be lowered as long
     // lived objects are allocated.
-    MP_STATE_MEM(gc_lowest_long_lived_ptr) = (void*) PTR_FROM_BLOCK(MP_STATE_MEM(gc_alloc_table_byte_len * BLOCKS_PER_ATB));
+    area->gc_lowest_long_lived_ptr = (void*) PTR_FROM_BLOCK(area, AREA_BLOCKS(area));
+
+    #if MICROPY_GC_SLAB
+    gc_slab_reset(area);
+    #endif
+
+    #if MICROPY_GC_GENERATIONAL
+    area->gc_young_lo = (size_t)-1;
+    area->gc_young_hi = 0;
+    #endif
+
+    #if MICROPY_GC_INCREMENTAL
+    // no sweep pending
+    area->gc_sweep.block = gc_pool_block_len;
+    #endif
+
+    #if MICROPY_GC_SPLIT_HEAP
+    area->next = NULL;
+    #endif
+
+    DEBUG_printf("GC layout:\n");
+    DEBUG_printf("  alloc table at %p, length " UINT_FMT " bytes, " UINT_FMT " blocks\n", area->gc_alloc_table_start, area->gc_alloc_table_byte_len, AREA_BLOCKS(area));
+#if MICROPY_ENABLE_FINALISER
+    DEBUG_printf("  finaliser table at %p, length " UINT_FMT " bytes, " UINT_FMT " blocks\n", area->gc_finaliser_table_start, gc_finaliser_table_byte_len, gc_finaliser_table_byte_len * BLOCKS_PER_FTB);
+#endif
+    DEBUG_printf("  pool at %p, length " UINT_FMT " bytes, " UINT_FMT " blocks\n", area->gc_pool_start, gc_pool_block_len * BYTES_PER_BLOCK, gc_pool_block_len);
+}
+
+void gc_init(void *start, void *end) {
+    gc_setup_area(&MP_STATE_MEM(area), start, end);
 
     // unlock the GC
     MP_STATE_MEM(gc_lock_depth) = 0;
@@ -177,25 +387,57 @@ void gc_init(void *start, void *end) {
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
 
+    #if MICROPY_GC_SPLIT_HEAP
+    MP_STATE_MEM(gc_large_threshold) = MICROPY_GC_SPLIT_HEAP_THRESHOLD;
+    #endif
+
+    #if MICROPY_GC_GENERATIONAL
+    MP_STATE_MEM(gc_minor) = false;
+    MP_STATE_MEM(gc_minor_count) = 0;
+    MP_STATE_MEM(gc_minor_max) = MICROPY_GC_GEN_MINOR_MAX;
+    #endif
+
+    #if MICROPY_GC_INCREMENTAL
+    MP_STATE_MEM(gc_step_budget_us) = MICROPY_GC_STEP_BUDGET_US;
+    MP_STATE_MEM(gc_pause_count) = 0;
+    MP_STATE_MEM(gc_pause_total_us) = 0;
+    MP_STATE_MEM(gc_pause_max_us) = 0;
+    #endif
+
+    #if MICROPY_GC_DEFER_FINALISERS
+    MP_STATE_MEM(gc_finaliser_len) = 0;
+    #endif
+
     #if MICROPY_PY_THREAD
     mp_thread_mutex_init(&MP_STATE_MEM(gc_mutex));
     #endif
 
     MP_STATE_MEM(permanent_pointers) = NULL;
+}
 
-    DEBUG_printf("GC layout:\n");
-    DEBUG_printf("  alloc table at %p, length " UINT_FMT " bytes, " UINT_FMT " blocks\n", MP_STATE_MEM(gc_alloc_table_start), MP_STATE_MEM(gc_alloc_table_byte_len), MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB);
-#if MICROPY_ENABLE_FINALISER
-    DEBUG_printf("  finaliser table at %p, length " UINT_FMT " bytes, " UINT_FMT " blocks\n", MP_STATE_MEM(gc_finaliser_table_start), gc_finaliser_table_byte_len, gc_finaliser_table_byte_len * BLOCKS_PER_FTB);
-#endif
-    DEBUG_printf("  pool at %p, length " UINT_FMT " bytes, " UINT_FMT " blocks\n", MP_STATE_MEM(gc_pool_start), gc_pool_block_len * BYTES_PER_BLOCK, gc_pool_block_len);
+#if MICROPY_GC_SPLIT_HEAP
+void gc_add(void *start, void *end) {
+    // the area's state goes at the start of its memory, aligned for the tables
+    mp_state_mem_area_t *area = (mp_state_mem_area_t*)(((uintptr_t)start + sizeof(void*) - 1) & ~(sizeof(void*) - 1));
+    start = area + 1;
+    assert((byte*)end > (byte*)start + BLOCKS_PER_ATB * BYTES_PER_BLOCK);
+    gc_setup_area(area, start, end);
+
+    GC_ENTER();
+    mp_state_mem_area_t *prev = &MP_STATE_MEM(area);
+    while (prev->next != NULL) {
+        prev = prev->next;
+    }
+    prev->next = area;
+    GC_EXIT();
 }
+#endif
 
 void gc_deinit(void) {
     // Run any finalizers before we stop using the heap.
     gc_sweep_all();
 
-    MP_STATE_MEM(gc_pool_start) = 0;
+    MP_STATE_MEM(area).gc_pool_start = 0;
 }
 
 void gc_lock(void) {
@@ -226,7 +468,7 @@ bool gc_is_locked(void) {
 // children: mark the unmarked child blocks and put those newly marked
 // blocks on the stack. When all children have been checked, pop off the
 // topmost block on the stack and repeat with that one.
-STATIC void gc_mark_subtree(size_t block) {
+STATIC void gc_mark_subtree(mp_state_mem_area_t *area, size_t block) {
     // Start with the block passed in the argument.
     size_t sp = 0;
     for (;;) {
@@ -234,21 +476,26 @@ STATIC void gc_mark_subtree(size_t block) {
         size_t n_blocks = 0;
         do {
             n_blocks += 1;
-        } while (ATB_GET_KIND(block + n_blocks) == AT_TAIL);
+        } while (ATB_GET_KIND(area, block + n_blocks) == AT_TAIL);
 
         // check this block's children
-        void **ptrs = (void**)PTR_FROM_BLOCK(block);
+        void **ptrs = (void**)PTR_FROM_BLOCK(area, block);
         for (size_t i = n_blocks * BYTES_PER_BLOCK / sizeof(void*); i > 0; i--, ptrs++) {
             void *ptr = *ptrs;
-            if (VERIFY_PTR(ptr)) {
+            mp_state_mem_area_t *ptr_area = gc_get_ptr_area(ptr);
+            if (ptr_area != NULL) {
                 // Mark and push this pointer
-                size_t childblock = BLOCK_FROM_PTR(ptr);
-                if (ATB_GET_KIND(childblock) == AT_HEAD) {
+                size_t childblock = BLOCK_FROM_PTR(ptr_area, ptr);
+                if (ATB_GET_KIND(ptr_area, childblock) == AT_HEAD) {
                     // an unmarked head, mark it, and push it on gc stack
                     TRACE_MARK(childblock, ptr);
-                    ATB_HEAD_TO_MARK(childblock);
+                    ATB_HEAD_TO_SURVIVOR(ptr_area, childblock);
                     if (sp < MICROPY_ALLOC_GC_STACK_SIZE) {
-                        MP_STATE_MEM(gc_stack)[sp++] = childblock;
+                        MP_STATE_MEM(gc_stack)[sp] = childblock;
+                        #if MICROPY_GC_SPLIT_HEAP
+                        MP_STATE_MEM(gc_area_stack)[sp] = ptr_area;
+                        #endif
+                        sp++;
                     } else {
                         MP_STATE_MEM(gc_stack_overflow) = 1;
                     }
@@ -262,7 +509,11 @@ STATIC void gc_mark_subtree(size_t block) {
         }
 
         // pop the next block off the stack
-        block = MP_STATE_MEM(gc_stack)[--sp];
+        sp--;
+        block = MP_STATE_MEM(gc_stack)[sp];
+        #if MICROPY_GC_SPLIT_HEAP
+        area = MP_STATE_MEM(gc_area_stack)[sp];
+        #endif
     }
 }
 
@@ -271,52 +522,155 @@ STATIC void gc_deal_with_stack_overflow(void) {
         MP_STATE_MEM(gc_stack_overflow) = 0;
 
         // scan entire memory looking for blocks which have been marked but not their children
-        for (size_t block = 0; block < MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB; block++) {
-            // trace (again) if mark bit set
-            if (ATB_GET_KIND(block) == AT_MARK) {
-                gc_mark_subtree(block);
+        for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+            for (size_t block = 0; block < AREA_BLOCKS(area); block++) {
+                // trace (again) if mark bit set
+                if (ATB_GET_KIND(area, block) == AT_MARK) {
+                    gc_mark_subtree(area, block);
+                }
             }
         }
     }
 }
 
-STATIC void gc_sweep(void) {
-    #if MICROPY_PY_GC_COLLECT_RETVAL
-    MP_STATE_MEM(gc_collected) = 0;
+#if MICROPY_ENABLE_FINALISER
+STATIC void gc_call_finaliser(mp_state_mem_area_t *area, size_t block) {
+    mp_obj_base_t *obj = (mp_obj_base_t*)PTR_FROM_BLOCK(area, block);
+    if (obj->type != NULL) {
+        // if the object has a type then see if it has a __del__ method
+        mp_obj_t dest[2];
+        mp_load_method_maybe(MP_OBJ_FROM_PTR(obj), MP_QSTR___del__, dest);
+        if (dest[0] != MP_OBJ_NULL) {
+            // load_method returned a method, execute it in a protected environment
+            #if MICROPY_ENABLE_SCHEDULER
+            mp_sched_lock();
+            #endif
+            mp_call_function_1_protected(dest[0], dest[1]);
+            #if MICROPY_ENABLE_SCHEDULER
+            mp_sched_unlock();
+            #endif
+        }
+    }
+}
+#endif
+
+#if MICROPY_GC_SLAB && MICROPY_ENABLE_FINALISER
+// Call the finalisers of all the unmarked objects before a sweep.  The sweep
+// overwrites the first word of dead objects it puts on the free lists, so a
+// finaliser run from the sweep could find the objects it refers to broken.
+STATIC void gc_call_dead_finalisers(void) {
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        size_t ftb_len = AREA_BLOCKS(area) / BLOCKS_PER_FTB;
+        for (size_t i = 0; i < ftb_len; i++) {
+            // the table is sparse, so skip over whole bytes where possible
+            if (area->gc_finaliser_table_start[i] == 0) {
+                continue;
+            }
+            for (size_t block = i * BLOCKS_PER_FTB; block < (i + 1) * BLOCKS_PER_FTB; block++) {
+                if (FTB_GET(area, block) && ATB_GET_KIND(area, block) == AT_HEAD) {
+                    gc_call_finaliser(area, block);
+                    FTB_CLEAR(area, block);
+                }
+            }
+        }
+    }
+}
+#endif
+
+STATIC void gc_sweep_begin(mp_state_mem_area_t *area, gc_sweep_state_t *st) {
+    #if MICROPY_GC_SLAB
+    gc_slab_reset(area);
     #endif
-    // free unmarked heads and their tails
-    int free_tail = 0;
-    for (size_t block = 0; block < MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB; block++) {
-        switch (ATB_GET_KIND(block)) {
+    st->block = 0;
+    st->free_tail = false;
+    #if MICROPY_GC_GENERATIONAL
+    // the sweep and allocations find the young objects again
+    area->gc_young_lo = (size_t)-1;
+    area->gc_young_hi = 0;
+    #endif
+    // Track runs of free blocks so that gc_first_free_atb_index can be set to
+    // the first run that fits each size bucket.  A run reaching length n means
+    // it reached every smaller length first, so the buckets fill in order.
+    st->run_start = 0;
+    st->run_len = 0;
+    st->n_buckets_set = 0;
+}
+
+// Free unmarked heads and their tails in an area, starting from st->block.  If budget_us
+// is non-zero then stop once roughly that much time has passed since start_us.
+// If want_run is non-zero then stop as soon as the sweep has produced a run of
+// that many free blocks, ending just before the new st->block.
+// The sweep never stops part way through the tail of an object it is freeing,
+// because gc_realloc and gc_free take the tail blocks that follow a head to
+// be part of it, and a new object may be allocated just before st->block.
+// Returns true once the whole area has been swept.
+STATIC bool gc_sweep_run(mp_state_mem_area_t *area, gc_sweep_state_t *st, mp_uint_t start_us, mp_uint_t budget_us, size_t want_run) {
+    size_t block = st->block;
+    #if MICROPY_GC_INCREMENTAL
+    size_t first_block = block;
+    bool check_time = false;
+    bool found_run = false;
+    #endif
+    bool free_tail = st->free_tail;
+    size_t run_start = st->run_start;
+    size_t run_len = st->run_len;
+    size_t n_buckets_set = st->n_buckets_set;
+    size_t end_block = AREA_BLOCKS(area);
+    #if !MICROPY_GC_INCREMENTAL
+    (void)start_us;
+    (void)budget_us;
+    (void)want_run;
+    #endif
+
+    for (; block < end_block; block++) {
+        byte kind = ATB_GET_KIND(area, block);
+        #if MICROPY_GC_INCREMENTAL
+        if (kind == AT_TAIL && free_tail) {
+            // in the tail of an object being freed, which must be finished
+        } else if (found_run) {
+            break;
+        } else if (budget_us != 0 && ((block & 0xff) == 0 || check_time) && block != first_block) {
+            // check the time only every so often, or after a finaliser, it's not free
+            if (MICROPY_GC_TICKS_US() - start_us >= budget_us) {
+                break;
+            }
+            check_time = false;
+        }
+        #endif
+        #if MICROPY_GC_SLAB
+        if (kind == AT_HEAD) {
+            size_t n_blocks = gc_slab_take(area, block);
+            if (n_blocks != 0) {
+                // the object is dead but stays allocated, on its free list;
+                // this isn't a run for want_run, so a lazy sweep fills the list
+                #if MICROPY_PY_GC_COLLECT_RETVAL
+                MP_STATE_MEM(gc_collected)++;
+                #endif
+                free_tail = false;
+                run_len = 0;
+                block += n_blocks - 1;
+                continue;
+            }
+        }
+        #endif
+        switch (kind) {
             case AT_HEAD:
 #if MICROPY_ENABLE_FINALISER
-                if (FTB_GET(block)) {
-                    mp_obj_base_t *obj = (mp_obj_base_t*)PTR_FROM_BLOCK(block);
-                    if (obj->type != NULL) {
-                        // if the object has a type then see if it has a __del__ method
-                        mp_obj_t dest[2];
-                        mp_load_method_maybe(MP_OBJ_FROM_PTR(obj), MP_QSTR___del__, dest);
-                        if (dest[0] != MP_OBJ_NULL) {
-                            // load_method returned a method, execute it in a protected environment
-                            #if MICROPY_ENABLE_SCHEDULER
-                            mp_sched_lock();
-                            #endif
-                            mp_call_function_1_protected(dest[0], dest[1]);
-                            #if MICROPY_ENABLE_SCHEDULER
-                            mp_sched_unlock();
-                            #endif
-                        }
-                    }
+                if (FTB_GET(area, block)) {
+                    gc_call_finaliser(area, block);
                     // clear finaliser flag
-                    FTB_CLEAR(block);
+                    FTB_CLEAR(area, block);
+                    #if MICROPY_GC_INCREMENTAL
+                    check_time = true;
+                    #endif
                 }
 #endif
-                free_tail = 1;
-                ATB_ANY_TO_FREE(block);
+                free_tail = true;
+                ATB_ANY_TO_FREE(area, block);
                 #if CLEAR_ON_SWEEP
-                memset((void*)PTR_FROM_BLOCK(block), 0, BYTES_PER_BLOCK);
+                memset((void*)PTR_FROM_BLOCK(area, block), 0, BYTES_PER_BLOCK);
                 #endif
-                DEBUG_printf("gc_sweep(%x)\n", PTR_FROM_BLOCK(block));
+                DEBUG_printf("gc_sweep(%x)\n", PTR_FROM_BLOCK(area, block));
 
                 #ifdef LOG_HEAP_ACTIVITY
                 gc_log_change(block, 0);
@@ -328,42 +682,318 @@ STATIC void gc_sweep(void) {
 
             case AT_TAIL:
                 if (free_tail) {
-                    ATB_ANY_TO_FREE(block);
+                    ATB_ANY_TO_FREE(area, block);
                     #if CLEAR_ON_SWEEP
-                    memset((void*)PTR_FROM_BLOCK(block), 0, BYTES_PER_BLOCK);
+                    memset((void*)PTR_FROM_BLOCK(area, block), 0, BYTES_PER_BLOCK);
                     #endif
                 }
                 break;
 
             case AT_MARK:
-                ATB_MARK_TO_HEAD(block);
-                free_tail = 0;
+                #if MICROPY_GC_GENERATIONAL
+                if (AGE_GET(area, block) < AGE_OLD) {
+                    ATB_MARK_TO_HEAD(area, block);
+                    gc_note_young(area, block);
+                }
+                #else
+                ATB_MARK_TO_HEAD(area, block);
+                #endif
+                free_tail = false;
                 break;
         }
+
+        if (kind == AT_FREE || kind == AT_HEAD || (kind == AT_TAIL && free_tail)) {
+            if (run_len == 0) {
+                run_start = block;
+            }
+            run_len++;
+            if (run_len > n_buckets_set && n_buckets_set < MICROPY_ATB_INDICES) {
+                area->gc_first_free_atb_index[n_buckets_set++] = run_start / BLOCKS_PER_ATB;
+            }
+            #if MICROPY_GC_INCREMENTAL
+            if (want_run != 0 && run_len == want_run) {
+                // make sure the allocation that wanted this run finds it
+                size_t bucket = MIN(want_run, MICROPY_ATB_INDICES) - 1;
+                if (run_start / BLOCKS_PER_ATB < area->gc_first_free_atb_index[bucket]) {
+                    area->gc_first_free_atb_index[bucket] = run_start / BLOCKS_PER_ATB;
+                }
+                found_run = true;
+            }
+            #endif
+        } else {
+            run_len = 0;
+        }
+    }
+
+    st->block = block;
+    st->free_tail = free_tail;
+    st->run_start = run_start;
+    st->run_len = run_len;
+    st->n_buckets_set = n_buckets_set;
+    return block >= end_block;
+}
+
+STATIC void gc_sweep(mp_state_mem_area_t *area) {
+    gc_sweep_state_t st;
+    gc_sweep_begin(area, &st);
+    gc_sweep_run(area, &st, 0, 0, 0);
+
+    // No free run is big enough for the remaining buckets.
+    for (size_t i = st.n_buckets_set; i < MICROPY_ATB_INDICES; i++) {
+        area->gc_first_free_atb_index[i] = area->gc_alloc_table_byte_len;
+    }
+}
+
+#if MICROPY_GC_INCREMENTAL
+STATIC void gc_record_pause(mp_uint_t start_us) {
+    mp_uint_t pause = MICROPY_GC_TICKS_US() - start_us;
+    MP_STATE_MEM(gc_pause_log)[MP_STATE_MEM(gc_pause_count) % MICROPY_GC_PAUSE_LOG_LEN] = pause;
+    MP_STATE_MEM(gc_pause_count) += 1;
+    MP_STATE_MEM(gc_pause_total_us) += pause;
+    if (pause > MP_STATE_MEM(gc_pause_max_us)) {
+        MP_STATE_MEM(gc_pause_max_us) = pause;
+    }
+}
+
+STATIC bool gc_area_sweep_pending(mp_state_mem_area_t *area) {
+    return area->gc_sweep.block < AREA_BLOCKS(area);
+}
+
+bool gc_sweep_pending(void) {
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        if (gc_area_sweep_pending(area)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Continue a pending incremental sweep for at most budget_us, or to the end
+// if budget_us is 0.  If area is not NULL then only that area is swept, and
+// the sweep stops early once a run of want_run free blocks is found.
+STATIC void gc_sweep_incremental(mp_state_mem_area_t *area, mp_uint_t budget_us, size_t want_run) {
+    GC_ENTER();
+    if (MP_STATE_MEM(area).gc_pool_start == 0 || MP_STATE_MEM(gc_lock_depth) > 0 || !gc_sweep_pending()) {
+        GC_EXIT();
+        return;
+    }
+    MP_STATE_MEM(gc_lock_depth)++;
+    mp_uint_t start_us = MICROPY_GC_TICKS_US();
+    if (area != NULL) {
+        gc_sweep_run(area, &area->gc_sweep, start_us, budget_us, want_run);
+    } else {
+        // the areas in order, until the budget runs out
+        for (area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+            if (!gc_sweep_run(area, &area->gc_sweep, start_us, budget_us, 0)) {
+                break;
+            }
+        }
+    }
+    gc_record_pause(start_us);
+    MP_STATE_MEM(gc_lock_depth)--;
+    GC_EXIT();
+}
+
+void gc_sweep_step(void) {
+    gc_sweep_incremental(NULL, MP_STATE_MEM(gc_step_budget_us), 0);
+}
+
+void gc_sweep_finish(void) {
+    gc_sweep_incremental(NULL, 0, 0);
+}
+#endif
+
+#if MICROPY_GC_DEFER_FINALISERS
+size_t gc_finalisers_pending(void) {
+    return MP_STATE_MEM(gc_finaliser_len);
+}
+
+// Find the objects with a finaliser that the mark phase didn't reach.  As many
+// as fit are queued for gc_run_finalisers, and marked so that the sweep keeps
+// them.  The sweep finalises the rest itself.  Either way, everything they
+// refer to is marked so that nothing a finaliser might use is swept before it
+// has run.
+STATIC void gc_queue_finalisers(void) {
+    size_t len = MP_STATE_MEM(gc_finaliser_len);
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        size_t ftb_len = AREA_BLOCKS(area) / BLOCKS_PER_FTB;
+        for (size_t i = 0; i < ftb_len; i++) {
+            // the table is sparse, so skip over whole bytes where possible
+            if (area->gc_finaliser_table_start[i] == 0) {
+                continue;
+            }
+            for (size_t block = i * BLOCKS_PER_FTB; block < (i + 1) * BLOCKS_PER_FTB; block++) {
+                if (!FTB_GET(area, block) || ATB_GET_KIND(area, block) != AT_HEAD) {
+                    continue;
+                }
+                if (len < MICROPY_GC_FINALISER_QUEUE_LEN) {
+                    MP_STATE_MEM(gc_finaliser_queue)[len++] = (void*)PTR_FROM_BLOCK(area, block);
+                    ATB_HEAD_TO_MARK(area, block);
+                }
+                gc_mark_subtree(area, block);
+            }
+        }
+    }
+    gc_deal_with_stack_overflow();
+    MP_STATE_MEM(gc_finaliser_len) = len;
+}
+
+// Run the finalisers of up to max_count queued objects and free them.
+void gc_run_finalisers(size_t max_count) {
+    GC_ENTER();
+    if (MP_STATE_MEM(area).gc_pool_start == 0 || MP_STATE_MEM(gc_lock_depth) > 0) {
+        GC_EXIT();
+        return;
+    }
+    // finalisers run with the GC locked, as they would during a sweep
+    MP_STATE_MEM(gc_lock_depth)++;
+    mp_uint_t start_us = MICROPY_GC_TICKS_US();
+    size_t n = 0;
+    while (MP_STATE_MEM(gc_finaliser_len) > 0 && n < max_count) {
+        // remove the object from the queue first, in case __del__ raises
+        void *ptr = MP_STATE_MEM(gc_finaliser_queue)[--MP_STATE_MEM(gc_finaliser_len)];
+        mp_state_mem_area_t *area = gc_get_ptr_area(ptr);
+        size_t start_block = BLOCK_FROM_PTR(area, ptr);
+        n++;
+        if (FTB_GET(area, start_block)) {
+            gc_call_finaliser(area, start_block);
+            FTB_CLEAR(area, start_block);
+        }
+
+        // free it as gc_free would
+        #ifdef LOG_HEAP_ACTIVITY
+        gc_log_change(start_block, 0);
+        #endif
+        size_t block = start_block;
+        do {
+            ATB_ANY_TO_FREE(area, block);
+            block += 1;
+        } while (ATB_GET_KIND(area, block) == AT_TAIL);
+        size_t bucket = MIN(block - start_block, MICROPY_ATB_INDICES) - 1;
+        size_t new_free_atb = start_block / BLOCKS_PER_ATB;
+        if (new_free_atb < area->gc_first_free_atb_index[bucket]) {
+            area->gc_first_free_atb_index[bucket] = new_free_atb;
+        }
+        if (new_free_atb > area->gc_last_free_atb_index) {
+            area->gc_last_free_atb_index = new_free_atb;
+        }
+        #if MICROPY_PY_GC_COLLECT_RETVAL
+        MP_STATE_MEM(gc_collected)++;
+        #endif
+    }
+    if (n > 0) {
+        gc_record_pause(start_us);
     }
+    MP_STATE_MEM(gc_lock_depth)--;
+    GC_EXIT();
 }
+#endif
 
 // Mark can handle NULL pointers because it verifies the pointer is within the heap bounds.
 STATIC void gc_mark(void* ptr) {
-    if (VERIFY_PTR(ptr)) {
-        size_t block = BLOCK_FROM_PTR(ptr);
-        if (ATB_GET_KIND(block) == AT_HEAD) {
+    mp_state_mem_area_t *area = gc_get_ptr_area(ptr);
+    if (area != NULL) {
+        size_t block = BLOCK_FROM_PTR(area, ptr);
+        if (ATB_GET_KIND(area, block) == AT_HEAD) {
             // An unmarked head: mark it, and mark all its children
             TRACE_MARK(block, ptr);
-            ATB_HEAD_TO_MARK(block);
-            gc_mark_subtree(block);
+            ATB_HEAD_TO_SURVIVOR(area, block);
+            gc_mark_subtree(area, block);
         }
     }
 }
 
+#if MICROPY_GC_GENERATIONAL
+// Old objects keep their mark between collections, so a minor collection
+// doesn't trace them.  There are no write barriers to keep a remembered set of
+// the old objects that point to young ones, so a minor collection rebuilds it
+// by scanning all the old objects for pointers into the range of blocks that
+// holds the young heads, and traces what they point to.
+STATIC void gc_mark_from_old(void) {
+    // the pointers that may be to young heads, across all the areas
+    void *lo = (void*)(uintptr_t)-1;
+    void *hi = NULL;
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        if (area->gc_young_lo <= area->gc_young_hi) {
+            lo = MIN(lo, (void*)PTR_FROM_BLOCK(area, area->gc_young_lo));
+            hi = MAX(hi, (void*)PTR_FROM_BLOCK(area, area->gc_young_hi));
+        }
+    }
+    if (lo > hi) {
+        // no young objects
+        return;
+    }
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        size_t end_block = AREA_BLOCKS(area);
+        for (size_t block = 0; block < end_block;) {
+            byte a = area->gc_alloc_table_start[block / BLOCKS_PER_ATB];
+            if ((block & (BLOCKS_PER_ATB - 1)) == 0 && (a & (a >> 1) & 0x55) == 0) {
+                // no marked heads in this ATB
+                block += BLOCKS_PER_ATB;
+                continue;
+            }
+            if (ATB_GET_KIND(area, block) != AT_MARK || AGE_GET(area, block) != AGE_OLD) {
+                // not the head of an old object; young ones this loop promotes
+                // are scanned again, which is harmless
+                block++;
+                continue;
+            }
+            do {
+                void **ptrs = (void**)PTR_FROM_BLOCK(area, block);
+                for (size_t i = BYTES_PER_BLOCK / sizeof(void*); i > 0; i--, ptrs++) {
+                    void *ptr = *ptrs;
+                    if (lo <= ptr && ptr <= hi) {
+                        gc_mark(ptr);
+                    }
+                }
+                block++;
+            } while (block < end_block && ATB_GET_KIND(area, block) == AT_TAIL);
+        }
+    }
+}
+
+// Clear the marks kept by the old objects, for a major collection.
+STATIC void gc_unmark_old(void) {
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        byte *atb = area->gc_alloc_table_start;
+        for (size_t i = 0; i < area->gc_alloc_table_byte_len; i++) {
+            byte marks = atb[i] & (atb[i] >> 1) & 0x55;
+            atb[i] &= ~(marks << 1);
+        }
+    }
+}
+
+void gc_collect_young(void) {
+    if (MP_STATE_MEM(gc_minor_count) < MP_STATE_MEM(gc_minor_max)) {
+        MP_STATE_MEM(gc_minor) = true;
+    }
+    gc_collect();
+}
+#endif
+
 void gc_collect_start(void) {
+    #if MICROPY_GC_INCREMENTAL
+    // the mark phase needs the heap to be fully swept
+    gc_sweep_finish();
+    #endif
     GC_ENTER();
     MP_STATE_MEM(gc_lock_depth)++;
+    #if MICROPY_GC_INCREMENTAL
+    MP_STATE_MEM(gc_collect_start_us) = MICROPY_GC_TICKS_US();
+    #endif
     #if MICROPY_GC_ALLOC_THRESHOLD
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
     MP_STATE_MEM(gc_stack_overflow) = 0;
 
+    #if MICROPY_GC_GENERATIONAL
+    if (MP_STATE_MEM(gc_minor)) {
+        gc_mark_from_old();
+    } else {
+        gc_unmark_old();
+    }
+    #endif
+
     // Trace root pointers.  This relies on the root pointers being organised
     // correctly in the mp_state_ctx structure.  We scan nlr_top, dict_locals,
     // dict_globals, then the root pointer section of mp_state_vm.
@@ -374,6 +1004,11 @@ void gc_collect_start(void) {
 
     gc_mark(MP_STATE_MEM(permanent_pointers));
 
+    #if MICROPY_GC_DEFER_FINALISERS
+    // objects still waiting for their finaliser must not be found again
+    gc_collect_root(MP_STATE_MEM(gc_finaliser_queue), MP_STATE_MEM(gc_finaliser_len));
+    #endif
+
     #if MICROPY_ENABLE_PYSTACK
     // Trace root pointers from the Python stack.
     ptrs = (void**)(void*)MP_STATE_THREAD(pystack_start);
@@ -392,36 +1027,89 @@ void gc_collect_root(void **ptrs, size_t len) {
     }
 }
 
-void gc_collect_end(void) {
+STATIC void gc_collect_finish(bool incremental) {
     gc_deal_with_stack_overflow();
-    gc_sweep();
-    for (size_t i = 0; i < MICROPY_ATB_INDICES; i++) {
-        MP_STATE_MEM(gc_first_free_atb_index)[i] = 0;
+    #if MICROPY_GC_INCREMENTAL && MICROPY_GC_DEFER_FINALISERS
+    if (incremental) {
+        // this also keeps everything the finalisers refer to
+        gc_queue_finalisers();
+    } else
+    #endif
+    {
+        #if MICROPY_GC_SLAB && MICROPY_ENABLE_FINALISER
+        gc_call_dead_finalisers();
+        #endif
+    }
+    #if MICROPY_PY_GC_COLLECT_RETVAL
+    MP_STATE_MEM(gc_collected) = 0;
+    #endif
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        #if MICROPY_GC_INCREMENTAL
+        if (incremental) {
+            // Leave the sweep to gc_sweep_step and gc_alloc.  Until a bucket is
+            // set by the sweep the search for free blocks starts at the bottom.
+            gc_sweep_begin(area, &area->gc_sweep);
+            for (size_t i = 0; i < MICROPY_ATB_INDICES; i++) {
+                area->gc_first_free_atb_index[i] = 0;
+            }
+        } else
+        #else
+        (void)incremental;
+        #endif
+        {
+            // gc_sweep also sets gc_first_free_atb_index
+            gc_sweep(area);
+        }
+        area->gc_last_free_atb_index = area->gc_alloc_table_byte_len - 1;
     }
-    MP_STATE_MEM(gc_last_free_atb_index) = MP_STATE_MEM(gc_alloc_table_byte_len) - 1;
+    #if MICROPY_GC_GENERATIONAL
+    if (MP_STATE_MEM(gc_minor)) {
+        MP_STATE_MEM(gc_minor) = false;
+        MP_STATE_MEM(gc_minor_count) += 1;
+    } else {
+        MP_STATE_MEM(gc_minor_count) = 0;
+    }
+    #endif
+    #if MICROPY_GC_INCREMENTAL
+    gc_record_pause(MP_STATE_MEM(gc_collect_start_us));
+    #endif
     MP_STATE_MEM(gc_lock_depth)--;
     GC_EXIT();
 }
 
+void gc_collect_end(void) {
+    #if MICROPY_GC_INCREMENTAL
+    gc_collect_finish(MP_STATE_MEM(gc_step_budget_us) != 0);
+    #else
+    gc_collect_finish(false);
+    #endif
+}
+
 void gc_sweep_all(void) {
+    #if MICROPY_GC_INCREMENTAL
+    gc_sweep_finish();
+    #endif
+    #if MICROPY_GC_DEFER_FINALISERS
+    gc_run_finalisers((size_t)-1);
+    #endif
     GC_ENTER();
     MP_STATE_MEM(gc_lock_depth)++;
     MP_STATE_MEM(gc_stack_overflow) = 0;
-    gc_collect_end();
+    #if MICROPY_GC_INCREMENTAL
+    MP_STATE_MEM(gc_collect_start_us) = MICROPY_GC_TICKS_US();
+    #endif
+    #if MICROPY_GC_GENERATIONAL
+    gc_unmark_old();
+    #endif
+    gc_collect_finish(false);
 }
 
-void gc_info(gc_info_t *info) {
-    GC_ENTER();
-    info->total = MP_STATE_MEM(gc_pool_end) - MP_STATE_MEM(gc_pool_start);
-    info->used = 0;
-    info->free = 0;
-    info->max_free = 0;
-    info->num_1block = 0;
-    info->num_2block = 0;
-    info->max_block = 0;
+// Add the blocks of an area to info, in blocks rather than bytes.
+STATIC void gc_info_area(mp_state_mem_area_t *area, gc_info_t *info) {
+    info->total += area->gc_pool_end - area->gc_pool_start;
     bool finish = false;
     for (size_t block = 0, len = 0, len_free = 0; !finish;) {
-        size_t kind = ATB_GET_KIND(block);
+        size_t kind = ATB_GET_KIND(area, block);
         switch (kind) {
             case AT_FREE:
                 info->free += 1;
@@ -429,6 +1117,9 @@ void gc_info(gc_info_t *info) {
                 len = 0;
                 break;
 
+            #if MICROPY_GC_INCREMENTAL
+            case AT_MARK:
+            #endif
             case AT_HEAD:
                 info->used += 1;
                 len = 1;
@@ -439,19 +1130,21 @@ void gc_info(gc_info_t *info) {
                 len += 1;
                 break;
 
+            #if !MICROPY_GC_INCREMENTAL
             case AT_MARK:
                 // shouldn't happen
                 break;
+            #endif
         }
 
         block++;
-        finish = (block == MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB);
+        finish = (block == AREA_BLOCKS(area));
         // Get next block type if possible
         if (!finish) {
-            kind = ATB_GET_KIND(block);
+            kind = ATB_GET_KIND(area, block);
         }
 
-        if (finish || kind == AT_FREE || kind == AT_HEAD) {
+        if (finish || kind == AT_FREE || ATB_KIND_IS_HEAD(kind)) {
             if (len == 1) {
                 info->num_1block += 1;
             } else if (len == 2) {
@@ -460,7 +1153,7 @@ void gc_info(gc_info_t *info) {
             if (len > info->max_block) {
                 info->max_block = len;
             }
-            if (finish || kind == AT_HEAD) {
+            if (finish || ATB_KIND_IS_HEAD(kind)) {
                 if (len_free > info->max_free) {
                     info->max_free = len_free;
                 }
@@ -469,13 +1162,203 @@ void gc_info(gc_info_t *info) {
         }
     }
 
+    #if MICROPY_GC_SLAB
+    // objects on the slab free lists are free as far as the program is concerned
+    for (size_t i = 0; i < MICROPY_GC_SLAB_CLASSES; i++) {
+        size_t n = area->gc_slab_len[i] * (i + 1);
+        info->used -= n;
+        info->free += n;
+    }
+    #endif
+}
+
+STATIC void gc_info_clear(gc_info_t *info) {
+    info->total = 0;
+    info->used = 0;
+    info->free = 0;
+    info->max_free = 0;
+    info->num_1block = 0;
+    info->num_2block = 0;
+    info->max_block = 0;
+}
+
+void gc_info(gc_info_t *info) {
+    GC_ENTER();
+    gc_info_clear(info);
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        gc_info_area(area, info);
+    }
+    info->used *= BYTES_PER_BLOCK;
+    info->free *= BYTES_PER_BLOCK;
+    GC_EXIT();
+}
+
+#if MICROPY_GC_SPLIT_HEAP
+bool gc_area_info(size_t index, gc_info_t *info, void **start) {
+    GC_ENTER();
+    mp_state_mem_area_t *area = &MP_STATE_MEM(area);
+    for (; area != NULL && index > 0; index--) {
+        area = NEXT_AREA(area);
+    }
+    if (area == NULL) {
+        GC_EXIT();
+        return false;
+    }
+    gc_info_clear(info);
+    gc_info_area(area, info);
     info->used *= BYTES_PER_BLOCK;
     info->free *= BYTES_PER_BLOCK;
+    *start = area->gc_pool_start;
     GC_EXIT();
+    return true;
 }
+#endif
 
 bool gc_alloc_possible(void) {
-    return MP_STATE_MEM(gc_pool_start) != 0;
+    return MP_STATE_MEM(area).gc_pool_start != 0;
+}
+
+#if MICROPY_OPT_GC_ATB_WORD_SCAN
+// Search the ATB forwards, from ATB index i up to and including ATB index
+// last, for a run of n_blocks free blocks.  The search gives up at the first
+// used block at or beyond stop_block.  Returns the last block of the run, or
+// (size_t)-1 if there is none.
+//
+// Four ATB bytes (16 blocks) are checked at a time.  In a 32-bit word w of
+// ATB entries the 2-bit kind of block k is at bits 2k and 2k+1, so
+// (w | (w >> 1)) & 0x55555555 has bit 2k set exactly when block k is in use.
+STATIC size_t gc_find_free_run(mp_state_mem_area_t *area, size_t i, size_t last, size_t n_blocks, size_t stop_block) {
+    const byte *atb = area->gc_alloc_table_start;
+    size_t n_free = 0;
+    while (i <= last) {
+        size_t base = i * BLOCKS_PER_ATB;
+        if (i + 3 <= last && base + 4 * BLOCKS_PER_ATB <= stop_block) {
+            uint32_t w = atb[i] | (atb[i + 1] << 8) | (atb[i + 2] << 16) | ((uint32_t)atb[i + 3] << 24);
+            if (w == 0) {
+                if (n_free + 16 >= n_blocks) {
+                    return base + n_blocks - n_free - 1;
+                }
+                n_free += 16;
+            } else {
+                uint32_t used = (w | (w >> 1)) & 0x55555555;
+                // free blocks at the bottom of the word extend the current run
+                size_t n_low = __builtin_ctz(used) / 2;
+                if (n_free + n_low >= n_blocks) {
+                    return base + n_blocks - n_free - 1;
+                }
+                // look for a run wholly inside the word: after this, bit 2k
+                // of run is set if blocks k..k+n_blocks-1 are all free
+                if (n_blocks < 16) {
+                    uint32_t run = ~used & 0x55555555;
+                    size_t len = 1;
+                    while (2 * len <= n_blocks) {
+                        run &= run >> (2 * len);
+                        len *= 2;
+                    }
+                    if (len < n_blocks) {
+                        run &= run >> (2 * (n_blocks - len));
+                    }
+                    if (run != 0) {
+                        return base + __builtin_ctz(run) / 2 + n_blocks - 1;
+                    }
+                }
+                // free blocks at the top of the word start a new run
+                n_free = __builtin_clz(used) / 2;
+            }
+            i += 4;
+            continue;
+        }
+
+        byte a = atb[i];
+        for (size_t j = 0; j < BLOCKS_PER_ATB; j++) {
+            if ((a & (0x3 << (j * 2))) == 0) {
+                if (++n_free >= n_blocks) {
+                    return base + j;
+                }
+            } else {
+                if (base + j >= stop_block) {
+                    return (size_t)-1;
+                }
+                n_free = 0;
+            }
+        }
+        i++;
+    }
+    return (size_t)-1;
+}
+#endif
+
+// Search an area for a run of n_blocks free blocks, from the bottom up, or
+// from the top down for a long lived object.  Unless cross is true the search
+// gives up once it reaches the other section of the area.  Returns the block
+// where the run was completed (its last block going up, its first block going
+// down), or (size_t)-1 if there is none.
+STATIC size_t gc_alloc_find(mp_state_mem_area_t *area, size_t n_blocks, bool long_lived, bool cross) {
+    size_t crossover_block = BLOCK_FROM_PTR(area, area->gc_lowest_long_lived_ptr);
+    int8_t direction = 1;
+    size_t bucket = MIN(n_blocks, MICROPY_ATB_INDICES) - 1;
+    size_t first_free = area->gc_first_free_atb_index[bucket];
+    size_t start = first_free;
+    if (long_lived) {
+        direction = -1;
+        start = area->gc_last_free_atb_index;
+    }
+    #if MICROPY_OPT_GC_ATB_WORD_SCAN
+    if (!long_lived) {
+        return gc_find_free_run(area, start, area->gc_last_free_atb_index, n_blocks,
+            cross ? (size_t)-1 : crossover_block);
+    }
+    #endif
+    size_t n_free = 0;
+    bool keep_looking = true;
+    // look for a run of n_blocks available blocks
+    for (size_t i = start; keep_looking && first_free <= i && i <= area->gc_last_free_atb_index; i += direction) {
+        byte a = area->gc_alloc_table_start[i];
+        // Four ATB states are packed into a single byte.
+        int j = 0;
+        if (direction == -1) {
+            j = 3;
+        }
+        for (; keep_looking && 0 <= j && j <= 3; j += direction) {
+            if ((a & (0x3 << (j * 2))) == 0) {
+                if (++n_free >= n_blocks) {
+                    return i * BLOCKS_PER_ATB + j;
+                }
+            } else {
+                if (!cross) {
+                    size_t block = i * BLOCKS_PER_ATB + j;
+                    if ((direction == 1 && block >= crossover_block) ||
+                            (direction == -1 && block < crossover_block)) {
+                        keep_looking = false;
+                    }
+                }
+                n_free = 0;
+            }
+        }
+    }
+    return (size_t)-1;
+}
+
+// The next area for an allocation to try, or the first one if area is NULL.
+// Large objects try the areas added by gc_add before the gc_init one, and
+// other objects the gc_init area first.
+STATIC mp_state_mem_area_t *gc_alloc_next_area(mp_state_mem_area_t *area, bool large) {
+    mp_state_mem_area_t *first = &MP_STATE_MEM(area);
+    #if MICROPY_GC_SPLIT_HEAP
+    if (large && first->next != NULL) {
+        if (area == NULL) {
+            return first->next;
+        } else if (area == first) {
+            return NULL;
+        } else if (area->next == NULL) {
+            return first;
+        }
+    }
+    return area == NULL ? first : area->next;
+    #else
+    (void)large;
+    return area == NULL ? first : NULL;
+    #endif
 }
 
 // We place long lived objects at the end of the heap rather than the start. This reduces
@@ -489,7 +1372,7 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
         return NULL;
     }
 
-    if (MP_STATE_MEM(gc_pool_start) == 0) {
+    if (MP_STATE_MEM(area).gc_pool_start == 0) {
         reset_into_safe_mode(GC_ALLOC_OUTSIDE_VM);
     }
 
@@ -501,11 +1384,19 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
         return NULL;
     }
 
+    mp_state_mem_area_t *area;
     size_t found_block = 0xffffffff;
     size_t end_block;
     size_t start_block;
-    size_t n_free;
     bool collected = !MP_STATE_MEM(gc_auto_collect_enabled);
+    bool from_slab = false;
+    // a minor collection also allows searching past the crossover block
+    bool collected_young = false;
+    #if MICROPY_GC_SPLIT_HEAP
+    bool large = MP_STATE_MEM(gc_large_threshold) != 0 && n_bytes >= MP_STATE_MEM(gc_large_threshold);
+    #else
+    bool large = false;
+    #endif
 
     #if MICROPY_GC_ALLOC_THRESHOLD
     if (!collected && MP_STATE_MEM(gc_alloc_amount) >= MP_STATE_MEM(gc_alloc_threshold)) {
@@ -516,61 +1407,80 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
     }
     #endif
 
-    bool keep_looking = true;
-
-    // When we start searching on the other side of the crossover block we make sure to
-    // perform a collect. That way we'll get the closest free block in our section.
-    size_t crossover_block = BLOCK_FROM_PTR(MP_STATE_MEM(gc_lowest_long_lived_ptr));
-    while (keep_looking) {
-        int8_t direction = 1;
-        size_t bucket = MIN(n_blocks, MICROPY_ATB_INDICES) - 1;
-        size_t first_free = MP_STATE_MEM(gc_first_free_atb_index)[bucket];
-        size_t start = first_free;
-        if (long_lived) {
-            direction = -1;
-            start = MP_STATE_MEM(gc_last_free_atb_index);
-        }
-        n_free = 0;
-        // look for a run of n_blocks available blocks
-        for (size_t i = start; keep_looking && first_free <= i && i <= MP_STATE_MEM(gc_last_free_atb_index); i += direction) {
-            byte a = MP_STATE_MEM(gc_alloc_table_start)[i];
-            // Four ATB states are packed into a single byte.
-            int j = 0;
-            if (direction == -1) {
-                j = 3;
-            }
-            for (; keep_looking && 0 <= j && j <= 3; j += direction) {
-                if ((a & (0x3 << (j * 2))) == 0) {
-                    if (++n_free >= n_blocks) {
-                        found_block = i * BLOCKS_PER_ATB + j;
-                        keep_looking = false;
-                    }
-                } else {
-                    if (!collected) {
-                        size_t block = i * BLOCKS_PER_ATB + j;
-                        if ((direction == 1 && block >= crossover_block) ||
-                                (direction == -1 && block < crossover_block)) {
-                            keep_looking = false;
-                        }
-                    }
-                    n_free = 0;
+    for (;;) {
+        // Try each area in turn, then collect and try them all again.  When we start
+        // searching on the other side of an area's crossover block we make sure to
+        // perform a collect. That way we'll get the closest free block in our section.
+        area = gc_alloc_next_area(NULL, large);
+        while (area != NULL) {
+            #if MICROPY_GC_SLAB
+            if (!long_lived && n_blocks <= MICROPY_GC_SLAB_CLASSES) {
+                found_block = gc_slab_pop(area, n_blocks);
+                if (found_block != (size_t)-1) {
+                    from_slab = true;
+                    break;
                 }
             }
+            #endif
+            found_block = gc_alloc_find(area, n_blocks, long_lived, collected || collected_young);
+            if (found_block != (size_t)-1) {
+                break;
+            }
+            #if MICROPY_GC_INCREMENTAL
+            if (gc_area_sweep_pending(area)) {
+                // sweep just enough of the area to satisfy this allocation and try it again
+                GC_EXIT();
+                gc_sweep_incremental(area, MP_STATE_MEM(gc_step_budget_us), n_blocks);
+                GC_ENTER();
+                continue;
+            }
+            #endif
+            area = gc_alloc_next_area(area, large);
         }
-        if (n_free >= n_blocks) {
+        if (area != NULL) {
             break;
         }
 
         GC_EXIT();
         // nothing found!
+        #if MICROPY_GC_DEFER_FINALISERS
+        if (gc_finalisers_pending()) {
+            // free some objects that are waiting for their finaliser and try again
+            gc_run_finalisers(MICROPY_GC_FINALISER_BATCH);
+            GC_ENTER();
+            continue;
+        }
+        #endif
+        #if MICROPY_GC_SLAB
+        GC_ENTER();
+        bool flushed = false;
+        for (area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+            if (gc_slab_flush(area)) {
+                flushed = true;
+            }
+        }
+        if (flushed) {
+            // the objects held for reuse may make up the run we need
+            continue;
+        }
+        GC_EXIT();
+        #endif
         if (collected) {
             return NULL;
         }
         DEBUG_printf("gc_alloc(" UINT_FMT "): no free mem, triggering GC\n", n_bytes);
+        #if MICROPY_GC_GENERATIONAL
+        if (!collected_young) {
+            // try a minor collection first, then a major one if it didn't free enough
+            collected_young = true;
+            gc_collect_young();
+            GC_ENTER();
+            continue;
+        }
+        #endif
         gc_collect();
         collected = true;
         // Try again since we've hopefully freed up space.
-        keep_looking = true;
         GC_ENTER();
     }
     assert(found_block != 0xffffffff);
@@ -579,47 +1489,76 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
     // Also, set last free ATB index to block after last block we found, for start of
     // next scan. Also, whenever we free or shrink a block we must check if this index needs
     // adjusting (see gc_realloc and gc_free).
+    #if MICROPY_GC_SLAB
+    if (from_slab) {
+        start_block = found_block;
+        end_block = found_block + n_blocks - 1;
+    } else
+    #endif
     if (!long_lived) {
         end_block = found_block;
-        start_block = found_block - n_free + 1;
+        start_block = found_block - n_blocks + 1;
         if (n_blocks < MICROPY_ATB_INDICES) {
             size_t next_free_atb = (found_block + n_blocks) / BLOCKS_PER_ATB;
             // Update all atb indices for larger blocks too.
             for (size_t i = n_blocks - 1; i < MICROPY_ATB_INDICES; i++) {
-                MP_STATE_MEM(gc_first_free_atb_index)[i] = next_free_atb;
+                area->gc_first_free_atb_index[i] = next_free_atb;
             }
         }
     } else {
         start_block = found_block;
-        end_block = found_block + n_free - 1;
+        end_block = found_block + n_blocks - 1;
         // Always update the bounds of the long lived area because we assume it is contiguous. (It
         // can still be reset by a sweep.)
-        MP_STATE_MEM(gc_last_free_atb_index) = (found_block - 1) / BLOCKS_PER_ATB;
+        area->gc_last_free_atb_index = (found_block - 1) / BLOCKS_PER_ATB;
     }
 
     #ifdef LOG_HEAP_ACTIVITY
     gc_log_change(start_block, end_block - start_block + 1);
     #endif
 
-    // mark first block as used head
-    ATB_FREE_TO_HEAD(start_block);
+    // an object from a slab free list is still allocated in the ATB
+    if (!from_slab) {
+        // mark first block as used head
+        ATB_FREE_TO_HEAD(area, start_block);
+        #if MICROPY_GC_INCREMENTAL
+        if (start_block >= area->gc_sweep.block) {
+            // a pending sweep hasn't got here yet, so mark the block to keep it
+            ATB_HEAD_TO_MARK(area, start_block);
+        } else if (end_block >= area->gc_sweep.block) {
+            // the sweep will resume on one of our tail blocks, which belong to a live head
+            area->gc_sweep.free_tail = false;
+        }
+        #endif
+
+        // mark rest of blocks as used tail
+        // TODO for a run of many blocks can make this more efficient
+        for (size_t bl = start_block + 1; bl <= end_block; bl++) {
+            ATB_FREE_TO_TAIL(area, bl);
+        }
+    }
 
-    // mark rest of blocks as used tail
-    // TODO for a run of many blocks can make this more efficient
-    for (size_t bl = start_block + 1; bl <= end_block; bl++) {
-        ATB_FREE_TO_TAIL(bl);
+    #if MICROPY_GC_GENERATIONAL
+    if (long_lived) {
+        // objects in the long-lived end of the heap are old from the start
+        AGE_SET(area, start_block, AGE_OLD);
+        ATB_HEAD_TO_MARK(area, start_block);
+    } else {
+        AGE_SET(area, start_block, 0);
+        gc_note_young(area, start_block);
     }
+    #endif
 
     // get pointer to first block
     // we must create this pointer before unlocking the GC so a collection can find it
-    void *ret_ptr = (void*)(MP_STATE_MEM(gc_pool_start) + start_block * BYTES_PER_BLOCK);
+    void *ret_ptr = (void*)(area->gc_pool_start + start_block * BYTES_PER_BLOCK);
     DEBUG_printf("gc_alloc(%p)\n", ret_ptr);
 
     // If the allocation was long live then update the lowest value. Its used to trigger early
     // collects when allocations fail in their respective section. Its also used to ignore calls to
     // gc_make_long_lived where the pointer is already in the long lived section.
-    if (long_lived && ret_ptr < MP_STATE_MEM(gc_lowest_long_lived_ptr)) {
-        MP_STATE_MEM(gc_lowest_long_lived_ptr) = ret_ptr;
+    if (long_lived && ret_ptr < area->gc_lowest_long_lived_ptr) {
+        area->gc_lowest_long_lived_ptr = ret_ptr;
     }
 
     #if MICROPY_GC_ALLOC_THRESHOLD
@@ -646,7 +1585,7 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
         ((mp_obj_base_t*)ret_ptr)->type = NULL;
         // set mp_obj flag only if it has a finaliser
         GC_ENTER();
-        FTB_SET(start_block);
+        FTB_SET(area, start_block);
         GC_EXIT();
     }
     #else
@@ -689,16 +1628,30 @@ void gc_free(void *ptr) {
     if (ptr == NULL) {
         GC_EXIT();
     } else {
-        if (MP_STATE_MEM(gc_pool_start) == 0) {
+        if (MP_STATE_MEM(area).gc_pool_start == 0) {
             reset_into_safe_mode(GC_ALLOC_OUTSIDE_VM);
         }
         // get the GC block number corresponding to this pointer
-        assert(VERIFY_PTR(ptr));
-        size_t start_block = BLOCK_FROM_PTR(ptr);
-        assert(ATB_GET_KIND(start_block) == AT_HEAD);
+        mp_state_mem_area_t *area = gc_get_ptr_area(ptr);
+        assert(area != NULL);
+        size_t start_block = BLOCK_FROM_PTR(area, ptr);
+        assert(ATB_KIND_IS_HEAD(ATB_GET_KIND(area, start_block)));
 
         #if MICROPY_ENABLE_FINALISER
-        FTB_CLEAR(start_block);
+        FTB_CLEAR(area, start_block);
+        #endif
+
+        #if MICROPY_GC_SLAB
+        // keep a small object for reuse, unless a pending sweep has yet to reach it
+        #if MICROPY_GC_INCREMENTAL
+        bool can_take = start_block < area->gc_sweep.block;
+        #else
+        bool can_take = true;
+        #endif
+        if (can_take && gc_slab_take(area, start_block) != 0) {
+            GC_EXIT();
+            return;
+        }
         #endif
 
         // free head and all of its tail blocks
@@ -707,9 +1660,9 @@ void gc_free(void *ptr) {
         #endif
         size_t block = start_block;
         do {
-            ATB_ANY_TO_FREE(block);
+            ATB_ANY_TO_FREE(area, block);
             block += 1;
-        } while (ATB_GET_KIND(block) == AT_TAIL);
+        } while (ATB_GET_KIND(area, block) == AT_TAIL);
 
         // Update the first free pointer for our size only. Not much calls gc_free directly so there
         // is decent chance we'll want to allocate this size again. By only updating the specific
@@ -717,12 +1670,12 @@ void gc_free(void *ptr) {
         size_t n_blocks = block - start_block;
         size_t bucket = MIN(n_blocks, MICROPY_ATB_INDICES) - 1;
         size_t new_free_atb = start_block / BLOCKS_PER_ATB;
-        if (new_free_atb < MP_STATE_MEM(gc_first_free_atb_index)[bucket]) {
-            MP_STATE_MEM(gc_first_free_atb_index)[bucket] = new_free_atb;
+        if (new_free_atb < area->gc_first_free_atb_index[bucket]) {
+            area->gc_first_free_atb_index[bucket] = new_free_atb;
         }
         // set the last_free pointer to this block if it's earlier in the heap
-        if (new_free_atb > MP_STATE_MEM(gc_last_free_atb_index)) {
-            MP_STATE_MEM(gc_last_free_atb_index) = new_free_atb;
+        if (new_free_atb > area->gc_last_free_atb_index) {
+            area->gc_last_free_atb_index = new_free_atb;
         }
 
         GC_EXIT();
@@ -735,14 +1688,15 @@ void gc_free(void *ptr) {
 
 size_t gc_nbytes(const void *ptr) {
     GC_ENTER();
-    if (VERIFY_PTR(ptr)) {
-        size_t block = BLOCK_FROM_PTR(ptr);
-        if (ATB_GET_KIND(block) == AT_HEAD) {
+    mp_state_mem_area_t *area = gc_get_ptr_area(ptr);
+    if (area != NULL) {
+        size_t block = BLOCK_FROM_PTR(area, ptr);
+        if (ATB_KIND_IS_HEAD(ATB_GET_KIND(area, block))) {
             // work out number of consecutive blocks in the chain starting with this on
             size_t n_blocks = 0;
             do {
                 n_blocks += 1;
-            } while (ATB_GET_KIND(block + n_blocks) == AT_TAIL);
+            } while (ATB_GET_KIND(area, block + n_blocks) == AT_TAIL);
             GC_EXIT();
             return n_blocks * BYTES_PER_BLOCK;
         }
@@ -756,8 +1710,9 @@ size_t gc_nbytes(const void *ptr) {
 bool gc_has_finaliser(const void *ptr) {
 #if MICROPY_ENABLE_FINALISER
     GC_ENTER();
-    if (VERIFY_PTR(ptr)) {
-        bool has_finaliser = FTB_GET(BLOCK_FROM_PTR(ptr));
+    mp_state_mem_area_t *area = gc_get_ptr_area(ptr);
+    if (area != NULL) {
+        bool has_finaliser = FTB_GET(area, BLOCK_FROM_PTR(area, ptr));
         GC_EXIT();
         return has_finaliser;
     }
@@ -772,7 +1727,8 @@ bool gc_has_finaliser(const void *ptr) {
 
 void *gc_make_long_lived(void *old_ptr) {
     // If its already in the long lived section then don't bother moving it.
-    if (old_ptr >= MP_STATE_MEM(gc_lowest_long_lived_ptr)) {
+    mp_state_mem_area_t *area = gc_get_ptr_area(old_ptr);
+    if (area == NULL || old_ptr >= area->gc_lowest_long_lived_ptr) {
         return old_ptr;
     }
     size_t n_bytes = gc_nbytes(old_ptr);
@@ -785,7 +1741,7 @@ void *gc_make_long_lived(void *old_ptr) {
     void* new_ptr = gc_alloc(n_bytes, has_finaliser, true);
     if (new_ptr == NULL) {
         return old_ptr;
-    } else if (old_ptr > new_ptr) {
+    } else if (gc_get_ptr_area(new_ptr) == area && old_ptr > new_ptr) {
         // Return the old pointer if the new one is lower in the heap and free the new space.
         gc_free(new_ptr);
         return old_ptr;
@@ -848,9 +1804,10 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     }
 
     // get the GC block number corresponding to this pointer
-    assert(VERIFY_PTR(ptr));
-    size_t block = BLOCK_FROM_PTR(ptr);
-    assert(ATB_GET_KIND(block) == AT_HEAD);
+    mp_state_mem_area_t *area = gc_get_ptr_area(ptr);
+    assert(area != NULL);
+    size_t block = BLOCK_FROM_PTR(area, ptr);
+    assert(ATB_KIND_IS_HEAD(ATB_GET_KIND(area, block)));
 
     // compute number of new blocks that are requested
     size_t new_blocks = (n_bytes + BYTES_PER_BLOCK - 1) / BYTES_PER_BLOCK;
@@ -863,10 +1820,11 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     // efficiently shrink it (see below for shrinking code).
     size_t n_free   = 0;
     size_t n_blocks = 1; // counting HEAD block
-    size_t max_block = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    size_t max_block = AREA_BLOCKS(area);
     for (size_t bl = block + n_blocks; bl < max_block; bl++) {
-        byte block_type = ATB_GET_KIND(bl);
-        if (block_type == AT_TAIL) {
+        byte block_type = ATB_GET_KIND(area, bl);
+        if (block_type == AT_TAIL && n_free == 0) {
+            // (a tail after free blocks is a dead object the incremental sweep hasn't reached)
             n_blocks++;
             continue;
         }
@@ -891,17 +1849,17 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     if (new_blocks < n_blocks) {
         // free unneeded tail blocks
         for (size_t bl = block + new_blocks, count = n_blocks - new_blocks; count > 0; bl++, count--) {
-            ATB_ANY_TO_FREE(bl);
+            ATB_ANY_TO_FREE(area, bl);
         }
 
         // set the last_free pointer to end of this block if it's earlier in the heap
         size_t new_free_atb = (block + new_blocks) / BLOCKS_PER_ATB;
         size_t bucket = MIN(n_blocks - new_blocks, MICROPY_ATB_INDICES) - 1;
-        if (new_free_atb < MP_STATE_MEM(gc_first_free_atb_index)[bucket]) {
-            MP_STATE_MEM(gc_first_free_atb_index)[bucket] = new_free_atb;
+        if (new_free_atb < area->gc_first_free_atb_index[bucket]) {
+            area->gc_first_free_atb_index[bucket] = new_free_atb;
         }
-        if (new_free_atb > MP_STATE_MEM(gc_last_free_atb_index)) {
-            MP_STATE_MEM(gc_last_free_atb_index) = new_free_atb;
+        if (new_free_atb > area->gc_last_free_atb_index) {
+            area->gc_last_free_atb_index = new_free_atb;
         }
 
         GC_EXIT();
@@ -925,9 +1883,15 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     if (new_blocks <= n_blocks + n_free) {
         // mark few more blocks as used tail
         for (size_t bl = block + n_blocks; bl < block + new_blocks; bl++) {
-            assert(ATB_GET_KIND(bl) == AT_FREE);
-            ATB_FREE_TO_TAIL(bl);
+            assert(ATB_GET_KIND(area, bl) == AT_FREE);
+            ATB_FREE_TO_TAIL(area, bl);
+        }
+        #if MICROPY_GC_INCREMENTAL
+        if (block < area->gc_sweep.block && block + new_blocks > area->gc_sweep.block) {
+            // the sweep will resume on one of our tail blocks (see gc_alloc)
+            area->gc_sweep.free_tail = false;
         }
+        #endif
 
         GC_EXIT();
 
@@ -955,7 +1919,7 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     }
 
     #if MICROPY_ENABLE_FINALISER
-    bool ftb_state = FTB_GET(block);
+    bool ftb_state = FTB_GET(area, block);
     #else
     bool ftb_state = false;
     #endif
@@ -1024,113 +1988,115 @@ void gc_dump_info(void) {
 void gc_dump_alloc_table(void) {
     GC_ENTER();
     static const size_t DUMP_BYTES_PER_LINE = 64;
-    #if !EXTENSIVE_HEAP_PROFILING
-    // When comparing heap output we don't want to print the starting
-    // pointer of the heap because it changes from run to run.
-    mp_printf(&mp_plat_print, "GC memory layout; from %p:", MP_STATE_MEM(gc_pool_start));
-    #endif
-    for (size_t bl = 0; bl < MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB; bl++) {
-        if (bl % DUMP_BYTES_PER_LINE == 0) {
-            // a new line of blocks
-            {
-                // check if this line contains only free blocks
-                size_t bl2 = bl;
-                while (bl2 < MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB && ATB_GET_KIND(bl2) == AT_FREE) {
-                    bl2++;
-                }
-                if (bl2 - bl >= 2 * DUMP_BYTES_PER_LINE) {
-                    // there are at least 2 lines containing only free blocks, so abbreviate their printing
-                    mp_printf(&mp_plat_print, "\n       (%u lines all free)", (uint)(bl2 - bl) / DUMP_BYTES_PER_LINE);
-                    bl = bl2 & (~(DUMP_BYTES_PER_LINE - 1));
-                    if (bl >= MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB) {
-                        // got to end of heap
-                        break;
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        #if !EXTENSIVE_HEAP_PROFILING
+        // When comparing heap output we don't want to print the starting
+        // pointer of the heap because it changes from run to run.
+        mp_printf(&mp_plat_print, "GC memory layout; from %p:", area->gc_pool_start);
+        #endif
+        for (size_t bl = 0; bl < AREA_BLOCKS(area); bl++) {
+            if (bl % DUMP_BYTES_PER_LINE == 0) {
+                // a new line of blocks
+                {
+                    // check if this line contains only free blocks
+                    size_t bl2 = bl;
+                    while (bl2 < AREA_BLOCKS(area) && ATB_GET_KIND(area, bl2) == AT_FREE) {
+                        bl2++;
                     }
-                }
-            }
-            // print header for new line of blocks
-            // (the cast to uint32_t is for 16-bit ports)
-            //mp_printf(&mp_plat_print, "\n%05x: ", (uint)(PTR_FROM_BLOCK(bl) & (uint32_t)0xfffff));
-            mp_printf(&mp_plat_print, "\n%05x: ", (uint)((bl * BYTES_PER_BLOCK) & (uint32_t)0xfffff));
-        }
-        int c = ' ';
-        switch (ATB_GET_KIND(bl)) {
-            case AT_FREE: c = '.'; break;
-            /* this prints out if the object is reachable from BSS or STACK (for unix only)
-            case AT_HEAD: {
-                c = 'h';
-                void **ptrs = (void**)(void*)&mp_state_ctx;
-                mp_uint_t len = offsetof(mp_state_ctx_t, vm.stack_top) / sizeof(mp_uint_t);
-                for (mp_uint_t i = 0; i < len; i++) {
-                    mp_uint_t ptr = (mp_uint_t)ptrs[i];
-                    if (VERIFY_PTR(ptr) && BLOCK_FROM_PTR(ptr) == bl) {
-                        c = 'B';
-                        break;
+                    if (bl2 - bl >= 2 * DUMP_BYTES_PER_LINE) {
+                        // there are at least 2 lines containing only free blocks, so abbreviate their printing
+                        mp_printf(&mp_plat_print, "\n       (%u lines all free)", (uint)(bl2 - bl) / DUMP_BYTES_PER_LINE);
+                        bl = bl2 & (~(DUMP_BYTES_PER_LINE - 1));
+                        if (bl >= AREA_BLOCKS(area)) {
+                            // got to end of heap
+                            break;
+                        }
                     }
                 }
-                if (c == 'h') {
-                    ptrs = (void**)&c;
-                    len = ((mp_uint_t)MP_STATE_THREAD(stack_top) - (mp_uint_t)&c) / sizeof(mp_uint_t);
+                // print header for new line of blocks
+                // (the cast to uint32_t is for 16-bit ports)
+                //mp_printf(&mp_plat_print, "\n%05x: ", (uint)(PTR_FROM_BLOCK(area, bl) & (uint32_t)0xfffff));
+                mp_printf(&mp_plat_print, "\n%05x: ", (uint)((bl * BYTES_PER_BLOCK) & (uint32_t)0xfffff));
+            }
+            int c = ' ';
+            switch (ATB_GET_KIND(area, bl)) {
+                case AT_FREE: c = '.'; break;
+                /* this prints out if the object is reachable from BSS or STACK (for unix only)
+                case AT_HEAD: {
+                    c = 'h';
+                    void **ptrs = (void**)(void*)&mp_state_ctx;
+                    mp_uint_t len = offsetof(mp_state_ctx_t, vm.stack_top) / sizeof(mp_uint_t);
                     for (mp_uint_t i = 0; i < len; i++) {
                         mp_uint_t ptr = (mp_uint_t)ptrs[i];
-                        if (VERIFY_PTR(ptr) && BLOCK_FROM_PTR(ptr) == bl) {
-                            c = 'S';
+                        if (VERIFY_PTR(ptr) && BLOCK_FROM_PTR(area, ptr) == bl) {
+                            c = 'B';
                             break;
                         }
                     }
+                    if (c == 'h') {
+                        ptrs = (void**)&c;
+                        len = ((mp_uint_t)MP_STATE_THREAD(stack_top) - (mp_uint_t)&c) / sizeof(mp_uint_t);
+                        for (mp_uint_t i = 0; i < len; i++) {
+                            mp_uint_t ptr = (mp_uint_t)ptrs[i];
+                            if (VERIFY_PTR(ptr) && BLOCK_FROM_PTR(area, ptr) == bl) {
+                                c = 'S';
+                                break;
+                            }
+                        }
+                    }
+                    break;
                 }
-                break;
-            }
-            */
-            /* this prints the uPy object type of the head block */
-            case AT_HEAD: {
+                */
+                /* this prints the uPy object type of the head block */
+                case AT_HEAD: {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wcast-align"
-                void **ptr = (void**)(MP_STATE_MEM(gc_pool_start) + bl * BYTES_PER_BLOCK);
+                    void **ptr = (void**)(area->gc_pool_start + bl * BYTES_PER_BLOCK);
 #pragma GCC diagnostic pop
-                if (*ptr == &mp_type_tuple) { c = 'T'; }
-                else if (*ptr == &mp_type_list) { c = 'L'; }
-                else if (*ptr == &mp_type_dict) { c = 'D'; }
-                else if (*ptr == &mp_type_str || *ptr == &mp_type_bytes) { c = 'S'; }
-                #if MICROPY_PY_BUILTINS_BYTEARRAY
-                else if (*ptr == &mp_type_bytearray) { c = 'A'; }
-                #endif
-                #if MICROPY_PY_ARRAY
-                else if (*ptr == &mp_type_array) { c = 'A'; }
-                #endif
-                #if MICROPY_PY_BUILTINS_FLOAT
-                else if (*ptr == &mp_type_float) { c = 'F'; }
-                #endif
-                else if (*ptr == &mp_type_fun_bc) { c = 'B'; }
-                else if (*ptr == &mp_type_module) { c = 'M'; }
-                else {
-                    c = 'h';
-                    #if 0
-                    // This code prints "Q" for qstr-pool data, and "q" for qstr-str
-                    // data.  It can be useful to see how qstrs are being allocated,
-                    // but is disabled by default because it is very slow.
-                    for (qstr_pool_t *pool = MP_STATE_VM(last_pool); c == 'h' && pool != NULL; pool = pool->prev) {
-                        if ((qstr_pool_t*)ptr == pool) {
-                            c = 'Q';
-                            break;
-                        }
-                        for (const byte **q = pool->qstrs, **q_top = pool->qstrs + pool->len; q < q_top; q++) {
-                            if ((const byte*)ptr == *q) {
-                                c = 'q';
+                    if (*ptr == &mp_type_tuple) { c = 'T'; }
+                    else if (*ptr == &mp_type_list) { c = 'L'; }
+                    else if (*ptr == &mp_type_dict) { c = 'D'; }
+                    else if (*ptr == &mp_type_str || *ptr == &mp_type_bytes) { c = 'S'; }
+                    #if MICROPY_PY_BUILTINS_BYTEARRAY
+                    else if (*ptr == &mp_type_bytearray) { c = 'A'; }
+                    #endif
+                    #if MICROPY_PY_ARRAY
+                    else if (*ptr == &mp_type_array) { c = 'A'; }
+                    #endif
+                    #if MICROPY_PY_BUILTINS_FLOAT
+                    else if (*ptr == &mp_type_float) { c = 'F'; }
+                    #endif
+                    else if (*ptr == &mp_type_fun_bc) { c = 'B'; }
+                    else if (*ptr == &mp_type_module) { c = 'M'; }
+                    else {
+                        c = 'h';
+                        #if 0
+                        // This code prints "Q" for qstr-pool data, and "q" for qstr-str
+                        // data.  It can be useful to see how qstrs are being allocated,
+                        // but is disabled by default because it is very slow.
+                        for (qstr_pool_t *pool = MP_STATE_VM(last_pool); c == 'h' && pool != NULL; pool = pool->prev) {
+                            if ((qstr_pool_t*)ptr == pool) {
+                                c = 'Q';
                                 break;
                             }
+                            for (const byte **q = pool->qstrs, **q_top = pool->qstrs + pool->len; q < q_top; q++) {
+                                if ((const byte*)ptr == *q) {
+                                    c = 'q';
+                                    break;
+                                }
+                            }
                         }
+                        #endif
                     }
-                    #endif
+                    break;
                 }
-                break;
+                case AT_TAIL: c = '='; break;
+                case AT_MARK: c = 'm'; break;
             }
-            case AT_TAIL: c = '='; break;
-            case AT_MARK: c = 'm'; break;
+            mp_printf(&mp_plat_print, "%c", c);
         }
-        mp_printf(&mp_plat_print, "%c", c);
+        mp_print_str(&mp_plat_print, "\n");
     }
-    mp_print_str(&mp_plat_print, "\n");
     GC_EXIT();
 }
 
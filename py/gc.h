@@ -35,16 +35,29 @@
 #define WORDS_PER_BLOCK ((MICROPY_BYTES_PER_GC_BLOCK) / BYTES_PER_WORD)
 #define BYTES_PER_BLOCK (MICROPY_BYTES_PER_GC_BLOCK)
 
+#if MICROPY_GC_SPLIT_HEAP
+// ptr should be of type void*
+#define VERIFY_PTR(ptr) (gc_get_ptr_area(ptr) != NULL)
+#else
 // ptr should be of type void*
 #define VERIFY_PTR(ptr) ( \
         ((uintptr_t)(ptr) & (BYTES_PER_BLOCK - 1)) == 0      /* must be aligned on a block */ \
-        && ptr >= (void*)MP_STATE_MEM(gc_pool_start)     /* must be above start of pool */ \
-        && ptr < (void*)MP_STATE_MEM(gc_pool_end)        /* must be below end of pool */ \
+        && ptr >= (void*)MP_STATE_MEM(area).gc_pool_start     /* must be above start of pool */ \
+        && ptr < (void*)MP_STATE_MEM(area).gc_pool_end        /* must be below end of pool */ \
     )
+#endif
 
 void gc_init(void *start, void *end);
 void gc_deinit(void);
 
+#if MICROPY_GC_SPLIT_HEAP
+// Add the memory from start to end to the heap, as an area for large objects.
+void gc_add(void *start, void *end);
+
+// The area holding the block that ptr points to the start of, or NULL.
+mp_state_mem_area_t *gc_get_ptr_area(const void *ptr);
+#endif
+
 // These lock/unlock functions can be nested.
 // They can be used to prevent the GC from allocating/freeing.
 void gc_lock(void);
@@ -58,6 +71,11 @@ void gc_collect_ptr(void *ptr);
 void gc_collect_root(void **ptrs, size_t len);
 void gc_collect_end(void);
 
+#if MICROPY_GC_GENERATIONAL
+// Run a minor collection, or a major one if that is due.
+void gc_collect_young(void);
+#endif
+
 // Is the gc heap available?
 bool gc_alloc_possible(void);
 void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived);
@@ -65,6 +83,21 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived);
 // Use this function to sweep the whole heap and run all finalisers
 void gc_sweep_all(void);
 
+#if MICROPY_GC_INCREMENTAL
+// Whether an incremental sweep is in progress, and functions to do the next
+// bounded step of it, or to complete it.
+bool gc_sweep_pending(void);
+void gc_sweep_step(void);
+void gc_sweep_finish(void);
+#endif
+
+#if MICROPY_GC_DEFER_FINALISERS
+// Number of unreachable objects waiting for their finaliser, and a function
+// to run the finalisers of (and free) up to max_count of them.
+size_t gc_finalisers_pending(void);
+void gc_run_finalisers(size_t max_count);
+#endif
+
 void gc_free(void *ptr); // does not call finaliser
 size_t gc_nbytes(const void *ptr);
 bool gc_has_finaliser(const void *ptr);
@@ -86,6 +119,11 @@ typedef struct _gc_info_t {
 } gc_info_t;
 
 void gc_info(gc_info_t *info);
+#if MICROPY_GC_SPLIT_HEAP
+// Like gc_info, for the area with the given index (0 is the gc_init area).
+// Returns false if there is no such area.
+bool gc_area_info(size_t index, gc_info_t *info, void **start);
+#endif
 void gc_dump_info(void);
 void gc_dump_alloc_table(void);
 
@@ -42,6 +42,14 @@
 #define DEBUG_printf(...) (void)0
 #endif
 
+#if MICROPY_OPT_MAP_LOOKUP_CACHE
+// The cache slot for a key, ignoring the low bits that hold the object tag.
+#define MAP_CACHE_ENTRY(index) (MP_STATE_VM(map_lookup_cache)[(((uintptr_t)(index)) >> 2) % MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE])
+#define MAP_CACHE_SET(index, pos) (MAP_CACHE_ENTRY(index) = (pos) & 0xff)
+#else
+#define MAP_CACHE_SET(index, pos)
+#endif
+
 // Fixed empty map. Useful when need to call kw-receiving functions
 // without any keywords from C, etc.
 const mp_map_t mp_const_empty_map = {
@@ -149,6 +157,17 @@ mp_map_elem_t *PLACE_IN_ITCM(mp_map_lookup)(mp_map_t *map, mp_obj_t index, mp_ma
     // If the map is a fixed array then we must only be called for a lookup
     assert(!map->is_fixed || lookup_kind == MP_MAP_LOOKUP);
 
+    #if MICROPY_OPT_MAP_LOOKUP_CACHE
+    // Try the position this key was last found at.  A miss (including a key
+    // that is equal but not identical) falls through to the full search.
+    if (lookup_kind != MP_MAP_LOOKUP_REMOVE_IF_FOUND && map->alloc != 0) {
+        mp_map_elem_t *slot = &map->table[MAP_CACHE_ENTRY(index) % map->alloc];
+        if (slot->key == index) {
+            return slot;
+        }
+    }
+    #endif
+
     // Work out if we can compare just pointers
     bool compare_only_ptrs = map->all_keys_are_qstrs;
     if (compare_only_ptrs) {
@@ -182,8 +201,10 @@ mp_map_elem_t *PLACE_IN_ITCM(mp_map_lookup)(mp_map_t *map, mp_obj_t index, mp_ma
                     elem = &map->table[map->used];
                     elem->key = MP_OBJ_NULL;
                     elem->value = value;
+                    return elem;
                 }
                 #endif
+                MAP_CACHE_SET(index, elem - map->table);
                 return elem;
             }
         }
@@ -265,6 +286,8 @@ mp_map_elem_t *PLACE_IN_ITCM(mp_map_lookup)(mp_map_t *map, mp_obj_t index, mp_ma
                     slot->key = MP_OBJ_SENTINEL;
                 }
                 // keep slot->value so that caller can access it if needed
+            } else {
+                MAP_CACHE_SET(index, pos);
             }
             return slot;
         }
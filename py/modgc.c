@@ -30,16 +30,34 @@
 
 #if MICROPY_PY_GC && MICROPY_ENABLE_GC
 
-// collect(): run a garbage collection
-STATIC mp_obj_t py_gc_collect(void) {
-    gc_collect();
+// collect([generation]): run a garbage collection, a minor one if
+// generation is 0 and generational collection is enabled
+STATIC mp_obj_t py_gc_collect(size_t n_args, const mp_obj_t *args) {
+    #if MICROPY_GC_GENERATIONAL
+    if (n_args > 0 && mp_obj_get_int(args[0]) == 0) {
+        gc_collect_young();
+    } else
+    #else
+    (void)n_args;
+    (void)args;
+    #endif
+    {
+        gc_collect();
+    }
+    #if MICROPY_GC_INCREMENTAL
+    // an explicit collection frees everything it can straight away
+    gc_sweep_finish();
+    #endif
+    #if MICROPY_GC_DEFER_FINALISERS
+    gc_run_finalisers((size_t)-1);
+    #endif
 #if MICROPY_PY_GC_COLLECT_RETVAL
     return MP_OBJ_NEW_SMALL_INT(MP_STATE_MEM(gc_collected));
 #else
     return mp_const_none;
 #endif
 }
-MP_DEFINE_CONST_FUN_OBJ_0(gc_collect_obj, py_gc_collect);
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_collect_obj, 0, 1, py_gc_collect);
 
 // disable(): disable the garbage collector
 STATIC mp_obj_t gc_disable(void) {
@@ -95,6 +113,98 @@ STATIC mp_obj_t gc_threshold(size_t n_args, const mp_obj_t *args) {
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_threshold_obj, 0, 1, gc_threshold);
 #endif
 
+#if MICROPY_GC_INCREMENTAL
+// incremental([budget_us]): get or set the time budget of an incremental
+// sweep step; 0 means collections sweep the whole heap at once
+STATIC mp_obj_t gc_incremental(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 0) {
+        return mp_obj_new_int_from_uint(MP_STATE_MEM(gc_step_budget_us));
+    }
+    mp_int_t val = mp_obj_get_int(args[0]);
+    if (val <= 0) {
+        val = 0;
+        gc_sweep_finish();
+        #if MICROPY_GC_DEFER_FINALISERS
+        gc_run_finalisers((size_t)-1);
+        #endif
+    }
+    MP_STATE_MEM(gc_step_budget_us) = val;
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_incremental_obj, 0, 1, gc_incremental);
+
+// pause_stats([reset]): return (count, total_us, max_us, recent) for the
+// pauses caused by the GC, where recent is a list of the latest pause times
+STATIC mp_obj_t gc_pause_stats(size_t n_args, const mp_obj_t *args) {
+    size_t count = MP_STATE_MEM(gc_pause_count);
+    size_t n_recent = MIN(count, MICROPY_GC_PAUSE_LOG_LEN);
+    mp_obj_t recent = mp_obj_new_list(n_recent, NULL);
+    for (size_t i = 0; i < n_recent; i++) {
+        size_t idx = (count - n_recent + i) % MICROPY_GC_PAUSE_LOG_LEN;
+        mp_obj_list_store(recent, MP_OBJ_NEW_SMALL_INT(i), mp_obj_new_int_from_uint(MP_STATE_MEM(gc_pause_log)[idx]));
+    }
+    mp_obj_t items[4] = {
+        mp_obj_new_int_from_uint(count),
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_pause_total_us)),
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_pause_max_us)),
+        recent,
+    };
+    if (n_args > 0 && mp_obj_is_true(args[0])) {
+        MP_STATE_MEM(gc_pause_count) = 0;
+        MP_STATE_MEM(gc_pause_total_us) = 0;
+        MP_STATE_MEM(gc_pause_max_us) = 0;
+    }
+    return mp_obj_new_tuple(4, items);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_pause_stats_obj, 0, 1, gc_pause_stats);
+#endif
+
+#if MICROPY_GC_GENERATIONAL
+// generational([n]): get or set the number of minor collections that may be
+// run in a row before a major one; 0 means every collection is a major one
+STATIC mp_obj_t gc_generational(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 0) {
+        return MP_OBJ_NEW_SMALL_INT(MP_STATE_MEM(gc_minor_max));
+    }
+    mp_int_t val = mp_obj_get_int(args[0]);
+    MP_STATE_MEM(gc_minor_max) = MAX(0, MIN(val, 0xffff));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_generational_obj, 0, 1, gc_generational);
+#endif
+
+#if MICROPY_GC_SPLIT_HEAP
+// large_threshold([n]): get or set the size in bytes from which allocations
+// try the areas for large objects first; 0 means all allocations try the
+// first area first
+STATIC mp_obj_t gc_large_threshold(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 0) {
+        return mp_obj_new_int_from_uint(MP_STATE_MEM(gc_large_threshold));
+    }
+    mp_int_t val = mp_obj_get_int(args[0]);
+    MP_STATE_MEM(gc_large_threshold) = MAX(0, val);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_large_threshold_obj, 0, 1, gc_large_threshold);
+
+// mem_areas(): return a list of (start address, total, free) for each heap area
+STATIC mp_obj_t gc_mem_areas(void) {
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    gc_info_t info;
+    void *start;
+    for (size_t i = 0; gc_area_info(i, &info, &start); i++) {
+        mp_obj_t items[3] = {
+            mp_obj_new_int_from_uint((uintptr_t)start),
+            mp_obj_new_int_from_uint(info.total),
+            mp_obj_new_int_from_uint(info.free),
+        };
+        mp_obj_list_append(list, mp_obj_new_tuple(3, items));
+    }
+    return list;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(gc_mem_areas_obj, gc_mem_areas);
+#endif
+
 STATIC const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_gc) },
     { MP_ROM_QSTR(MP_QSTR_collect), MP_ROM_PTR(&gc_collect_obj) },
@@ -106,6 +216,17 @@ STATIC const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     #if MICROPY_GC_ALLOC_THRESHOLD
     { MP_ROM_QSTR(MP_QSTR_threshold), MP_ROM_PTR(&gc_threshold_obj) },
     #endif
+    #if MICROPY_GC_INCREMENTAL
+    { MP_ROM_QSTR(MP_QSTR_incremental), MP_ROM_PTR(&gc_incremental_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pause_stats), MP_ROM_PTR(&gc_pause_stats_obj) },
+    #endif
+    #if MICROPY_GC_GENERATIONAL
+    { MP_ROM_QSTR(MP_QSTR_generational), MP_ROM_PTR(&gc_generational_obj) },
+    #endif
+    #if MICROPY_GC_SPLIT_HEAP
+    { MP_ROM_QSTR(MP_QSTR_large_threshold), MP_ROM_PTR(&gc_large_threshold_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mem_areas), MP_ROM_PTR(&gc_mem_areas_obj) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_gc_globals, mp_module_gc_globals_table);
@@ -127,6 +127,85 @@
 #define MICROPY_GC_ALLOC_THRESHOLD (1)
 #endif
 
+// Support an incremental GC mode, configurable by gc.incremental().  When
+// enabled, a collection triggered by an allocation only runs the mark phase
+// to completion; the sweep is then done in steps of at most
+// MICROPY_GC_STEP_BUDGET_US microseconds from gc_sweep_step(), and lazily by
+// allocations that need more free blocks, so that a single collection doesn't
+// stall the program.  See also MICROPY_GC_FINALISER_QUEUE_LEN.
+// Pause times are recorded and available via gc.pause_stats().
+// Requires MICROPY_GC_TICKS_US(), which defaults to mp_hal_ticks_us().
+#ifndef MICROPY_GC_INCREMENTAL
+#define MICROPY_GC_INCREMENTAL (0)
+#endif
+
+// Default time budget for a single incremental sweep step; 0 disables
+// incremental sweeping until set with gc.incremental().
+#ifndef MICROPY_GC_STEP_BUDGET_US
+#define MICROPY_GC_STEP_BUDGET_US (1000)
+#endif
+
+// Number of recent GC pause times kept for gc.pause_stats().
+#ifndef MICROPY_GC_PAUSE_LOG_LEN
+#define MICROPY_GC_PAUSE_LOG_LEN (32)
+#endif
+
+#ifndef MICROPY_GC_TICKS_US
+#define MICROPY_GC_TICKS_US() mp_hal_ticks_us()
+#endif
+
+// Keep free lists of the small dead objects found by each sweep, one per size
+// of 1 to MICROPY_GC_SLAB_CLASSES blocks, so that the most common allocations
+// reuse them without searching the allocation table.  Each list holds at most
+// MICROPY_GC_SLAB_MAX_LEN objects.  The lists are given back to the heap when
+// an allocation can't otherwise be satisfied, and rebuilt by every collection.
+#ifndef MICROPY_GC_SLAB
+#define MICROPY_GC_SLAB (0)
+#endif
+
+#ifndef MICROPY_GC_SLAB_CLASSES
+#define MICROPY_GC_SLAB_CLASSES (4)
+#endif
+
+#ifndef MICROPY_GC_SLAB_MAX_LEN
+#define MICROPY_GC_SLAB_MAX_LEN (64)
+#endif
+
+// Support generational collection.  Objects that survive
+// MICROPY_GC_GEN_PROMOTE_AGE (1 to 3) collections, and all objects in the
+// long-lived end of the heap, are old.  Collections triggered by an allocation
+// are minor ones, which keep every old object and only trace the young ones,
+// unless MICROPY_GC_GEN_MINOR_MAX minor collections in a row have been run or a
+// minor one didn't free enough; then a major collection of the whole heap is
+// run.  Configurable by gc.generational().  Costs 2 bits of RAM per GC block.
+// Requires MICROPY_GC_INCREMENTAL.
+#ifndef MICROPY_GC_GENERATIONAL
+#define MICROPY_GC_GENERATIONAL (0)
+#endif
+
+#ifndef MICROPY_GC_GEN_PROMOTE_AGE
+#define MICROPY_GC_GEN_PROMOTE_AGE (2)
+#endif
+
+#ifndef MICROPY_GC_GEN_MINOR_MAX
+#define MICROPY_GC_GEN_MINOR_MAX (8)
+#endif
+
+// Support more than one heap area, added after gc_init by gc_add.  Each area
+// has its own allocation tables.  The area given to gc_init is taken to be the
+// fast one (eg internal RAM) and the ones given to gc_add the slow, large ones
+// (eg PSRAM): allocations of at least MICROPY_GC_SPLIT_HEAP_THRESHOLD bytes try
+// the added areas first, and smaller ones try the gc_init area first.  Either
+// falls back to the other areas before a collection is run.  The threshold is
+// configurable by gc.large_threshold(), and 0 turns the placement off.
+#ifndef MICROPY_GC_SPLIT_HEAP
+#define MICROPY_GC_SPLIT_HEAP (0)
+#endif
+
+#ifndef MICROPY_GC_SPLIT_HEAP_THRESHOLD
+#define MICROPY_GC_SPLIT_HEAP_THRESHOLD (1024)
+#endif
+
 // Number of bytes to allocate initially when creating new chunks to store
 // interned string data.  Smaller numbers lead to more chunks being needed
 // and more wastage at the end of the chunk.  Larger numbers lead to wasted
@@ -339,9 +418,11 @@
 #if MICROPY_DYNAMIC_COMPILER
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC (mp_dynamic_compiler.opt_cache_map_lookup_in_bytecode)
 #define MICROPY_PY_BUILTINS_STR_UNICODE_DYNAMIC (mp_dynamic_compiler.py_builtins_str_unicode)
+#define MICROPY_OPT_SUPERINSTRUCTIONS_DYNAMIC (mp_dynamic_compiler.opt_superinstructions)
 #else
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
 #define MICROPY_PY_BUILTINS_STR_UNICODE_DYNAMIC MICROPY_PY_BUILTINS_STR_UNICODE
+#define MICROPY_OPT_SUPERINSTRUCTIONS_DYNAMIC MICROPY_OPT_SUPERINSTRUCTIONS
 #endif
 
 // Whether to enable constant folding; eg 1+2 rewritten as 3
@@ -420,12 +501,103 @@
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (0)
 #endif
 
+// Whether the bytecode emitter fuses common sequences of opcodes (such as
+// LOAD_FAST LOAD_FAST BINARY_OP, LOAD_FAST LOAD_ATTR and a comparison followed
+// by POP_JUMP_IF) into single superinstructions, and the VM executes them.
+// This saves dispatches in hot loops at the cost of a little code ROM.
+// Bytecode and .mpy files using superinstructions need a VM that has them.
+#ifndef MICROPY_OPT_SUPERINSTRUCTIONS
+#define MICROPY_OPT_SUPERINSTRUCTIONS (0)
+#endif
+
+// Whether gc_alloc searches the allocation table 16 blocks at a time, rather
+// than block by block, when looking for free space for short-lived objects.
+#ifndef MICROPY_OPT_GC_ATB_WORD_SCAN
+#define MICROPY_OPT_GC_ATB_WORD_SCAN (0)
+#endif
+
+// Whether to cache where attributes of instances are found in their class or
+// its bases, so that method calls and class attribute loads on instances
+// don't walk the MRO each time.  The cache is direct mapped on (type, attr)
+// and is invalidated as a whole whenever a class dict is changed or a class
+// is created.  Uses about 5 words of RAM per entry.
+#ifndef MICROPY_OPT_TYPE_ATTR_CACHE
+#define MICROPY_OPT_TYPE_ATTR_CACHE (0)
+#endif
+
+// Number of entries in the type attribute cache, must be a power of 2.
+#ifndef MICROPY_OPT_TYPE_ATTR_CACHE_SIZE
+#define MICROPY_OPT_TYPE_ATTR_CACHE_SIZE (32)
+#endif
+
+// Whether instances of classes defined in Python store their members in
+// slots allocated with the instance, named by a "shape" shared with other
+// instances of the class that added the same members in the same order,
+// rather than each in its own hash table.  An instance falls back to a hash
+// table if a member is deleted, if it has a native base class, or if it has
+// more members than MICROPY_OPT_INSTANCE_SHAPES_MAX_LEN.
+#ifndef MICROPY_OPT_INSTANCE_SHAPES
+#define MICROPY_OPT_INSTANCE_SHAPES (0)
+#endif
+
+#ifndef MICROPY_OPT_INSTANCE_SHAPES_MAX_LEN
+#define MICROPY_OPT_INSTANCE_SHAPES_MAX_LEN (16)
+#endif
+
+// Limit on the number of distinct shapes of each class, after which new
+// layouts fall back to a hash table.
+#ifndef MICROPY_OPT_INSTANCE_SHAPES_MAX_PER_CLASS
+#define MICROPY_OPT_INSTANCE_SHAPES_MAX_PER_CLASS (32)
+#endif
+
+// Whether to remember, for each of a small number of recently looked up keys,
+// the position it was last found at in any map.  Looking up the same key
+// again (in the same map, or another map where it sits at the same position)
+// then checks that slot first, skipping the linear search of fixed and
+// ordered maps such as module globals and the locals_dict of native types,
+// and the hashing and probing of other maps.  Uses
+// MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE bytes of RAM.
+#ifndef MICROPY_OPT_MAP_LOOKUP_CACHE
+#define MICROPY_OPT_MAP_LOOKUP_CACHE (0)
+#endif
+
+// Number of entries in the map lookup cache.
+#ifndef MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE
+#define MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE (128)
+#endif
+
+// Whether to keep a hash index of all interned strings so that qstr_find_strn
+// (and hence interning) doesn't linearly scan every qstr pool.  Uses about
+// 2 * sizeof(qstr) bytes of heap per qstr, rounded up to a power of two slots.
+#ifndef MICROPY_OPT_QSTR_HASH_INDEX
+#define MICROPY_OPT_QSTR_HASH_INDEX (0)
+#endif
+
+// Minimum number of slots in the qstr hash index; must be a power of two.
+#ifndef MICROPY_QSTR_HASH_INDEX_MIN
+#define MICROPY_QSTR_HASH_INDEX_MIN (256)
+#endif
+
 // Whether to use fast versions of bitwise operations (and, or, xor) when the
 // arguments are both positive.  Increases Thumb2 code size by about 250 bytes.
 #ifndef MICROPY_OPT_MPZ_BITWISE
 #define MICROPY_OPT_MPZ_BITWISE (0)
 #endif
 
+// Whether to use subquadratic algorithms for big ints: Karatsuba multiplication
+// and squaring above MPZ_KARATSUBA_THRESHOLD digits, and divide-and-conquer
+// conversion between ints and strings.  Adds about 4k of x86-64 code.
+#ifndef MICROPY_OPT_MPZ_KARATSUBA
+#define MICROPY_OPT_MPZ_KARATSUBA (0)
+#endif
+
+// Whether pow(a, b, m) with an odd m uses Montgomery multiplication and a
+// 4-bit exponent window instead of a full division after every multiply.
+// Adds about 1.5k of x86-64 code.
+#ifndef MICROPY_OPT_MPZ_MONTGOMERY
+#define MICROPY_OPT_MPZ_MONTGOMERY (0)
+#endif
+
 /*****************************************************************************/
 /* Python internal features                                                  */
 
@@ -477,6 +649,21 @@
 #define MICROPY_ENABLE_FINALISER (0)
 #endif
 
+// Number of unreachable objects with a finaliser that an incremental
+// collection can queue to be finalised later, in batches of
+// MICROPY_GC_FINALISER_BATCH, instead of calling __del__ for them during the
+// sweep.  Any more are finalised by the (time-bounded) incremental sweep.
+// Only used with MICROPY_GC_INCREMENTAL; 0 disables the queue.
+#ifndef MICROPY_GC_FINALISER_QUEUE_LEN
+#define MICROPY_GC_FINALISER_QUEUE_LEN (32)
+#endif
+
+#ifndef MICROPY_GC_FINALISER_BATCH
+#define MICROPY_GC_FINALISER_BATCH (8)
+#endif
+
+#define MICROPY_GC_DEFER_FINALISERS (MICROPY_GC_INCREMENTAL && MICROPY_ENABLE_FINALISER && MICROPY_GC_FINALISER_QUEUE_LEN > 0)
+
 // Whether to enable a separate allocator for the Python stack.
 // If enabled then the code must call mp_pystack_init before mp_init.
 #ifndef MICROPY_ENABLE_PYSTACK
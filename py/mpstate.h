@@ -46,6 +46,7 @@ typedef struct mp_dynamic_compiler_t {
     uint8_t small_int_bits; // must be <= host small_int_bits
     bool opt_cache_map_lookup_in_bytecode;
     bool py_builtins_str_unicode;
+    bool opt_superinstructions;
 } mp_dynamic_compiler_t;
 extern mp_dynamic_compiler_t mp_dynamic_compiler;
 #endif
@@ -60,12 +61,32 @@ typedef struct _mp_sched_item_t {
     mp_obj_t arg;
 } mp_sched_item_t;
 
-// This structure hold information about the memory allocation system.
-typedef struct _mp_state_mem_t {
-    #if MICROPY_MEM_STATS
-    size_t total_bytes_allocated;
-    size_t current_bytes_allocated;
-    size_t peak_bytes_allocated;
+// An entry of the type attribute cache, see MICROPY_OPT_TYPE_ATTR_CACHE.
+// Looking up attr on an instance of type finds member in found_type.
+typedef struct _mp_type_attr_cache_entry_t {
+    const mp_obj_type_t *type;
+    const mp_obj_type_t *found_type;
+    mp_obj_t member;
+    size_t version;
+    qstr attr;
+} mp_type_attr_cache_entry_t;
+
+// State of a sweep of the GC heap, kept between steps of an incremental sweep.
+// Blocks from block onwards have not been swept yet; block is past the end
+// of the heap when no sweep is pending.
+typedef struct _gc_sweep_state_t {
+    size_t block;
+    size_t run_start;
+    size_t run_len;
+    size_t n_buckets_set;
+    bool free_tail;
+} gc_sweep_state_t;
+
+// A region of memory managed by the GC, with its own allocation tables.  There
+// is one, in mp_state_mem_t, unless MICROPY_GC_SPLIT_HEAP adds more.
+typedef struct _mp_state_mem_area_t {
+    #if MICROPY_GC_SPLIT_HEAP
+    struct _mp_state_mem_area_t *next;
     #endif
 
     byte *gc_alloc_table_start;
@@ -73,13 +94,52 @@ typedef struct _mp_state_mem_t {
     #if MICROPY_ENABLE_FINALISER
     byte *gc_finaliser_table_start;
     #endif
+    #if MICROPY_GC_GENERATIONAL
+    byte *gc_age_table_start;
+    #endif
     byte *gc_pool_start;
     byte *gc_pool_end;
 
     void *gc_lowest_long_lived_ptr;
 
+    size_t gc_first_free_atb_index[MICROPY_ATB_INDICES];
+    size_t gc_last_free_atb_index;
+
+    #if MICROPY_GC_GENERATIONAL
+    // the range of blocks that holds the heads of all young objects
+    size_t gc_young_lo;
+    size_t gc_young_hi;
+    #endif
+
+    #if MICROPY_GC_SLAB
+    // heads of the slab free lists, as block index + 1 (0 for an empty list)
+    size_t gc_slab_head[MICROPY_GC_SLAB_CLASSES];
+    uint16_t gc_slab_len[MICROPY_GC_SLAB_CLASSES];
+    #endif
+
+    #if MICROPY_GC_INCREMENTAL
+    gc_sweep_state_t gc_sweep;
+    #endif
+} mp_state_mem_area_t;
+
+// This structure hold information about the memory allocation system.
+typedef struct _mp_state_mem_t {
+    #if MICROPY_MEM_STATS
+    size_t total_bytes_allocated;
+    size_t current_bytes_allocated;
+    size_t peak_bytes_allocated;
+    #endif
+
+    mp_state_mem_area_t area;
+
     int gc_stack_overflow;
     size_t gc_stack[MICROPY_ALLOC_GC_STACK_SIZE];
+    #if MICROPY_GC_SPLIT_HEAP
+    // the area of each block on gc_stack
+    mp_state_mem_area_t *gc_area_stack[MICROPY_ALLOC_GC_STACK_SIZE];
+    // allocations of at least this many bytes go to the added areas first
+    size_t gc_large_threshold;
+    #endif
     uint16_t gc_lock_depth;
 
     // This variable controls auto garbage collection.  If set to false then the
@@ -92,13 +152,33 @@ typedef struct _mp_state_mem_t {
     size_t gc_alloc_threshold;
     #endif
 
-    size_t gc_first_free_atb_index[MICROPY_ATB_INDICES];
-    size_t gc_last_free_atb_index;
-
     #if MICROPY_PY_GC_COLLECT_RETVAL
     size_t gc_collected;
     #endif
 
+    #if MICROPY_GC_GENERATIONAL
+    bool gc_minor; // the collection in progress is a minor one
+    uint16_t gc_minor_count; // minor collections since the last major one
+    uint16_t gc_minor_max;
+    #endif
+
+    #if MICROPY_GC_INCREMENTAL
+    mp_uint_t gc_step_budget_us;
+    mp_uint_t gc_collect_start_us;
+    // pause time statistics, in microseconds
+    size_t gc_pause_count;
+    mp_uint_t gc_pause_total_us;
+    mp_uint_t gc_pause_max_us;
+    uint32_t gc_pause_log[MICROPY_GC_PAUSE_LOG_LEN];
+    #endif
+
+    #if MICROPY_GC_DEFER_FINALISERS
+    // unreachable objects waiting for their finaliser to run; these are
+    // marked by each collection until they have been finalised and freed
+    void *gc_finaliser_queue[MICROPY_GC_FINALISER_QUEUE_LEN];
+    size_t gc_finaliser_len;
+    #endif
+
     #if MICROPY_PY_THREAD
     // This is a global mutex used to make the GC thread-safe.
     mp_thread_mutex_t gc_mutex;
@@ -191,6 +271,10 @@ typedef struct _mp_state_vm_t {
     struct _mp_vfs_mount_t *vfs_mount_table;
     #endif
 
+    #if MICROPY_OPT_QSTR_HASH_INDEX
+    qstr *qstr_index;
+    #endif
+
     //
     // END ROOT POINTER SECTION
     ////////////////////////////////////////////////////////////
@@ -201,6 +285,25 @@ typedef struct _mp_state_vm_t {
     size_t qstr_last_alloc;
     size_t qstr_last_used;
 
+    #if MICROPY_OPT_QSTR_HASH_INDEX
+    // number of slots in, and number of qstrs held by, the qstr hash index
+    size_t qstr_index_alloc;
+    size_t qstr_index_used;
+    #endif
+
+    #if MICROPY_OPT_MAP_LOOKUP_CACHE
+    // position each key was last found at, see mp_map_lookup; entries are
+    // checked before use so they never need clearing
+    uint8_t map_lookup_cache[MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE];
+    #endif
+
+    #if MICROPY_OPT_TYPE_ATTR_CACHE
+    // entries are only valid if their version matches type_attr_cache_version,
+    // so stale pointers in them are never followed and needn't be traced
+    mp_type_attr_cache_entry_t type_attr_cache[MICROPY_OPT_TYPE_ATTR_CACHE_SIZE];
+    size_t type_attr_cache_version;
+    #endif
+
     #if MICROPY_PY_THREAD
     // This is a global mutex used to make qstr interning thread-safe.
     mp_thread_mutex_t qstr_mutex;
@@ -424,7 +424,7 @@ STATIC size_t mpn_mul_dig_add_dig(mpz_dig_t *idig, size_t ilen, mpz_dig_t dmul,
    assumes enough memory in i; assumes i is zeroed; assumes normalised j, k
    can have j, k point to same memory
 */
-STATIC size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *kdig, size_t klen) {
+STATIC size_t mpn_mul_basecase(mpz_dig_t *idig, const mpz_dig_t *jdig, size_t jlen, const mpz_dig_t *kdig, size_t klen) {
     mpz_dig_t *oidig = idig;
     size_t ilen = 0;
 
@@ -433,7 +433,7 @@ STATIC size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *
         mpz_dbl_dig_t carry = 0;
 
         size_t jl = jlen;
-        for (mpz_dig_t *jd = jdig; jl > 0; --jl, ++jd, ++id) {
+        for (const mpz_dig_t *jd = jdig; jl > 0; --jl, ++jd, ++id) {
             carry += (mpz_dbl_dig_t)*id + (mpz_dbl_dig_t)*jd * (mpz_dbl_dig_t)*kdig; // will never overflow so long as DIG_SIZE <= 8*sizeof(mpz_dbl_dig_t)/2
             *id = carry & DIG_MASK;
             carry >>= DIG_SIZE;
@@ -453,6 +453,220 @@ STATIC size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *
     return ilen;
 }
 
+#if MICROPY_OPT_MPZ_KARATSUBA
+
+// Below this many digits in the shorter operand the basecase routines are
+// faster than splitting the operands.
+#ifndef MPZ_KARATSUBA_THRESHOLD
+#define MPZ_KARATSUBA_THRESHOLD (32)
+#endif
+
+/* computes i = i + j, where i has ilen digits and j has jlen <= ilen digits
+   returns the carry out of the top of i
+*/
+STATIC mpz_dig_t mpn_add_inpl(mpz_dig_t *idig, size_t ilen, const mpz_dig_t *jdig, size_t jlen) {
+    mpz_dbl_dig_t carry = 0;
+
+    for (ilen -= jlen; jlen > 0; --jlen, ++idig, ++jdig) {
+        carry += (mpz_dbl_dig_t)*idig + (mpz_dbl_dig_t)*jdig;
+        *idig = carry & DIG_MASK;
+        carry >>= DIG_SIZE;
+    }
+
+    for (; carry != 0 && ilen > 0; --ilen, ++idig) {
+        carry += *idig;
+        *idig = carry & DIG_MASK;
+        carry >>= DIG_SIZE;
+    }
+
+    return carry;
+}
+
+/* computes i = i - j, where i has ilen digits and j has jlen <= ilen digits
+   assumes i >= j
+*/
+STATIC void mpn_sub_inpl(mpz_dig_t *idig, size_t ilen, const mpz_dig_t *jdig, size_t jlen) {
+    mpz_dbl_dig_signed_t borrow = 0;
+
+    for (ilen -= jlen; jlen > 0; --jlen, ++idig, ++jdig) {
+        borrow += (mpz_dbl_dig_t)*idig - (mpz_dbl_dig_t)*jdig; // will overflow if DIG_SIZE >= 8*sizeof(mpz_dbl_dig_t)/2 (same as mpn_sub)
+        *idig = borrow & DIG_MASK;
+        borrow >>= DIG_SIZE;
+    }
+
+    for (; borrow != 0 && ilen > 0; --ilen, ++idig) {
+        borrow += *idig;
+        *idig = borrow & DIG_MASK;
+        borrow >>= DIG_SIZE;
+    }
+}
+
+/* returns the number of scratch digits needed by mpn_kmul and mpn_ksqr
+   when the longer operand has alen digits
+*/
+STATIC size_t mpn_kmul_scratch(size_t alen) {
+    size_t n = 0;
+    while (alen >= MPZ_KARATSUBA_THRESHOLD) {
+        alen = (alen + 1) / 2 + 1;
+        n += 4 * alen;
+    }
+    return n;
+}
+
+/* computes r = a * a, writing all 2 * alen digits of r
+   r must not overlap a
+*/
+STATIC void mpn_sqr_basecase(mpz_dig_t *rdig, const mpz_dig_t *adig, size_t alen) {
+    memset(rdig, 0, 2 * alen * sizeof(mpz_dig_t));
+
+    // sum of the cross products a[i] * a[j] with i < j, each needed twice
+    for (size_t i = 0; i + 1 < alen; ++i) {
+        mpz_dig_t *rd = rdig + 2 * i + 1;
+        mpz_dbl_dig_t carry = 0;
+        for (size_t j = i + 1; j < alen; ++j, ++rd) {
+            carry += (mpz_dbl_dig_t)*rd + (mpz_dbl_dig_t)adig[i] * (mpz_dbl_dig_t)adig[j];
+            *rd = carry & DIG_MASK;
+            carry >>= DIG_SIZE;
+        }
+        *rd = carry;
+        #ifdef RUN_BACKGROUND_TASKS
+        RUN_BACKGROUND_TASKS;
+        #endif
+    }
+
+    // double them and add the squares a[i] * a[i]
+    mpz_dbl_dig_t carry = 0;
+    mpz_dig_t shift_in = 0;
+    for (size_t i = 0; i < alen; ++i) {
+        mpz_dbl_dig_t sq = (mpz_dbl_dig_t)adig[i] * (mpz_dbl_dig_t)adig[i];
+        for (int h = 0; h < 2; ++h, sq >>= DIG_SIZE) {
+            mpz_dig_t *rd = rdig + 2 * i + h;
+            mpz_dig_t d = *rd;
+            carry += (((mpz_dbl_dig_t)d << 1) & DIG_MASK) + shift_in + (sq & DIG_MASK);
+            shift_in = d >> (DIG_SIZE - 1);
+            *rd = carry & DIG_MASK;
+            carry >>= DIG_SIZE;
+        }
+    }
+}
+
+/* computes r = a * b, writing all alen + blen digits of r
+   assumes alen >= blen >= 1; r must not overlap a, b or t
+   t is scratch space of mpn_kmul_scratch(alen) digits
+*/
+STATIC void mpn_kmul(mpz_dig_t *rdig, const mpz_dig_t *adig, size_t alen, const mpz_dig_t *bdig, size_t blen, mpz_dig_t *t) {
+    if (blen < MPZ_KARATSUBA_THRESHOLD) {
+        memset(rdig, 0, (alen + blen) * sizeof(mpz_dig_t));
+        mpn_mul_basecase(rdig, adig, alen, bdig, blen);
+        return;
+    }
+
+    size_t h = (alen + 1) / 2;
+
+    if (blen <= h) {
+        // too lopsided to split both: multiply b by successive blen-digit pieces of a
+        mpz_dig_t *p = t;
+        t += 2 * blen;
+        mpn_kmul(rdig, adig, blen, bdig, blen, t);
+        memset(rdig + 2 * blen, 0, (alen - blen) * sizeof(mpz_dig_t));
+        for (size_t i = blen; i < alen; i += blen) {
+            size_t n = MIN(blen, alen - i);
+            mpn_kmul(p, bdig, blen, adig + i, n, t);
+            mpn_add_inpl(rdig + i, alen + blen - i, p, blen + n);
+        }
+        return;
+    }
+
+    // a = a1 * B^h + a0 and b = b1 * B^h + b0, then
+    // a * b = z2 * B^2h + ((a1 + a0) * (b1 + b0) - z2 - z0) * B^h + z0
+    // with z2 = a1 * b1 and z0 = a0 * b0
+    size_t h1 = h + 1;
+    mpz_dig_t *sa = t;
+    mpz_dig_t *sb = t + h1;
+    mpz_dig_t *z1 = t + 2 * h1;
+    t += 4 * h1;
+
+    memcpy(sa, adig, h * sizeof(mpz_dig_t));
+    sa[h] = mpn_add_inpl(sa, h, adig + h, alen - h);
+    memcpy(sb, bdig, h * sizeof(mpz_dig_t));
+    sb[h] = mpn_add_inpl(sb, h, bdig + h, blen - h);
+
+    // z0 and z2 go straight into the low and high parts of r
+    mpn_kmul(rdig, adig, h, bdig, h, t);
+    mpn_kmul(rdig + 2 * h, adig + h, alen - h, bdig + h, blen - h, t);
+
+    mpn_kmul(z1, sa, h1, sb, h1, t);
+    mpn_sub_inpl(z1, 2 * h1, rdig, 2 * h);
+    mpn_sub_inpl(z1, 2 * h1, rdig + 2 * h, alen + blen - 2 * h);
+
+    // the digits of z1 beyond what fits in r are zero
+    mpn_add_inpl(rdig + h, alen + blen - h, z1, MIN(2 * h1, alen + blen - h));
+}
+
+/* computes r = a * a, writing all 2 * alen digits of r
+   r must not overlap a or t
+   t is scratch space of mpn_kmul_scratch(alen) digits
+*/
+STATIC void mpn_ksqr(mpz_dig_t *rdig, const mpz_dig_t *adig, size_t alen, mpz_dig_t *t) {
+    if (alen < MPZ_KARATSUBA_THRESHOLD) {
+        mpn_sqr_basecase(rdig, adig, alen);
+        return;
+    }
+
+    // as mpn_kmul, with (a1 + a0)^2 - z2 - z0 for the middle term
+    size_t h = (alen + 1) / 2;
+    size_t h1 = h + 1;
+    mpz_dig_t *sa = t;
+    mpz_dig_t *z1 = t + h1;
+    t += 3 * h1;
+
+    memcpy(sa, adig, h * sizeof(mpz_dig_t));
+    sa[h] = mpn_add_inpl(sa, h, adig + h, alen - h);
+
+    mpn_ksqr(rdig, adig, h, t);
+    mpn_ksqr(rdig + 2 * h, adig + h, alen - h, t);
+
+    mpn_ksqr(z1, sa, h1, t);
+    mpn_sub_inpl(z1, 2 * h1, rdig, 2 * h);
+    mpn_sub_inpl(z1, 2 * h1, rdig + 2 * h, 2 * (alen - h));
+
+    mpn_add_inpl(rdig + h, 2 * alen - h, z1, MIN(2 * h1, 2 * alen - h));
+}
+
+#endif // MICROPY_OPT_MPZ_KARATSUBA
+
+/* computes i = j * k
+   returns number of digits in i
+   assumes enough memory in i; assumes i is zeroed; assumes normalised j, k
+   can have j, k point to same memory
+*/
+STATIC size_t mpn_mul(mpz_dig_t *idig, const mpz_dig_t *jdig, size_t jlen, const mpz_dig_t *kdig, size_t klen) {
+    #if MICROPY_OPT_MPZ_KARATSUBA
+    if (jlen < klen) {
+        const mpz_dig_t *tdig = jdig;
+        jdig = kdig;
+        kdig = tdig;
+        size_t tlen = jlen;
+        jlen = klen;
+        klen = tlen;
+    }
+
+    if (jdig == kdig || klen >= MPZ_KARATSUBA_THRESHOLD) {
+        size_t tlen = mpn_kmul_scratch(jlen);
+        mpz_dig_t *t = tlen == 0 ? NULL : m_new(mpz_dig_t, tlen);
+        if (jdig == kdig) {
+            mpn_ksqr(idig, jdig, jlen, t);
+        } else {
+            mpn_kmul(idig, jdig, jlen, kdig, klen, t);
+        }
+        m_del(mpz_dig_t, t, tlen);
+        return mpn_remove_trailing_zeros(idig, idig + jlen + klen);
+    }
+    #endif
+
+    return mpn_mul_basecase(idig, jdig, jlen, kdig, klen);
+}
+
 /* natural_div - quo * den + new_num = old_num (ie num is replaced with rem)
    assumes den != 0
    assumes num_dig has enough memory to be extended by 1 digit
@@ -844,14 +1058,305 @@ typedef uint32_t mp_float_int_t;
 }
 #endif
 
+// returns the value of the digit character c, or 36 or more if it isn't one
+static inline mp_uint_t mpz_digit_value(mp_uint_t c) {
+    if ('0' <= c && c <= '9') {
+        return c - '0';
+    } else if ('A' <= c && c <= 'Z') {
+        return c - ('A' - 10);
+    } else if ('a' <= c && c <= 'z') {
+        return c - ('a' - 10);
+    }
+    return 36;
+}
+
+// State for converting between ints and strings in a given base.  The
+// conversion works in chunks of chunk_chars characters, which is the largest
+// group whose value always fits in a digit.
+typedef struct _mpz_radix_t {
+    unsigned int base;
+    size_t chunk_chars;
+    mpz_dig_t chunk; // base ** chunk_chars
+    #if MICROPY_OPT_MPZ_KARATSUBA
+    // for divide-and-conquer: pow[l] = chunk ** (2 ** l), recip[l] its reciprocal
+    size_t levels;
+    mpz_t *pow;
+    mpz_t *recip;
+    #endif
+} mpz_radix_t;
+
+STATIC void mpz_radix_init(mpz_radix_t *rx, unsigned int base) {
+    rx->base = base;
+    rx->chunk_chars = 1;
+    rx->chunk = base;
+    while ((mpz_dbl_dig_t)rx->chunk * base <= DIG_MASK) {
+        rx->chunk *= base;
+        rx->chunk_chars += 1;
+    }
+    #if MICROPY_OPT_MPZ_KARATSUBA
+    rx->levels = 0;
+    rx->pow = NULL;
+    rx->recip = NULL;
+    #endif
+}
+
+#if MICROPY_OPT_MPZ_KARATSUBA
+
+// Numbers with fewer digits than this are converted a chunk at a time,
+// larger ones are split in two by a power of the base.
+#ifndef MPZ_RADIX_DC_THRESHOLD
+#define MPZ_RADIX_DC_THRESHOLD (2 * MPZ_KARATSUBA_THRESHOLD)
+#endif
+
+// sets up pow[0] to pow[levels - 1], stopping after the first that has more
+// than max_len digits; returns how many were set up
+STATIC size_t mpz_radix_init_pow(mpz_radix_t *rx, size_t levels, size_t max_len) {
+    rx->levels = levels;
+    rx->pow = m_new(mpz_t, 2 * levels);
+    rx->recip = rx->pow + levels;
+    for (size_t l = 0; l < 2 * levels; ++l) {
+        mpz_init_zero(&rx->pow[l]);
+    }
+    mpz_set_from_int(&rx->pow[0], rx->chunk);
+    size_t l = 1;
+    for (; l < levels && rx->pow[l - 1].len <= max_len; ++l) {
+        mpz_mul_inpl(&rx->pow[l], &rx->pow[l - 1], &rx->pow[l - 1]);
+    }
+    return l;
+}
+
+STATIC void mpz_radix_deinit(mpz_radix_t *rx) {
+    for (size_t l = 0; l < 2 * rx->levels; ++l) {
+        mpz_deinit(&rx->pow[l]);
+    }
+    m_del(mpz_t, rx->pow, 2 * rx->levels);
+}
+
+/* computes v = B^(2 * d->len) / d, rounded down, where B = 2^DIG_SIZE
+   assumes d > 0; v can't be the same as d
+*/
+STATIC void mpz_recip_inpl(mpz_t *v, const mpz_t *d) {
+    size_t n = d->len;
+    mpz_t t, e;
+    mpz_init_zero(&t);
+    mpz_init_zero(&e);
+
+    if (n < MPZ_KARATSUBA_THRESHOLD) {
+        mpz_set_from_int(&t, 1);
+        mpz_shl_inpl(&t, &t, 2 * n * DIG_SIZE);
+        mpz_divmod_inpl(v, &e, &t, d);
+    } else {
+        // start from the reciprocal of the top n / 2 + 2 digits of d, then one
+        // Newton step v += v * (B^2n - d * v) / B^2n brings it to all n digits
+        size_t k = n - (n / 2 + 2);
+        mpz_shr_inpl(&t, d, k * DIG_SIZE);
+        mpz_recip_inpl(v, &t);
+        mpz_shl_inpl(v, v, k * DIG_SIZE);
+
+        mpz_mul_inpl(&t, d, v);
+        mpz_set_from_int(&e, 1);
+        mpz_shl_inpl(&e, &e, 2 * n * DIG_SIZE);
+        mpz_sub_inpl(&e, &e, &t);
+        mpz_mul_inpl(&e, &e, v);
+        mpz_shr_inpl(&e, &e, 2 * n * DIG_SIZE);
+        mpz_add_inpl(v, v, &e);
+
+        // fix up the last few units so that 0 <= B^2n - d * v < d
+        mpz_t one;
+        mpz_init_from_int(&one, 1);
+        mpz_mul_inpl(&t, d, v);
+        mpz_set_from_int(&e, 1);
+        mpz_shl_inpl(&e, &e, 2 * n * DIG_SIZE);
+        mpz_sub_inpl(&e, &e, &t);
+        while (mpz_is_neg(&e)) {
+            mpz_sub_inpl(v, v, &one);
+            mpz_add_inpl(&e, &e, d);
+        }
+        while (mpz_cmp(&e, d) >= 0) {
+            mpz_add_inpl(v, v, &one);
+            mpz_sub_inpl(&e, &e, d);
+        }
+        mpz_deinit(&one);
+    }
+
+    mpz_deinit(&t);
+    mpz_deinit(&e);
+}
+
+/* computes quo = lhs / rhs and rem = lhs % rhs given v = mpz_recip_inpl(rhs)
+   assumes 0 <= lhs < B^(2 * rhs->len) and rhs > 0; quo, rem must be distinct from the inputs
+*/
+STATIC void mpz_divmod_recip(mpz_t *dest_quo, mpz_t *dest_rem, const mpz_t *lhs, const mpz_t *rhs, const mpz_t *v) {
+    // the estimate from the top digits of lhs is at most 2 too small
+    size_t n = rhs->len;
+    mpz_shr_inpl(dest_rem, lhs, (n - 1) * DIG_SIZE);
+    mpz_mul_inpl(dest_quo, dest_rem, v);
+    mpz_shr_inpl(dest_quo, dest_quo, (n + 1) * DIG_SIZE);
+    mpz_mul_inpl(dest_rem, dest_quo, rhs);
+    mpz_sub_inpl(dest_rem, lhs, dest_rem);
+
+    if (mpz_cmp(dest_rem, rhs) >= 0) {
+        mpz_t one;
+        mpz_init_from_int(&one, 1);
+        do {
+            mpz_add_inpl(dest_quo, dest_quo, &one);
+            mpz_sub_inpl(dest_rem, dest_rem, rhs);
+        } while (mpz_cmp(dest_rem, rhs) >= 0);
+        mpz_deinit(&one);
+    }
+}
+
+#endif // MICROPY_OPT_MPZ_KARATSUBA
+
+/* computes z = z * base^len + (value of the len characters at str)
+   assumes the characters are valid digits and z has enough memory
+*/
+STATIC void mpz_set_from_str_chunks(mpz_t *z, const char *str, size_t len, const mpz_radix_t *rx) {
+    while (len > 0) {
+        size_t n = MIN(len, rx->chunk_chars);
+        mpz_dig_t mul = 1;
+        mpz_dig_t add = 0;
+        for (size_t i = 0; i < n; ++i) {
+            mul *= rx->base;
+            add = add * rx->base + mpz_digit_value(*str++);
+        }
+        z->len = mpn_mul_dig_add_dig(z->dig, z->len, mul, add);
+        len -= n;
+    }
+}
+
+#if MICROPY_OPT_MPZ_KARATSUBA
+/* sets z to the value of the len characters at str
+   assumes the characters are valid digits and len <= chunk_chars * 2^level
+*/
+STATIC void mpz_set_from_str_dc(mpz_t *z, const char *str, size_t len, size_t level, mpz_radix_t *rx) {
+    while (level > 0 && len <= rx->chunk_chars << (level - 1)) {
+        --level;
+    }
+
+    if (level == 0 || len <= rx->chunk_chars * MPZ_RADIX_DC_THRESHOLD) {
+        mpz_need_dig(z, len * 8 / DIG_SIZE + 1);
+        z->len = 0;
+        mpz_set_from_str_chunks(z, str, len, rx);
+        return;
+    }
+
+    // z = high * base^w + low, where low is the last w characters
+    size_t w = rx->chunk_chars << (level - 1);
+    mpz_t low;
+    mpz_init_zero(&low);
+    mpz_set_from_str_dc(z, str, len - w, level - 1, rx);
+    mpz_set_from_str_dc(&low, str + len - w, w, level - 1, rx);
+    mpz_mul_inpl(z, z, &rx->pow[level - 1]);
+    mpz_add_inpl(z, z, &low);
+    mpz_deinit(&low);
+}
+#endif
+
+/* writes the characters of i to s, least significant first, padded with
+   zeros to at least pad characters; returns the end of the characters written
+   destroys i
+*/
+STATIC char *mpn_as_str_chunks(char *s, mpz_dig_t *idig, size_t ilen, size_t pad, const mpz_radix_t *rx, char base_char) {
+    char *start = s;
+
+    while (ilen > 0) {
+        mpz_dig_t *d = idig + ilen;
+        mpz_dbl_dig_t a = 0;
+
+        // divide by chunk, leaving the remainder in a
+        while (--d >= idig) {
+            a = (a << DIG_SIZE) | *d;
+            *d = a / rx->chunk;
+            a %= rx->chunk;
+        }
+        if (idig[ilen - 1] == 0) {
+            --ilen;
+        }
+
+        // convert to characters, stopping at the last non-zero one of the last chunk
+        for (size_t n = rx->chunk_chars; n > 0 && (ilen > 0 || a != 0); --n) {
+            mpz_dig_t c = a % rx->base;
+            a /= rx->base;
+            *s++ = c < 10 ? '0' + c : base_char + c - 10;
+        }
+
+        // check to prevent usb starvation
+        #ifdef RUN_BACKGROUND_TASKS
+        RUN_BACKGROUND_TASKS;
+        #endif
+    }
+
+    while ((size_t)(s - start) < pad) {
+        *s++ = '0';
+    }
+
+    return s;
+}
+
+#if MICROPY_OPT_MPZ_KARATSUBA
+/* as mpn_as_str_chunks, for 0 <= z < pow[level] ** 2 (or any z if level is 0)
+   destroys z
+*/
+STATIC char *mpz_as_str_dc(char *s, mpz_t *z, size_t level, size_t pad, mpz_radix_t *rx, char base_char) {
+    // without padding, splitting at a power above z would give leading zeros
+    while (pad == 0 && level > 0 && mpz_cmp(z, &rx->pow[level - 1]) < 0) {
+        --level;
+    }
+
+    if (level == 0 || z->len < MPZ_RADIX_DC_THRESHOLD) {
+        s = mpn_as_str_chunks(s, z->dig, z->len, pad, rx, base_char);
+        mpz_deinit(z);
+        return s;
+    }
+
+    // z = quo * pow[level] + rem, and rem takes exactly w characters
+    --level;
+    if (mpz_is_zero(&rx->recip[level])) {
+        mpz_recip_inpl(&rx->recip[level], &rx->pow[level]);
+    }
+    mpz_t quo, rem;
+    mpz_init_zero(&quo);
+    mpz_init_zero(&rem);
+    mpz_divmod_recip(&quo, &rem, z, &rx->pow[level], &rx->recip[level]);
+    mpz_deinit(z);
+
+    size_t w = rx->chunk_chars << level;
+    s = mpz_as_str_dc(s, &rem, level, w, rx, base_char);
+    return mpz_as_str_dc(s, &quo, level, pad > w ? pad - w : 0, rx, base_char);
+}
+#endif
+
 // returns number of bytes from str that were processed
 size_t mpz_set_from_str(mpz_t *z, const char *str, size_t len, bool neg, unsigned int base) {
     assert(base <= 36);
 
+    // find the run of valid digits
     const char *cur = str;
     const char *top = str + len;
+    for (; cur < top && mpz_digit_value(*cur) < base; ++cur) { // XXX UTF8 next char
+    }
+    len = cur - str;
 
-    mpz_need_dig(z, len * 8 / DIG_SIZE + 1);
+    mpz_radix_t rx;
+    mpz_radix_init(&rx, base);
+
+    #if MICROPY_OPT_MPZ_KARATSUBA
+    if (len > rx.chunk_chars * MPZ_RADIX_DC_THRESHOLD) {
+        size_t levels = 1;
+        while ((rx.chunk_chars << levels) < len) {
+            ++levels;
+        }
+        mpz_radix_init_pow(&rx, levels, (size_t)-1);
+        mpz_set_from_str_dc(z, str, len, levels, &rx);
+        mpz_radix_deinit(&rx);
+    } else
+    #endif
+    {
+        mpz_need_dig(z, len * 8 / DIG_SIZE + 1);
+        z->len = 0;
+        mpz_set_from_str_chunks(z, str, len, &rx);
+    }
 
     if (neg) {
         z->neg = 1;
@@ -859,26 +1364,7 @@ size_t mpz_set_from_str(mpz_t *z, const char *str, size_t len, bool neg, unsigne
         z->neg = 0;
     }
 
-    z->len = 0;
-    for (; cur < top; ++cur) { // XXX UTF8 next char
-        //mp_uint_t v = char_to_numeric(cur#); // XXX UTF8 get char
-        mp_uint_t v = *cur;
-        if ('0' <= v && v <= '9') {
-            v -= '0';
-        } else if ('A' <= v && v <= 'Z') {
-            v -= 'A' - 10;
-        } else if ('a' <= v && v <= 'z') {
-            v -= 'a' - 10;
-        } else {
-            break;
-        }
-        if (v >= base) {
-            break;
-        }
-        z->len = mpn_mul_dig_add_dig(z->dig, z->len, base, v);
-    }
-
-    return cur - str;
+    return len;
 }
 
 void mpz_set_from_bytes(mpz_t *z, bool big_endian, size_t len, const byte *buf) {
@@ -1363,6 +1849,155 @@ void mpz_pow_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs) {
     mpz_free(n);
 }
 
+#if MICROPY_OPT_MPZ_MONTGOMERY
+
+/* computes r = t / B^n mod m, where B = 2^DIG_SIZE (Montgomery reduction)
+   t has 2n + 1 digits, is less than m * B^n and is overwritten
+   r has n digits and can be the same as t
+   assumes m is odd with n digits, minv = -1 / m mod B
+*/
+STATIC void mpn_redc(mpz_dig_t *rdig, mpz_dig_t *tdig, const mpz_dig_t *mdig, size_t n, mpz_dig_t minv) {
+    for (size_t i = 0; i < n; ++i) {
+        // add a multiple of m that clears digit i of t
+        mpz_dig_t u = ((mpz_dbl_dig_t)tdig[i] * (mpz_dbl_dig_t)minv) & DIG_MASK;
+        mpz_dig_t *td = tdig + i;
+        mpz_dbl_dig_t carry = 0;
+        for (size_t j = 0; j < n; ++j, ++td) {
+            carry += (mpz_dbl_dig_t)*td + (mpz_dbl_dig_t)u * (mpz_dbl_dig_t)mdig[j];
+            *td = carry & DIG_MASK;
+            carry >>= DIG_SIZE;
+        }
+        for (; carry != 0; ++td) {
+            carry += *td;
+            *td = carry & DIG_MASK;
+            carry >>= DIG_SIZE;
+        }
+    }
+
+    // t / B^n is now less than 2m
+    tdig += n;
+    int cmp = tdig[n];
+    for (size_t i = n; cmp == 0 && i-- > 0;) {
+        cmp = (tdig[i] > mdig[i]) - (tdig[i] < mdig[i]);
+    }
+    if (cmp >= 0) {
+        mpz_dbl_dig_signed_t borrow = 0;
+        for (size_t i = 0; i < n; ++i) {
+            borrow += (mpz_dbl_dig_t)tdig[i] - (mpz_dbl_dig_t)mdig[i];
+            tdig[i] = borrow & DIG_MASK;
+            borrow >>= DIG_SIZE;
+        }
+    }
+    memmove(rdig, tdig, n * sizeof(mpz_dig_t));
+}
+
+/* computes r = a * b / B^n mod m, all with n digits
+   r can be the same as a or b; t is scratch space for the double-length product
+*/
+STATIC void mpn_mont_mul(mpz_dig_t *rdig, const mpz_dig_t *adig, const mpz_dig_t *bdig, const mpz_t *mod, mpz_dig_t minv, mpz_dig_t *t) {
+    size_t n = mod->len;
+    #if MICROPY_OPT_MPZ_KARATSUBA
+    if (adig == bdig) {
+        mpn_ksqr(t, adig, n, t + 2 * n + 1);
+    } else {
+        mpn_kmul(t, adig, n, bdig, n, t + 2 * n + 1);
+    }
+    #else
+    memset(t, 0, 2 * n * sizeof(mpz_dig_t));
+    mpn_mul_basecase(t, adig, n, bdig, n);
+    #endif
+    t[2 * n] = 0;
+    mpn_redc(rdig, t, mod->dig, n, minv);
+}
+
+/* computes dest = (lhs ** rhs) % mod for odd, positive mod
+   assumes rhs > 0; dest can't be the same as rhs or mod
+*/
+STATIC void mpz_pow3_montgomery(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs, const mpz_t *mod) {
+    size_t n = mod->len;
+
+    // minv = -1 / m mod B; m * m = 1 mod 8 for odd m and each Newton step doubles the correct bits
+    mpz_dbl_dig_t inv = mod->dig[0];
+    for (int bits = 3; bits < DIG_SIZE; bits *= 2) {
+        inv *= 2 - (mpz_dbl_dig_t)mod->dig[0] * inv;
+    }
+    mpz_dig_t minv = (0 - inv) & DIG_MASK;
+
+    // use a 4-bit window for the exponent unless it is short
+    size_t nbits = (rhs->len - 1) * DIG_SIZE;
+    for (mpz_dig_t d = rhs->dig[rhs->len - 1]; d != 0; d >>= 1) {
+        ++nbits;
+    }
+    unsigned int win = nbits > 64 ? 4 : 1;
+    size_t ntab = (size_t)1 << win;
+
+    size_t scratch = 2 * n + 1;
+    #if MICROPY_OPT_MPZ_KARATSUBA
+    scratch += mpn_kmul_scratch(n);
+    #endif
+    size_t alloc = (ntab + 1) * n + scratch;
+    mpz_dig_t *tab = m_new(mpz_dig_t, alloc);
+    mpz_dig_t *acc = tab + ntab * n;
+    mpz_dig_t *t = acc + n;
+
+    // tab[k] = lhs ** k in Montgomery form, ie times B^n mod m
+    mpz_t x, quo;
+    mpz_init_zero(&x);
+    mpz_init_zero(&quo);
+    for (int k = 0; k < 2; ++k) {
+        if (k == 0) {
+            mpz_set_from_int(&x, 1);
+            mpz_shl_inpl(&x, &x, n * DIG_SIZE);
+        } else {
+            mpz_shl_inpl(&x, lhs, n * DIG_SIZE);
+        }
+        mpz_divmod_inpl(&quo, &x, &x, mod);
+        memset(tab + k * n, 0, n * sizeof(mpz_dig_t));
+        memcpy(tab + k * n, x.dig, x.len * sizeof(mpz_dig_t));
+    }
+    mpz_deinit(&x);
+    mpz_deinit(&quo);
+    for (size_t k = 2; k < ntab; ++k) {
+        mpn_mont_mul(tab + k * n, tab + (k - 1) * n, tab + n, mod, minv, t);
+    }
+
+    // left to right over the exponent, win bits at a time
+    bool started = false;
+    for (size_t pos = (nbits + win - 1) / win * win; pos > 0;) {
+        pos -= win;
+        size_t w = 0;
+        for (unsigned int b = win; b-- > 0;) {
+            size_t p = pos + b;
+            w = w << 1 | (p < rhs->len * DIG_SIZE && (rhs->dig[p / DIG_SIZE] >> (p % DIG_SIZE)) & 1);
+        }
+        if (started) {
+            for (unsigned int b = 0; b < win; ++b) {
+                mpn_mont_mul(acc, acc, acc, mod, minv, t);
+            }
+            if (w != 0) {
+                mpn_mont_mul(acc, acc, tab + w * n, mod, minv, t);
+            }
+        } else if (w != 0) {
+            memcpy(acc, tab + w * n, n * sizeof(mpz_dig_t));
+            started = true;
+        }
+    }
+
+    // convert back out of Montgomery form
+    memcpy(t, acc, n * sizeof(mpz_dig_t));
+    memset(t + n, 0, (n + 1) * sizeof(mpz_dig_t));
+    mpn_redc(acc, t, mod->dig, n, minv);
+
+    mpz_need_dig(dest, n);
+    memcpy(dest->dig, acc, n * sizeof(mpz_dig_t));
+    dest->len = mpn_remove_trailing_zeros(dest->dig, dest->dig + n);
+    dest->neg = 0;
+
+    m_del(mpz_dig_t, tab, alloc);
+}
+
+#endif // MICROPY_OPT_MPZ_MONTGOMERY
+
 /* computes dest = (lhs ** rhs) % mod
    can have dest, lhs, rhs the same; mod can't be the same as dest
 */
@@ -1378,6 +2013,13 @@ void mpz_pow3_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs, const mpz_t
         return;
     }
 
+    #if MICROPY_OPT_MPZ_MONTGOMERY
+    if (!mod->neg && (mod->dig[0] & 1) != 0) {
+        mpz_pow3_montgomery(dest, lhs, rhs, mod);
+        return;
+    }
+    #endif
+
     mpz_t *x = mpz_clone(lhs);
     mpz_t *n = mpz_clone(rhs);
     mpz_t quo; mpz_init_zero(&quo);
@@ -1671,48 +2313,47 @@ size_t mpz_as_str_inpl(const mpz_t *i, unsigned int base, const char *prefix, ch
         return s - str;
     }
 
-    // make a copy of mpz digits, so we can do the div/mod calculation
-    mpz_dig_t *dig = m_new(mpz_dig_t, ilen);
-    memcpy(dig, i->dig, ilen * sizeof(mpz_dig_t));
-
-    // convert
-    char *last_comma = str;
-    bool done;
-    do {
-        mpz_dig_t *d = dig + ilen;
-        mpz_dbl_dig_t a = 0;
-
-        // compute next remainder
-        while (--d >= dig) {
-            a = (a << DIG_SIZE) | *d;
-            *d = a / base;
-            a %= base;
-        }
+    mpz_radix_t rx;
+    mpz_radix_init(&rx, base);
 
-        // convert to character
-        a += '0';
-        if (a > '9') {
-            a += base_char - '9' - 1;
+    #if MICROPY_OPT_MPZ_KARATSUBA
+    if (ilen >= MPZ_RADIX_DC_THRESHOLD) {
+        // work on a copy of i, split at the largest pow[level] that is not above it
+        mpz_t z;
+        mpz_init_zero(&z);
+        mpz_set(&z, i);
+        z.neg = 0;
+        size_t levels = 2;
+        for (size_t n = ilen; n > 0; n >>= 1) {
+            ++levels;
         }
-        *s++ = a;
-
-        // check if number is zero
-        done = true;
-        for (d = dig; d < dig + ilen; ++d) {
-            if (*d != 0) {
-                done = false;
-                break;
+        size_t level = mpz_radix_init_pow(&rx, levels, ilen);
+        do {
+            --level;
+        } while (mpz_cmp(&rx.pow[level], &z) > 0);
+        s = mpz_as_str_dc(s, &z, level + 1, 0, &rx, base_char);
+        mpz_radix_deinit(&rx);
+    } else
+    #endif
+    {
+        // make a copy of mpz digits, so we can do the div/mod calculation
+        mpz_dig_t *dig = m_new(mpz_dig_t, ilen);
+        memcpy(dig, i->dig, ilen * sizeof(mpz_dig_t));
+        s = mpn_as_str_chunks(s, dig, ilen, 0, &rx, base_char);
+        m_del(mpz_dig_t, dig, ilen);
+    }
+
+    // insert a comma after every third character
+    if (comma) {
+        size_t n = s - str;
+        s += n / 3;
+        for (size_t k = n; k-- > 0;) {
+            if (k % 3 == 2) {
+                str[k + k / 3 + 1] = comma;
             }
-        }
-        if (comma && (s - last_comma) == 3) {
-            *s++ = comma;
-            last_comma = s;
+            str[k + k / 3] = str[k];
         }
     }
-    while (!done);
-
-    // free the copy of the digits array
-    m_del(mpz_dig_t, dig, ilen);
 
     if (prefix) {
         const char *p = &prefix[strlen(prefix)];
@@ -268,6 +268,8 @@ STATIC mp_obj_t array_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs
                 res = lhs;
                 size_t item_sz = mp_binary_get_size('@', lhs->typecode, NULL);
                 lhs->items = m_renew(byte, lhs->items, (lhs->len + lhs->free) * item_sz, lhs->len * repeat * item_sz);
+                // the items may have moved
+                lhs_bufinfo.buf = lhs->items;
                 lhs->len = lhs->len * repeat;
                 lhs->free = 0;
                 if (!repeat)
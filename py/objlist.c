@@ -29,7 +29,6 @@
 
 #include "py/objlist.h"
 #include "py/runtime.h"
-#include "py/stackctrl.h"
 
 #include "supervisor/shared/translate.h"
 
@@ -289,35 +288,558 @@ STATIC mp_obj_t list_pop(size_t n_args, const mp_obj_t *args) {
     return ret;
 }
 
-STATIC void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj_t binop_less_result) {
-    MP_STACK_CHECK();
-    while (head < tail) {
-        mp_obj_t *h = head - 1;
-        mp_obj_t *t = tail;
-        mp_obj_t v = key_fn == MP_OBJ_NULL ? tail[0] : mp_call_function_1(key_fn, tail[0]); // get pivot using key_fn
-        for (;;) {
-            do ++h; while (h < t && mp_binary_op(MP_BINARY_OP_LESS, key_fn == MP_OBJ_NULL ? h[0] : mp_call_function_1(key_fn, h[0]), v) == binop_less_result);
-            do --t; while (h < t && mp_binary_op(MP_BINARY_OP_LESS, v, key_fn == MP_OBJ_NULL ? t[0] : mp_call_function_1(key_fn, t[0])) == binop_less_result);
-            if (h >= t) break;
-            mp_obj_t x = h[0];
-            h[0] = t[0];
-            t[0] = x;
-        }
-        mp_obj_t x = h[0];
-        h[0] = tail[0];
-        tail[0] = x;
-        // do the smaller recursive call first, to keep stack within O(log(N))
-        if (t - head < tail - h - 1) {
-            mp_quicksort(head, t, key_fn, binop_less_result);
-            head = h + 1;
+// list.sort is a TimSort, an adaptive stable merge sort modelled on CPython's
+// listsort (see Objects/listsort.txt there).  Runs that are already in order
+// are found and merged, so sorted and nearly sorted input takes O(n) time.
+// The merge stack is a fixed array and nothing recurses.
+
+// Slices of the keys being compared and, with a key function, of the list
+// items that move along with them.
+typedef struct _sort_slice_t {
+    mp_obj_t *keys;
+    mp_obj_t *values;
+} sort_slice_t;
+
+// Runs are merged when their lengths stop shrinking like the Fibonacci numbers
+// from the top of the stack down, so this many are enough for any list.
+#define SORT_MAX_PENDING (sizeof(size_t) > 4 ? 85 : 49)
+
+#define SORT_MIN_GALLOP 7
+
+typedef struct _sort_state_t {
+    sort_slice_t base;
+    bool has_values;
+    size_t min_gallop;
+    // room for the shorter of two runs being merged
+    mp_obj_t *tmp;
+    size_t tmp_alloc;
+    // While a merge is in progress, gap_len entries of the list are held only
+    // in tmp, starting at gap_src.  If a comparison raises, they are copied back
+    // to gap so that the list keeps all its items.
+    sort_slice_t gap;
+    sort_slice_t gap_src;
+    size_t gap_len;
+    size_t n_pending;
+    struct {
+        size_t base;
+        size_t len;
+    } pending[SORT_MAX_PENDING];
+} sort_state_t;
+
+STATIC bool sort_lt(mp_obj_t x, mp_obj_t y) {
+    if (MP_OBJ_IS_SMALL_INT(x) && MP_OBJ_IS_SMALL_INT(y)) {
+        return MP_OBJ_SMALL_INT_VALUE(x) < MP_OBJ_SMALL_INT_VALUE(y);
+    }
+    return mp_obj_is_true(mp_binary_op(MP_BINARY_OP_LESS, x, y));
+}
+
+static inline sort_slice_t sort_slice_at(sort_state_t *ms, size_t i) {
+    sort_slice_t s = { ms->base.keys + i, ms->has_values ? ms->base.values + i : NULL };
+    return s;
+}
+
+static inline void sort_slice_advance(sort_slice_t *s, mp_int_t n) {
+    s->keys += n;
+    if (s->values != NULL) {
+        s->values += n;
+    }
+}
+
+static inline void sort_slice_copy(sort_slice_t *dst, mp_int_t i, sort_slice_t *src, mp_int_t j, size_t n) {
+    memmove(dst->keys + i, src->keys + j, n * sizeof(mp_obj_t));
+    if (dst->values != NULL) {
+        memmove(dst->values + i, src->values + j, n * sizeof(mp_obj_t));
+    }
+}
+
+// Moves one item from src to dst and steps both by delta.
+static inline void sort_slice_move(sort_slice_t *dst, sort_slice_t *src, mp_int_t delta) {
+    *dst->keys = *src->keys;
+    if (dst->values != NULL) {
+        *dst->values = *src->values;
+    }
+    sort_slice_advance(dst, delta);
+    sort_slice_advance(src, delta);
+}
+
+STATIC void sort_slice_reverse(sort_slice_t *s, size_t n) {
+    for (size_t i = 0, j = n - 1; i < j; i++, j--) {
+        mp_obj_t t = s->keys[i];
+        s->keys[i] = s->keys[j];
+        s->keys[j] = t;
+        if (s->values != NULL) {
+            t = s->values[i];
+            s->values[i] = s->values[j];
+            s->values[j] = t;
+        }
+    }
+}
+
+static inline void sort_mark_gap(sort_state_t *ms, sort_slice_t *gap, sort_slice_t *src, size_t len) {
+    ms->gap = *gap;
+    ms->gap_src = *src;
+    ms->gap_len = len;
+}
+
+// Insertion sort of lo[0:n], where lo[0:start] is already sorted.  The
+// insertion point is found by binary search, after the equal keys.
+STATIC void sort_binary_insertion(sort_slice_t lo, size_t start, size_t n) {
+    for (; start < n; start++) {
+        mp_obj_t pivot = lo.keys[start];
+        size_t l = 0, r = start;
+        while (l < r) {
+            size_t p = l + ((r - l) >> 1);
+            if (sort_lt(pivot, lo.keys[p])) {
+                r = p;
+            } else {
+                l = p + 1;
+            }
+        }
+        memmove(lo.keys + l + 1, lo.keys + l, (start - l) * sizeof(mp_obj_t));
+        lo.keys[l] = pivot;
+        if (lo.values != NULL) {
+            mp_obj_t v = lo.values[start];
+            memmove(lo.values + l + 1, lo.values + l, (start - l) * sizeof(mp_obj_t));
+            lo.values[l] = v;
+        }
+    }
+}
+
+// Length of the run at the start of keys[0:n].  A strictly descending run is
+// reversed in place; keeping equal keys out of it keeps the sort stable.
+STATIC size_t sort_count_run(sort_slice_t *lo, size_t n) {
+    size_t i = 1;
+    if (n == 1) {
+        return 1;
+    }
+    if (sort_lt(lo->keys[1], lo->keys[0])) {
+        for (i = 2; i < n && sort_lt(lo->keys[i], lo->keys[i - 1]); i++) {
+        }
+        sort_slice_reverse(lo, i);
+    } else {
+        for (i = 2; i < n && !sort_lt(lo->keys[i], lo->keys[i - 1]); i++) {
+        }
+    }
+    return i;
+}
+
+// Position to insert key into sorted a[0:n] before any equal keys, searching
+// outwards from a[hint] first.
+STATIC size_t sort_gallop_left(mp_obj_t key, mp_obj_t *a, mp_int_t n, mp_int_t hint) {
+    mp_int_t ofs = 1, lastofs = 0;
+    a += hint;
+    if (sort_lt(*a, key)) {
+        // a[hint] < key: gallop right until a[hint + lastofs] < key <= a[hint + ofs]
+        mp_int_t maxofs = n - hint;
+        while (ofs < maxofs && sort_lt(a[ofs], key)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        lastofs += hint;
+        ofs += hint;
+    } else {
+        // key <= a[hint]: gallop left until a[hint - ofs] < key <= a[hint - lastofs]
+        mp_int_t maxofs = hint + 1;
+        while (ofs < maxofs && !sort_lt(*(a - ofs), key)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        mp_int_t k = lastofs;
+        lastofs = hint - ofs;
+        ofs = hint - k;
+    }
+    a -= hint;
+    // a[lastofs] < key <= a[ofs], so binary search in between
+    lastofs++;
+    while (lastofs < ofs) {
+        mp_int_t m = lastofs + ((ofs - lastofs) >> 1);
+        if (sort_lt(a[m], key)) {
+            lastofs = m + 1;
+        } else {
+            ofs = m;
+        }
+    }
+    return ofs;
+}
+
+// Like sort_gallop_left, but the position is after any equal keys.
+STATIC size_t sort_gallop_right(mp_obj_t key, mp_obj_t *a, mp_int_t n, mp_int_t hint) {
+    mp_int_t ofs = 1, lastofs = 0;
+    a += hint;
+    if (sort_lt(key, *a)) {
+        // key < a[hint]: gallop left until a[hint - ofs] <= key < a[hint - lastofs]
+        mp_int_t maxofs = hint + 1;
+        while (ofs < maxofs && sort_lt(key, *(a - ofs))) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        mp_int_t k = lastofs;
+        lastofs = hint - ofs;
+        ofs = hint - k;
+    } else {
+        // a[hint] <= key: gallop right until a[hint + lastofs] <= key < a[hint + ofs]
+        mp_int_t maxofs = n - hint;
+        while (ofs < maxofs && !sort_lt(key, a[ofs])) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        lastofs += hint;
+        ofs += hint;
+    }
+    a -= hint;
+    lastofs++;
+    while (lastofs < ofs) {
+        mp_int_t m = lastofs + ((ofs - lastofs) >> 1);
+        if (sort_lt(key, a[m])) {
+            ofs = m;
         } else {
-            mp_quicksort(h + 1, tail, key_fn, binop_less_result);
-            tail = t;
+            lastofs = m + 1;
+        }
+    }
+    return ofs;
+}
+
+STATIC sort_slice_t sort_get_tmp(sort_state_t *ms, size_t need) {
+    size_t n = ms->has_values ? 2 * need : need;
+    if (n > ms->tmp_alloc) {
+        // don't keep the old contents
+        m_del(mp_obj_t, ms->tmp, ms->tmp_alloc);
+        ms->tmp = NULL;
+        ms->tmp_alloc = 0;
+        ms->tmp = m_new(mp_obj_t, n);
+        ms->tmp_alloc = n;
+    }
+    sort_slice_t s = { ms->tmp, ms->has_values ? ms->tmp + need : NULL };
+    return s;
+}
+
+// Merge the adjacent runs a[0:na] and b[0:nb], with na <= nb, copying a to tmp.
+// a[0] belongs at the very start and b[nb - 1] at the very end.
+STATIC void sort_merge_lo(sort_state_t *ms, sort_slice_t a, size_t na, sort_slice_t b, size_t nb) {
+    sort_slice_t dest = a;
+    a = sort_get_tmp(ms, na);
+    sort_slice_copy(&a, 0, &dest, 0, na);
+    size_t min_gallop = ms->min_gallop;
+
+    sort_slice_move(&dest, &b, 1);
+    if (--nb == 0) {
+        goto done;
+    }
+    if (na == 1) {
+        goto copy_b;
+    }
+
+    for (;;) {
+        size_t acount = 0, bcount = 0;
+        // one item at a time until one run is winning consistently
+        for (;;) {
+            sort_mark_gap(ms, &dest, &a, na);
+            if (sort_lt(*b.keys, *a.keys)) {
+                sort_slice_move(&dest, &b, 1);
+                bcount++;
+                acount = 0;
+                if (--nb == 0) {
+                    goto done;
+                }
+                if (bcount >= min_gallop) {
+                    break;
+                }
+            } else {
+                sort_slice_move(&dest, &a, 1);
+                acount++;
+                bcount = 0;
+                if (--na == 1) {
+                    goto copy_b;
+                }
+                if (acount >= min_gallop) {
+                    break;
+                }
+            }
+        }
+
+        // then gallop, moving whole stretches, until that stops paying off
+        min_gallop++;
+        do {
+            min_gallop -= min_gallop > 1;
+            ms->min_gallop = min_gallop;
+            sort_mark_gap(ms, &dest, &a, na);
+            size_t k = sort_gallop_right(*b.keys, a.keys, na, 0);
+            acount = k;
+            if (k) {
+                sort_slice_copy(&dest, 0, &a, 0, k);
+                sort_slice_advance(&dest, k);
+                sort_slice_advance(&a, k);
+                na -= k;
+                if (na == 1) {
+                    goto copy_b;
+                }
+                // only possible if the comparison is inconsistent
+                if (na == 0) {
+                    goto done;
+                }
+            }
+            sort_slice_move(&dest, &b, 1);
+            if (--nb == 0) {
+                goto done;
+            }
+
+            sort_mark_gap(ms, &dest, &a, na);
+            k = sort_gallop_left(*a.keys, b.keys, nb, 0);
+            bcount = k;
+            if (k) {
+                sort_slice_copy(&dest, 0, &b, 0, k);
+                sort_slice_advance(&dest, k);
+                sort_slice_advance(&b, k);
+                nb -= k;
+                if (nb == 0) {
+                    goto done;
+                }
+            }
+            sort_slice_move(&dest, &a, 1);
+            if (--na == 1) {
+                goto copy_b;
+            }
+        } while (acount >= SORT_MIN_GALLOP || bcount >= SORT_MIN_GALLOP);
+        min_gallop++;
+        ms->min_gallop = min_gallop;
+    }
+
+done:
+    if (na) {
+        sort_slice_copy(&dest, 0, &a, 0, na);
+    }
+    ms->gap_len = 0;
+    return;
+
+copy_b:
+    // the last item of a goes after the rest of b
+    sort_slice_copy(&dest, 0, &b, 0, nb);
+    sort_slice_copy(&dest, nb, &a, 0, 1);
+    ms->gap_len = 0;
+}
+
+// Merge the adjacent runs a[0:na] and b[0:nb], with na >= nb, copying b to tmp
+// and filling from the end.
+STATIC void sort_merge_hi(sort_state_t *ms, sort_slice_t a, size_t na, sort_slice_t b, size_t nb) {
+    sort_slice_t dest = b;
+    sort_slice_advance(&dest, nb - 1);
+    sort_slice_t base_b = sort_get_tmp(ms, nb);
+    sort_slice_copy(&base_b, 0, &b, 0, nb);
+    sort_slice_t base_a = a;
+    b = base_b;
+    sort_slice_advance(&b, nb - 1);
+    sort_slice_advance(&a, na - 1);
+    size_t min_gallop = ms->min_gallop;
+    // the gap in the list is dest[1 - nb:1], held in base_b[0:nb]
+    sort_slice_t gap;
+
+    sort_slice_move(&dest, &a, -1);
+    if (--na == 0) {
+        goto done;
+    }
+    if (nb == 1) {
+        goto copy_a;
+    }
+
+    for (;;) {
+        size_t acount = 0, bcount = 0;
+        for (;;) {
+            gap = dest;
+            sort_slice_advance(&gap, 1 - (mp_int_t)nb);
+            sort_mark_gap(ms, &gap, &base_b, nb);
+            if (sort_lt(*b.keys, *a.keys)) {
+                sort_slice_move(&dest, &a, -1);
+                acount++;
+                bcount = 0;
+                if (--na == 0) {
+                    goto done;
+                }
+                if (acount >= min_gallop) {
+                    break;
+                }
+            } else {
+                sort_slice_move(&dest, &b, -1);
+                bcount++;
+                acount = 0;
+                if (--nb == 1) {
+                    goto copy_a;
+                }
+                if (bcount >= min_gallop) {
+                    break;
+                }
+            }
         }
+
+        min_gallop++;
+        do {
+            min_gallop -= min_gallop > 1;
+            ms->min_gallop = min_gallop;
+            gap = dest;
+            sort_slice_advance(&gap, 1 - (mp_int_t)nb);
+            sort_mark_gap(ms, &gap, &base_b, nb);
+            size_t k = na - sort_gallop_right(*b.keys, base_a.keys, na, na - 1);
+            acount = k;
+            if (k) {
+                sort_slice_advance(&dest, -(mp_int_t)k);
+                sort_slice_advance(&a, -(mp_int_t)k);
+                sort_slice_copy(&dest, 1, &a, 1, k);
+                na -= k;
+                if (na == 0) {
+                    goto done;
+                }
+            }
+            sort_slice_move(&dest, &b, -1);
+            if (--nb == 1) {
+                goto copy_a;
+            }
+
+            gap = dest;
+            sort_slice_advance(&gap, 1 - (mp_int_t)nb);
+            sort_mark_gap(ms, &gap, &base_b, nb);
+            k = nb - sort_gallop_left(*a.keys, base_b.keys, nb, nb - 1);
+            bcount = k;
+            if (k) {
+                sort_slice_advance(&dest, -(mp_int_t)k);
+                sort_slice_advance(&b, -(mp_int_t)k);
+                sort_slice_copy(&dest, 1, &b, 1, k);
+                nb -= k;
+                if (nb == 1) {
+                    goto copy_a;
+                }
+                // only possible if the comparison is inconsistent
+                if (nb == 0) {
+                    goto done;
+                }
+            }
+            sort_slice_move(&dest, &a, -1);
+            if (--na == 0) {
+                goto done;
+            }
+        } while (acount >= SORT_MIN_GALLOP || bcount >= SORT_MIN_GALLOP);
+        min_gallop++;
+        ms->min_gallop = min_gallop;
     }
+
+done:
+    if (nb) {
+        sort_slice_copy(&dest, 1 - (mp_int_t)nb, &base_b, 0, nb);
+    }
+    ms->gap_len = 0;
+    return;
+
+copy_a:
+    // the first item of b goes before the rest of a
+    sort_slice_advance(&dest, -(mp_int_t)na);
+    sort_slice_advance(&a, -(mp_int_t)na);
+    sort_slice_copy(&dest, 1, &a, 1, na);
+    sort_slice_copy(&dest, 0, &base_b, 0, 1);
+    ms->gap_len = 0;
+}
+
+// Merge the pending runs i and i + 1.
+STATIC void sort_merge_at(sort_state_t *ms, size_t i) {
+    sort_slice_t a = sort_slice_at(ms, ms->pending[i].base);
+    size_t na = ms->pending[i].len;
+    sort_slice_t b = sort_slice_at(ms, ms->pending[i + 1].base);
+    size_t nb = ms->pending[i + 1].len;
+
+    ms->pending[i].len = na + nb;
+    if (i == ms->n_pending - 3) {
+        ms->pending[i + 1] = ms->pending[i + 2];
+    }
+    ms->n_pending--;
+
+    // items of a that are <= b[0] are already in place, as are items of b >= a[-1]
+    size_t k = sort_gallop_right(*b.keys, a.keys, na, 0);
+    sort_slice_advance(&a, k);
+    na -= k;
+    if (na == 0) {
+        return;
+    }
+    nb = sort_gallop_left(a.keys[na - 1], b.keys, nb, nb - 1);
+    if (nb == 0) {
+        return;
+    }
+    if (na <= nb) {
+        sort_merge_lo(ms, a, na, b, nb);
+    } else {
+        sort_merge_hi(ms, a, na, b, nb);
+    }
+}
+
+// Merge runs until the lengths on the stack satisfy
+//   len[-3] > len[-2] + len[-1] and len[-2] > len[-1]
+// all the way down, which bounds the depth of the stack.
+STATIC void sort_merge_collapse(sort_state_t *ms) {
+    while (ms->n_pending > 1) {
+        size_t n = ms->n_pending - 2;
+        if ((n > 0 && ms->pending[n - 1].len <= ms->pending[n].len + ms->pending[n + 1].len)
+            || (n > 1 && ms->pending[n - 2].len <= ms->pending[n - 1].len + ms->pending[n].len)) {
+            if (ms->pending[n - 1].len < ms->pending[n + 1].len) {
+                n--;
+            }
+        } else if (ms->pending[n].len > ms->pending[n + 1].len) {
+            break;
+        }
+        sort_merge_at(ms, n);
+    }
+}
+
+STATIC void sort_merge_force_collapse(sort_state_t *ms) {
+    while (ms->n_pending > 1) {
+        size_t n = ms->n_pending - 2;
+        if (n > 0 && ms->pending[n - 1].len < ms->pending[n + 1].len) {
+            n--;
+        }
+        sort_merge_at(ms, n);
+    }
+}
+
+// Shortest run worth finding: n / minrun is a power of 2 or just below one,
+// so that the final merges are balanced.
+STATIC size_t sort_min_run(size_t n) {
+    size_t r = 0;
+    while (n >= 64) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+STATIC void mp_timsort(sort_state_t *ms, size_t n) {
+    size_t min_run = sort_min_run(n);
+    size_t lo = 0;
+    while (lo < n) {
+        sort_slice_t s = sort_slice_at(ms, lo);
+        size_t remaining = n - lo;
+        size_t run = sort_count_run(&s, remaining);
+        if (run < min_run) {
+            // extend short runs to min_run items
+            size_t force = remaining <= min_run ? remaining : min_run;
+            sort_binary_insertion(s, run, force);
+            run = force;
+        }
+        ms->pending[ms->n_pending].base = lo;
+        ms->pending[ms->n_pending].len = run;
+        ms->n_pending++;
+        sort_merge_collapse(ms);
+        lo += run;
+    }
+    sort_merge_force_collapse(ms);
 }
 
-// TODO Python defines sort to be stable but ours is not
 mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_key, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_PTR(&mp_const_none_obj)} },
@@ -335,9 +857,75 @@ mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
     mp_obj_list_t *self = mp_instance_cast_to_native_base(pos_args[0], &mp_type_list);
 
     if (self->len > 1) {
-        mp_quicksort(self->items, self->items + self->len - 1,
-                     args.key.u_obj == mp_const_none ? MP_OBJ_NULL : args.key.u_obj,
-                     args.reverse.u_bool ? mp_const_false : mp_const_true);
+        // Sort the items detached from the list, so that a key function or
+        // comparison that changes the list can't pull them from under us.
+        mp_obj_t *items = self->items;
+        size_t len = self->len;
+        size_t alloc = self->alloc;
+        mp_obj_t *empty = m_new(mp_obj_t, LIST_MIN_ALLOC);
+        self->items = empty;
+        self->alloc = LIST_MIN_ALLOC;
+        self->len = 0;
+
+        sort_state_t ms;
+        // nlr_push doesn't tell the compiler that it can return twice, so the
+        // exception handler must read the sort state through this
+        sort_state_t *volatile msp = &ms;
+        ms.base.keys = items;
+        ms.base.values = NULL;
+        ms.has_values = false;
+        ms.min_gallop = SORT_MIN_GALLOP;
+        ms.tmp = NULL;
+        ms.tmp_alloc = 0;
+        ms.gap_len = 0;
+        ms.n_pending = 0;
+
+        mp_obj_t exc = MP_OBJ_NULL;
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            if (args.key.u_obj != mp_const_none) {
+                // call the key function once per item, and sort the items along with the keys
+                mp_obj_t *keys = m_new(mp_obj_t, len);
+                for (size_t i = 0; i < len; i++) {
+                    keys[i] = mp_call_function_1(args.key.u_obj, items[i]);
+                }
+                ms.base.keys = keys;
+                ms.base.values = items;
+                ms.has_values = true;
+            }
+            // reversing before and after keeps equal items in their original order
+            if (args.reverse.u_bool) {
+                sort_slice_reverse(&ms.base, len);
+            }
+            mp_timsort(&ms, len);
+            if (args.reverse.u_bool) {
+                sort_slice_reverse(&ms.base, len);
+            }
+            nlr_pop();
+        } else {
+            // leave the list with all its items, in some order
+            if (msp->gap_len > 0) {
+                sort_slice_copy(&msp->gap, 0, &msp->gap_src, 0, msp->gap_len);
+            }
+            exc = MP_OBJ_FROM_PTR(nlr.ret_val);
+        }
+
+        bool modified = self->len != 0 || self->items != empty;
+        m_del(mp_obj_t, self->items, self->alloc);
+        self->items = items;
+        self->len = len;
+        self->alloc = alloc;
+        if (msp->has_values) {
+            m_del(mp_obj_t, msp->base.keys, len);
+        }
+        m_del(mp_obj_t, msp->tmp, msp->tmp_alloc);
+
+        if (exc != MP_OBJ_NULL) {
+            nlr_jump(MP_OBJ_TO_PTR(exc));
+        }
+        if (modified) {
+            mp_raise_ValueError(translate("list modified during sort"));
+        }
     }
 
     return mp_const_none;
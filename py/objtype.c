@@ -106,9 +106,30 @@ STATIC
 mp_obj_instance_t *mp_obj_new_instance(const mp_obj_type_t *class, const mp_obj_type_t **native_base) {
     size_t num_native_bases = instance_count_native_bases(class, native_base);
     assert(num_native_bases < 2);
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    if (num_native_bases == 0) {
+        // Give the instance as many slots as the class asks for, and any that
+        // fit in the rest of the last GC block.
+        const mp_obj_class_t *cls = (const mp_obj_class_t*)class;
+        size_t n_bytes = sizeof(mp_obj_instance_t) + cls->n_slots * sizeof(mp_obj_t);
+        n_bytes = (n_bytes + MICROPY_BYTES_PER_GC_BLOCK - 1) & ~(MICROPY_BYTES_PER_GC_BLOCK - 1);
+        size_t n_slots = (n_bytes - sizeof(mp_obj_instance_t)) / sizeof(mp_obj_t);
+        mp_obj_instance_t *o = m_new_obj_var(mp_obj_instance_t, mp_obj_t, n_slots);
+        o->base.type = class;
+        o->shape = cls->shapes;
+        o->u.n_slots = n_slots;
+        return o;
+    }
+    #endif
     mp_obj_instance_t *o = m_new_obj_var(mp_obj_instance_t, mp_obj_t, num_native_bases);
     o->base.type = class;
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    o->shape = NULL;
+    o->u.members = m_new_obj(mp_map_t);
+    mp_map_init(o->u.members, 0);
+    #else
     mp_map_init(&o->members, 0);
+    #endif
     // Initialise the native base-class slot (should be 1 at most) with a valid
     // object.  It doesn't matter which object, so long as it can be uniquely
     // distinguished from a native class that is initialised.
@@ -128,6 +149,73 @@ void mp_obj_assert_native_inited(mp_obj_t native_object) {
     }
 }
 
+#if MICROPY_OPT_INSTANCE_SHAPES
+
+// Return the index of attr in shape, or shape->len if it isn't there.
+STATIC size_t shape_index(const mp_obj_shape_t *shape, qstr attr) {
+    size_t i = 0;
+    while (i < shape->len && shape->keys[i] != attr) {
+        ++i;
+    }
+    return i;
+}
+
+// Return the shape that adds attr to the given one, creating it if needed.
+// Returns NULL if the class already has too many shapes.
+STATIC mp_obj_shape_t *shape_add(mp_obj_class_t *cls, mp_obj_shape_t *shape, qstr attr) {
+    mp_obj_shape_t *child = shape->child;
+    while (child != NULL && child->keys[shape->len] != attr) {
+        child = child->sibling;
+    }
+    if (child == NULL && shape->len < MICROPY_OPT_INSTANCE_SHAPES_MAX_LEN
+        && cls->n_shapes < MICROPY_OPT_INSTANCE_SHAPES_MAX_PER_CLASS) {
+        // shapes live as long as their class
+        child = m_new_ll_obj_var_maybe(mp_obj_shape_t, qstr, shape->len + 1);
+        if (child != NULL) {
+            memcpy(child->keys, shape->keys, shape->len * sizeof(qstr));
+            child->keys[shape->len] = attr;
+            child->len = shape->len + 1;
+            child->child = NULL;
+            child->sibling = shape->child;
+            shape->child = child;
+            cls->n_shapes += 1;
+        }
+    }
+    return child;
+}
+
+// Move the members of an instance from its slots to a map.
+STATIC void instance_members_to_map(mp_obj_instance_t *self) {
+    const mp_obj_shape_t *shape = self->shape;
+    mp_map_t *map = m_new_obj(mp_map_t);
+    mp_map_init(map, shape->len);
+    for (size_t i = 0; i < shape->len; i++) {
+        mp_map_lookup(map, MP_OBJ_NEW_QSTR(shape->keys[i]), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = self->subobj[i];
+        // don't keep the old values alive
+        self->subobj[i] = MP_OBJ_NULL;
+    }
+    self->shape = NULL;
+    self->u.members = map;
+}
+
+#endif
+
+// Return the location of the value of member attr of an instance, or NULL
+// if the instance has no such member.
+STATIC mp_obj_t *instance_find_member(mp_obj_instance_t *self, qstr attr) {
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    if (self->shape != NULL) {
+        size_t i = shape_index(self->shape, attr);
+        return i < self->shape->len ? &self->subobj[i] : NULL;
+    }
+    mp_map_t *members = self->u.members;
+    #else
+    mp_map_t *members = &self->members;
+    #endif
+    mp_map_elem_t *elem = mp_map_lookup(members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+    return elem != NULL ? &elem->value : NULL;
+}
+
 // TODO
 // This implements depth-first left-to-right MRO, which is not compliant with Python3 MRO
 // http://python-history.blogspot.com/2010/06/method-resolution-order.html
@@ -148,6 +236,13 @@ struct class_lookup_data {
     size_t meth_offset;
     mp_obj_t *dest;
     bool is_type;
+    #if MICROPY_OPT_TYPE_ATTR_CACHE
+    // set on return to where the attribute was found in a locals_dict, and
+    // whether the result depended on the native base of this instance
+    const mp_obj_type_t *found_type;
+    mp_obj_t found_member;
+    bool used_native_attr;
+    #endif
 };
 
 STATIC void mp_obj_class_lookup(struct class_lookup_data  *lookup, const mp_obj_type_t *type) {
@@ -177,6 +272,10 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data  *lookup, const mp_obj_
             mp_map_t *locals_map = &type->locals_dict->map;
             mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(lookup->attr), MP_MAP_LOOKUP);
             if (elem != NULL) {
+                #if MICROPY_OPT_TYPE_ATTR_CACHE
+                lookup->found_type = type;
+                lookup->found_member = elem->value;
+                #endif
                 if (lookup->is_type) {
                     // If we look up a class method, we need to return original type for which we
                     // do a lookup, not a (base) type in which we found the class method.
@@ -203,6 +302,9 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data  *lookup, const mp_obj_
         // but some attributes of native types may be handled using .load_attr method,
         // so make sure we try to lookup those too.
         if (lookup->obj != NULL && !lookup->is_type && mp_obj_is_native_type(type) && type != &mp_type_object /* object is not a real type */) {
+            #if MICROPY_OPT_TYPE_ATTR_CACHE
+            lookup->used_native_attr = true;
+            #endif
             mp_load_method_maybe(lookup->obj->subobj[0], lookup->attr, lookup->dest);
             if (lookup->dest[0] != MP_OBJ_NULL) {
                 return;
@@ -246,6 +348,49 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data  *lookup, const mp_obj_
     }
 }
 
+#if MICROPY_OPT_TYPE_ATTR_CACHE
+STATIC void type_attr_cache_invalidate(void) {
+    if (++MP_STATE_VM(type_attr_cache_version) == 0) {
+        // don't let entries from before the wrap around become valid again
+        memset(MP_STATE_VM(type_attr_cache), 0, sizeof(MP_STATE_VM(type_attr_cache)));
+        MP_STATE_VM(type_attr_cache_version) = 1;
+    }
+}
+#endif
+
+// Look up an attribute of an instance in its class and base classes, the same
+// as mp_obj_class_lookup, but using the type attribute cache when enabled.
+STATIC void instance_class_lookup(struct class_lookup_data *lookup) {
+    const mp_obj_type_t *type = lookup->obj->base.type;
+    #if MICROPY_OPT_TYPE_ATTR_CACHE
+    assert(!lookup->is_type && lookup->meth_offset == 0);
+    mp_type_attr_cache_entry_t *entry = &MP_STATE_VM(type_attr_cache)[
+        (((uintptr_t)type >> 4) ^ lookup->attr) & (MICROPY_OPT_TYPE_ATTR_CACHE_SIZE - 1)];
+    if (entry->type == type && entry->attr == lookup->attr
+        && entry->version == MP_STATE_VM(type_attr_cache_version)) {
+        // same as the locals_dict case of mp_obj_class_lookup
+        if (MP_OBJ_IS_TYPE(entry->member, &mp_type_property)) {
+            lookup->dest[0] = entry->member;
+        } else {
+            mp_convert_member_lookup(MP_OBJ_FROM_PTR(lookup->obj), entry->found_type, entry->member, lookup->dest);
+        }
+        return;
+    }
+    lookup->found_type = NULL;
+    lookup->used_native_attr = false;
+    #endif
+    mp_obj_class_lookup(lookup, type);
+    #if MICROPY_OPT_TYPE_ATTR_CACHE
+    if (lookup->found_type != NULL && !lookup->used_native_attr) {
+        entry->type = type;
+        entry->found_type = lookup->found_type;
+        entry->member = lookup->found_member;
+        entry->version = MP_STATE_VM(type_attr_cache_version);
+        entry->attr = lookup->attr;
+    }
+    #endif
+}
+
 STATIC void instance_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
     mp_obj_instance_t *self = MP_OBJ_TO_PTR(self_in);
     qstr meth = (kind == PRINT_STR) ? MP_QSTR___str__ : MP_QSTR___repr__;
@@ -418,8 +563,16 @@ STATIC mp_obj_t instance_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
         const mp_obj_type_t *native_base;
         size_t num_native_bases = instance_count_native_bases(mp_obj_get_type(self_in), &native_base);
 
+        #if MICROPY_OPT_INSTANCE_SHAPES
+        if (self->shape != NULL) {
+            return MP_OBJ_NEW_SMALL_INT(sizeof(*self) + sizeof(*self->subobj) * self->u.n_slots);
+        }
+        size_t sz = sizeof(*self) + sizeof(*self->subobj) * num_native_bases
+            + sizeof(*self->u.members) + sizeof(*self->u.members->table) * self->u.members->alloc;
+        #else
         size_t sz = sizeof(*self) + sizeof(*self->subobj) * num_native_bases
             + sizeof(*self->members.table) * self->members.alloc;
+        #endif
         return MP_OBJ_NEW_SMALL_INT(sz);
     }
     #endif
@@ -590,10 +743,10 @@ STATIC void mp_obj_instance_load_attr(mp_obj_t self_in, qstr attr, mp_obj_t *des
     assert(mp_obj_is_instance_type(mp_obj_get_type(self_in)));
     mp_obj_instance_t *self = MP_OBJ_TO_PTR(self_in);
 
-    mp_map_elem_t *elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
-    if (elem != NULL) {
+    mp_obj_t *value = instance_find_member(self, attr);
+    if (value != NULL) {
         // object member, always treated as a value
-        dest[0] = elem->value;
+        dest[0] = *value;
         return;
     }
 #if MICROPY_CPYTHON_COMPAT
@@ -601,7 +754,19 @@ STATIC void mp_obj_instance_load_attr(mp_obj_t self_in, qstr attr, mp_obj_t *des
         // Create a new dict with a copy of the instance's map items.
         // This creates, unlike CPython, a 'read-only' __dict__: modifying
         // it will not result in modifications to the actual instance members.
+        #if MICROPY_OPT_INSTANCE_SHAPES
+        if (self->shape != NULL) {
+            mp_obj_t attr_dict = mp_obj_new_dict(self->shape->len);
+            for (size_t i = 0; i < self->shape->len; ++i) {
+                mp_obj_dict_store(attr_dict, MP_OBJ_NEW_QSTR(self->shape->keys[i]), self->subobj[i]);
+            }
+            dest[0] = attr_dict;
+            return;
+        }
+        mp_map_t *map = self->u.members;
+        #else
         mp_map_t *map = &self->members;
+        #endif
         mp_obj_t attr_dict = mp_obj_new_dict(map->used);
         for (size_t i = 0; i < map->alloc; ++i) {
             if (MP_MAP_SLOT_IS_FILLED(map, i)) {
@@ -619,7 +784,7 @@ STATIC void mp_obj_instance_load_attr(mp_obj_t self_in, qstr attr, mp_obj_t *des
         .dest = dest,
         .is_type = false,
     };
-    mp_obj_class_lookup(&lookup, self->base.type);
+    instance_class_lookup(&lookup);
     mp_obj_t member = dest[0];
     if (member != MP_OBJ_NULL) {
         // changes here may may require changes to super_attr, below
@@ -706,7 +871,7 @@ STATIC bool mp_obj_instance_store_attr(mp_obj_t self_in, qstr attr, mp_obj_t val
         .dest = member,
         .is_type = false,
     };
-    mp_obj_class_lookup(&lookup, self->base.type);
+    instance_class_lookup(&lookup);
 
     if (member[0] != MP_OBJ_NULL) {
         #if MICROPY_PY_BUILTINS_PROPERTY
@@ -798,13 +963,48 @@ STATIC bool mp_obj_instance_store_attr(mp_obj_t self_in, qstr attr, mp_obj_t val
 
 skip_special_accessors:
 
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    if (self->shape != NULL) {
+        const mp_obj_shape_t *shape = self->shape;
+        size_t i = shape_index(shape, attr);
+        if (value != MP_OBJ_NULL) {
+            if (i < shape->len) {
+                self->subobj[i] = value;
+                return true;
+            }
+            // a new member; move to the next shape if there's room for it
+            mp_obj_class_t *cls = (mp_obj_class_t*)self->base.type;
+            mp_obj_shape_t *next = shape_add(cls, (mp_obj_shape_t*)shape, attr);
+            if (next != NULL) {
+                if (i < self->u.n_slots) {
+                    self->shape = next;
+                    self->subobj[i] = value;
+                    return true;
+                }
+                // give later instances enough slots
+                if (cls->n_slots < next->len) {
+                    cls->n_slots = next->len;
+                }
+            }
+        } else if (i == shape->len) {
+            // nothing to delete
+            return false;
+        }
+        // this instance no longer fits a shape
+        instance_members_to_map(self);
+    }
+    mp_map_t *members = self->u.members;
+    #else
+    mp_map_t *members = &self->members;
+    #endif
+
     if (value == MP_OBJ_NULL) {
         // delete attribute
-        mp_map_elem_t *elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND);
+        mp_map_elem_t *elem = mp_map_lookup(members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND);
         return elem != NULL;
     } else {
         // store attribute
-        mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+        mp_map_lookup(members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
         return true;
     }
 }
@@ -1072,6 +1272,9 @@ STATIC void type_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
                 // can't apply delete/store to a fixed map
                 return;
             }
+            #if MICROPY_OPT_TYPE_ATTR_CACHE
+            type_attr_cache_invalidate();
+            #endif
             if (dest[1] == MP_OBJ_NULL) {
                 // delete attribute
                 mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND);
@@ -1149,7 +1352,17 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
         #endif
     }
 
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    mp_obj_class_t *cls = m_new0_ll(mp_obj_class_t, 1);
+    cls->shapes = m_new0_ll(mp_obj_shape_t, 1);
+    mp_obj_type_t *o = &cls->type;
+    #else
     mp_obj_type_t *o = m_new0_ll(mp_obj_type_t, 1);
+    #endif
+    #if MICROPY_OPT_TYPE_ATTR_CACHE
+    // the new type may be at the address of one that has been freed
+    type_attr_cache_invalidate();
+    #endif
     o->base.type = &mp_type_type;
     o->flags = base_flags;
     o->name = name;
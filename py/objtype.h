@@ -28,11 +28,47 @@
 
 #include "py/obj.h"
 
+#if MICROPY_OPT_INSTANCE_SHAPES
+// The names of the members of an instance, in the order they were added.
+// Instances of a class that add the same members in the same order share a
+// shape.  The shapes of a class form a tree rooted at the empty shape, where
+// each child adds one key to its parent.
+typedef struct _mp_obj_shape_t {
+    struct _mp_obj_shape_t *child; // first child
+    struct _mp_obj_shape_t *sibling; // next child of the same parent
+    size_t len;
+    qstr keys[];
+} mp_obj_shape_t;
+
+// A class defined in Python.  The instance types created by mp_obj_new_type
+// are all of this kind.
+typedef struct _mp_obj_class_t {
+    mp_obj_type_t type;
+    mp_obj_shape_t *shapes; // the empty shape
+    uint16_t n_shapes;
+    // number of slots to give new instances; it's raised whenever an
+    // instance runs out of slots
+    uint16_t n_slots;
+} mp_obj_class_t;
+#endif
+
 // instance object
 // creating an instance of a class makes one of these objects
 typedef struct _mp_obj_instance_t {
     mp_obj_base_t base;
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    // If shape is not NULL then the members of the instance are named by the
+    // keys of shape, and their values are in the same order in subobj, which
+    // has room for u.n_slots of them.  Otherwise (always, for instances with
+    // a native base) the members are in the map u.members.
+    const mp_obj_shape_t *shape;
+    union {
+        mp_map_t *members;
+        size_t n_slots;
+    } u;
+    #else
     mp_map_t members;
+    #endif
     mp_obj_t subobj[];
     // TODO maybe cache __getattr__ and __setattr__ for efficient lookup of them
 } mp_obj_instance_t;
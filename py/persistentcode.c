@@ -48,12 +48,16 @@
 #define MPY_FEATURE_FLAGS ( \
     ((MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE) << 0) \
     | ((MICROPY_PY_BUILTINS_STR_UNICODE) << 1) \
+    | ((MICROPY_OPT_SUPERINSTRUCTIONS) << 2) \
     )
 // This is a version of the flags that can be configured at runtime.
 #define MPY_FEATURE_FLAGS_DYNAMIC ( \
     ((MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC) << 0) \
     | ((MICROPY_PY_BUILTINS_STR_UNICODE_DYNAMIC) << 1) \
+    | ((MICROPY_OPT_SUPERINSTRUCTIONS_DYNAMIC) << 2) \
     )
+// Bytecode without superinstructions also runs on a VM that has them.
+#define MPY_FEATURE_SUPERINSTRUCTIONS (1 << 2)
 
 #if MICROPY_PERSISTENT_CODE_LOAD || (MICROPY_PERSISTENT_CODE_SAVE && !MICROPY_DYNAMIC_COMPILER)
 // The bytecode will depend on the number of bits in a small-int, and
@@ -234,7 +238,7 @@ mp_raw_code_t *mp_raw_code_load(mp_reader_t *reader) {
     read_bytes(reader, header, sizeof(header));
     if (header[0] != 'M'
         || header[1] != MPY_VERSION
-        || header[2] != MPY_FEATURE_FLAGS
+        || (header[2] | (MPY_FEATURE_FLAGS & MPY_FEATURE_SUPERINSTRUCTIONS)) != MPY_FEATURE_FLAGS
         || header[3] > mp_small_int_bits()) {
         mp_raise_MpyError(translate("Incompatible .mpy file. Please update all .mpy files. See http://adafru.it/mpy-update for more info."));
     }
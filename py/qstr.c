@@ -83,14 +83,18 @@
 #define QSTR_EXIT()
 #endif
 
-// this must match the equivalent function in makeqstrdata.py
-mp_uint_t qstr_compute_hash(const byte *data, size_t len) {
-    // djb2 algorithm; see http://www.cse.yorku.ca/~oz/hash.html
+// djb2 algorithm; see http://www.cse.yorku.ca/~oz/hash.html
+STATIC mp_uint_t qstr_compute_hash_full(const byte *data, size_t len) {
     mp_uint_t hash = 5381;
     for (const byte *top = data + len; data < top; data++) {
         hash = ((hash << 5) + hash) ^ (*data); // hash * 33 ^ data
     }
-    hash &= Q_HASH_MASK;
+    return hash;
+}
+
+// this must match the equivalent function in makeqstrdata.py
+mp_uint_t qstr_compute_hash(const byte *data, size_t len) {
+    mp_uint_t hash = qstr_compute_hash_full(data, len) & Q_HASH_MASK;
     // Make sure that valid hash is never zero, zero means "hash not computed"
     if (hash == 0) {
         hash++;
@@ -125,6 +129,12 @@ void qstr_init(void) {
     MP_STATE_VM(last_pool) = (qstr_pool_t*)&CONST_POOL; // we won't modify the const_pool since it has no allocated room left
     MP_STATE_VM(qstr_last_chunk) = NULL;
 
+    #if MICROPY_OPT_QSTR_HASH_INDEX
+    MP_STATE_VM(qstr_index) = NULL;
+    MP_STATE_VM(qstr_index_alloc) = 0;
+    MP_STATE_VM(qstr_index_used) = 0;
+    #endif
+
     #if MICROPY_PY_THREAD
     mp_thread_mutex_init(&MP_STATE_VM(qstr_mutex));
     #endif
@@ -141,6 +151,77 @@ STATIC const byte *find_qstr(qstr q) {
     return pool->qstrs[q - pool->total_prev_len];
 }
 
+#if MICROPY_OPT_QSTR_HASH_INDEX
+
+// The hash index is an open-addressing table (linear probing) that maps the
+// full-width djb2 hash of a string to its qstr id, so that qstr_find_strn does
+// not have to scan every pool.  It covers all pools, including the const ones,
+// and is rebuilt at twice the size whenever it becomes half full.  A slot value
+// of 0 (MP_QSTR_NULL) means the slot is empty.  If the index can't be allocated
+// then lookups fall back to the linear scan of the pools.
+
+// qstr_mutex must be taken while in this function
+STATIC void qstr_index_insert(qstr *index, size_t alloc, qstr q, mp_uint_t full_hash) {
+    size_t pos = full_hash & (alloc - 1);
+    while (index[pos] != MP_QSTR_NULL) {
+        pos = (pos + 1) & (alloc - 1);
+    }
+    index[pos] = q;
+}
+
+// qstr_mutex must be taken while in this function
+STATIC void qstr_index_rebuild(size_t n_qstr) {
+    size_t alloc = MICROPY_QSTR_HASH_INDEX_MIN;
+    while (alloc < 2 * n_qstr) {
+        alloc *= 2;
+    }
+    qstr *index = m_new_ll_maybe(qstr, alloc);
+    if (index == NULL) {
+        // drop the index and use the linear scan until the number of qstrs has
+        // doubled, so a low-memory situation doesn't retry on every new qstr
+        MP_STATE_VM(qstr_index) = NULL;
+        MP_STATE_VM(qstr_index_alloc) = 0;
+        MP_STATE_VM(qstr_index_used) = n_qstr;
+        return;
+    }
+    memset(index, 0, alloc * sizeof(qstr));
+    for (qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL; pool = pool->prev) {
+        for (size_t i = 0; i < pool->len; i++) {
+            qstr q = pool->total_prev_len + i;
+            if (q == MP_QSTR_NULL) {
+                continue;
+            }
+            const byte *qd = pool->qstrs[i];
+            qstr_index_insert(index, alloc, q, qstr_compute_hash_full(Q_GET_DATA(qd), Q_GET_LENGTH(qd)));
+        }
+    }
+    #if !MICROPY_ENABLE_GC
+    m_del(qstr, MP_STATE_VM(qstr_index), MP_STATE_VM(qstr_index_alloc));
+    #endif
+    // With the GC the old index is not freed explicitly, so that a lock-free
+    // qstr_find_strn running concurrently never probes freed memory.
+    MP_STATE_VM(qstr_index) = index;
+    MP_STATE_VM(qstr_index_alloc) = alloc;
+    MP_STATE_VM(qstr_index_used) = n_qstr;
+}
+
+// qstr_mutex must be taken while in this function
+STATIC void qstr_index_add(qstr q, const byte *q_ptr) {
+    if (MP_STATE_VM(qstr_index) == NULL) {
+        return;
+    }
+    if (2 * (MP_STATE_VM(qstr_index_used) + 1) > MP_STATE_VM(qstr_index_alloc)) {
+        // the new qstr is already in its pool so the rebuild will pick it up
+        qstr_index_rebuild(QSTR_TOTAL());
+        return;
+    }
+    qstr_index_insert(MP_STATE_VM(qstr_index), MP_STATE_VM(qstr_index_alloc), q,
+        qstr_compute_hash_full(Q_GET_DATA(q_ptr), Q_GET_LENGTH(q_ptr)));
+    MP_STATE_VM(qstr_index_used) += 1;
+}
+
+#endif // MICROPY_OPT_QSTR_HASH_INDEX
+
 // qstr_mutex must be taken while in this function
 STATIC qstr qstr_add(const byte *q_ptr) {
     DEBUG_printf("QSTR: add hash=%d len=%d data=%.*s\n", Q_GET_HASH(q_ptr), Q_GET_LENGTH(q_ptr), Q_GET_LENGTH(q_ptr), Q_GET_DATA(q_ptr));
@@ -166,14 +247,43 @@ STATIC qstr qstr_add(const byte *q_ptr) {
 
     // add the new qstr
     MP_STATE_VM(last_pool)->qstrs[MP_STATE_VM(last_pool)->len++] = q_ptr;
+    qstr q = MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len - 1;
+
+    #if MICROPY_OPT_QSTR_HASH_INDEX
+    qstr_index_add(q, q_ptr);
+    #endif
 
     // return id for the newly-added qstr
-    return MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len - 1;
+    return q;
 }
 
 qstr qstr_find_strn(const char *str, size_t str_len) {
+    #if MICROPY_OPT_QSTR_HASH_INDEX
+    // work out full hash of str, the qstr hash is its low bits
+    mp_uint_t str_hash_full = qstr_compute_hash_full((const byte*)str, str_len);
+    mp_uint_t str_hash = str_hash_full & Q_HASH_MASK;
+    if (str_hash == 0) {
+        str_hash++;
+    }
+
+    // probe the hash index, if there is one (alloc is read before the index
+    // pointer, and written after it, so a concurrent rebuild never makes the
+    // probe run past the end of the table)
+    size_t mask = MP_STATE_VM(qstr_index_alloc) - 1;
+    qstr *index = MP_STATE_VM(qstr_index);
+    if (index != NULL) {
+        for (size_t pos = str_hash_full & mask; index[pos] != MP_QSTR_NULL; pos = (pos + 1) & mask) {
+            const byte *qd = find_qstr(index[pos]);
+            if (Q_GET_HASH(qd) == str_hash && Q_GET_LENGTH(qd) == str_len && memcmp(Q_GET_DATA(qd), str, str_len) == 0) {
+                return index[pos];
+            }
+        }
+        return 0;
+    }
+    #else
     // work out hash of str
     mp_uint_t str_hash = qstr_compute_hash((const byte*)str, str_len);
+    #endif
 
     // search pools for the data
     for (qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL; pool = pool->prev) {
@@ -195,6 +305,12 @@ qstr qstr_from_str(const char *str) {
 qstr qstr_from_strn(const char *str, size_t len) {
     assert(len < (1 << (8 * MICROPY_QSTR_BYTES_IN_LEN)));
     QSTR_ENTER();
+    #if MICROPY_OPT_QSTR_HASH_INDEX
+    if (MP_STATE_VM(qstr_index) == NULL && QSTR_TOTAL() >= 2 * MP_STATE_VM(qstr_index_used)) {
+        // build the index lazily so it also covers the const pools
+        qstr_index_rebuild(QSTR_TOTAL());
+    }
+    #endif
     qstr q = qstr_find_strn(str, len);
     if (q == 0) {
         // qstr does not exist in interned pool so need to add it
@@ -24,6 +24,8 @@
  * THE SOFTWARE.
  */
 
+#include <string.h>
+
 #include "ringbuf.h"
 
 // Dynamic initialization. This should be accessible from a root pointer.
@@ -91,14 +93,19 @@ size_t ringbuf_num_filled(ringbuf_t *r) {
 // Returns how many bytes were successfully written.
 size_t ringbuf_put_n(ringbuf_t* r, uint8_t* buf, size_t bufsize)
 {
-    for(size_t i=0; i < bufsize; i++) {
-        if ( ringbuf_put(r, buf[i]) < 0 ) {
-            // If ringbuf is full, give up and return how many bytes
-            // we wrote so far.
-            return i;
-        }
+    size_t n = ringbuf_num_empty(r);
+    if (bufsize < n) {
+        n = bufsize;
     }
-    return bufsize;
+    // copy up to the end of the buffer, then wrap around
+    size_t first = r->size - r->iput;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(r->buf + r->iput, buf, first);
+    memcpy(r->buf, buf + first, n - first);
+    r->iput = (r->iput + n) % r->size;
+    return n;
 }
 
 // Returns how many bytes were fetched.
@@ -113,3 +120,18 @@ size_t ringbuf_get_n(ringbuf_t* r, uint8_t* buf, size_t bufsize)
     }
     return bufsize;
 }
+
+// Points *data at the next filled bytes that are contiguous in memory and
+// returns how many there are, so that they can be passed on without copying.
+// Remove them with ringbuf_skip_n once they have been used.
+size_t ringbuf_peek_span(ringbuf_t *r, uint8_t **data) {
+    *data = r->buf + r->iget;
+    if (r->iput >= r->iget) {
+        return r->iput - r->iget;
+    }
+    return r->size - r->iget;
+}
+
+void ringbuf_skip_n(ringbuf_t *r, size_t n) {
+    r->iget = (r->iget + n) % r->size;
+}
@@ -54,5 +54,7 @@ size_t ringbuf_num_empty(ringbuf_t *r);
 size_t ringbuf_num_filled(ringbuf_t *r);
 size_t ringbuf_put_n(ringbuf_t* r, uint8_t* buf, size_t bufsize);
 size_t ringbuf_get_n(ringbuf_t* r, uint8_t* buf, size_t bufsize);
+size_t ringbuf_peek_span(ringbuf_t *r, uint8_t **data);
+void ringbuf_skip_n(ringbuf_t *r, size_t n);
 
 #endif // MICROPY_INCLUDED_PY_RINGBUF_H
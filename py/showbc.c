@@ -240,6 +240,24 @@ const byte *mp_bytecode_print_str(const byte *ip) {
             }
             break;
 
+        case MP_BC_LOAD_FAST_FAST:
+            printf("LOAD_FAST_FAST %u %u", *ip >> 4, *ip & 0xf);
+            ip++;
+            break;
+
+        case MP_BC_BINARY_OP_FAST_FAST:
+            printf("BINARY_OP_FAST_FAST %u %u %u %s", ip[0] >> 4, ip[0] & 0xf, ip[1], qstr_str(mp_binary_op_method_name[ip[1]]));
+            ip += 2;
+            break;
+
+        case MP_BC_LOAD_FAST_ATTR:
+            DECODE_QSTR;
+            printf("LOAD_FAST_ATTR %u %s", *ip++, qstr_str(qst));
+            if (MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE) {
+                printf(" (cache=%u)", *ip++);
+            }
+            break;
+
         case MP_BC_LOAD_METHOD:
             DECODE_QSTR;
             printf("LOAD_METHOD %s", qstr_str(qst));
@@ -345,6 +363,16 @@ const byte *mp_bytecode_print_str(const byte *ip) {
             printf("POP_JUMP_IF_FALSE " UINT_FMT, (mp_uint_t)(ip + unum - mp_showbc_code_start));
             break;
 
+        case MP_BC_BINARY_OP_POP_JUMP_IF_TRUE:
+        case MP_BC_BINARY_OP_POP_JUMP_IF_FALSE: {
+            const char *cond = ip[-1] == MP_BC_BINARY_OP_POP_JUMP_IF_TRUE ? "TRUE" : "FALSE";
+            DECODE_SLABEL;
+            mp_uint_t op = *ip++;
+            printf("BINARY_OP_POP_JUMP_IF_%s " UINT_FMT " %s " UINT_FMT, cond, op,
+                qstr_str(mp_binary_op_method_name[op]), (mp_uint_t)(ip + unum - mp_showbc_code_start));
+            break;
+        }
+
         case MP_BC_JUMP_IF_TRUE_OR_POP:
             DECODE_SLABEL;
             printf("JUMP_IF_TRUE_OR_POP " UINT_FMT, (mp_uint_t)(ip + unum - mp_showbc_code_start));
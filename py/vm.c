@@ -112,6 +112,65 @@
     exc_sp--; /* pop back to previous exception handler */ \
     CLEAR_SYS_EXC_INFO() /* just clear sys.exc_info(), not compliant, but it shouldn't be used in 1st place */
 
+#if MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
+// Find the value of member attr of an instance, first trying the index that is
+// cached in the bytecode at ip, and updating that cache if needed.  Returns
+// NULL if the instance has no such member.
+static inline mp_obj_t *instance_member_cached(mp_obj_instance_t *self, qstr attr, const byte *ip) {
+    mp_uint_t x = *ip;
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    const mp_obj_shape_t *shape = self->shape;
+    if (shape != NULL) {
+        if (x >= shape->len || shape->keys[x] != attr) {
+            for (x = 0; x < shape->len && shape->keys[x] != attr; x++) {
+            }
+            if (x == shape->len) {
+                return NULL;
+            }
+            *(byte*)ip = x;
+        }
+        return &self->subobj[x];
+    }
+    mp_map_t *members = self->u.members;
+    #else
+    mp_map_t *members = &self->members;
+    #endif
+    mp_obj_t key = MP_OBJ_NEW_QSTR(attr);
+    mp_map_elem_t *elem;
+    if (x < members->alloc && members->table[x].key == key) {
+        elem = &members->table[x];
+    } else {
+        elem = mp_map_lookup(members, key, MP_MAP_LOOKUP);
+        if (elem == NULL) {
+            return NULL;
+        }
+        *(byte*)ip = elem - &members->table[0];
+    }
+    return &elem->value;
+}
+#endif
+
+#if MICROPY_OPT_SUPERINSTRUCTIONS
+// Evaluate a comparison for BINARY_OP_POP_JUMP_IF_xxx, without creating a
+// bool object when both arguments are small ints.
+static inline bool binary_op_is_true(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs) {
+    if (MP_OBJ_IS_SMALL_INT(lhs) && MP_OBJ_IS_SMALL_INT(rhs)) {
+        mp_int_t lhs_val = MP_OBJ_SMALL_INT_VALUE(lhs);
+        mp_int_t rhs_val = MP_OBJ_SMALL_INT_VALUE(rhs);
+        switch (op) {
+            case MP_BINARY_OP_LESS: return lhs_val < rhs_val;
+            case MP_BINARY_OP_MORE: return lhs_val > rhs_val;
+            case MP_BINARY_OP_EQUAL: return lhs_val == rhs_val;
+            case MP_BINARY_OP_LESS_EQUAL: return lhs_val <= rhs_val;
+            case MP_BINARY_OP_MORE_EQUAL: return lhs_val >= rhs_val;
+            case MP_BINARY_OP_NOT_EQUAL: return lhs_val != rhs_val;
+            default: break;
+        }
+    }
+    return mp_obj_is_true(mp_binary_op(op, lhs, rhs));
+}
+#endif
+
 // fastn has items in reverse order (fastn[0] is local[0], fastn[-1] is local[1], etc)
 // sp points to bottom of stack which grows up
 // returns:
@@ -268,6 +327,32 @@ dispatch_loop:
                     goto load_check;
                 }
 
+                #if MICROPY_OPT_SUPERINSTRUCTIONS
+                ENTRY(MP_BC_LOAD_FAST_FAST): {
+                    mp_obj_t obj0 = fastn[-(mp_int_t)(ip[0] >> 4)];
+                    mp_obj_t obj1 = fastn[-(mp_int_t)(ip[0] & 0xf)];
+                    ip++;
+                    if (obj0 == MP_OBJ_NULL || obj1 == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    PUSH(obj0);
+                    PUSH(obj1);
+                    DISPATCH();
+                }
+
+                ENTRY(MP_BC_BINARY_OP_FAST_FAST): {
+                    MARK_EXC_IP_SELECTIVE();
+                    mp_obj_t lhs = fastn[-(mp_int_t)(ip[0] >> 4)];
+                    mp_obj_t rhs = fastn[-(mp_int_t)(ip[0] & 0xf)];
+                    if (lhs == MP_OBJ_NULL || rhs == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    PUSH(mp_binary_op(ip[1], lhs, rhs));
+                    ip += 2;
+                    DISPATCH();
+                }
+                #endif
+
                 #if !MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
                 ENTRY(MP_BC_LOAD_NAME): {
                     MARK_EXC_IP_SELECTIVE();
@@ -339,31 +424,43 @@ dispatch_loop:
                     DECODE_QSTR;
                     mp_obj_t top = TOP();
                     if (mp_obj_is_instance_type(mp_obj_get_type(top))) {
-                        mp_obj_instance_t *self = MP_OBJ_TO_PTR(top);
-                        mp_uint_t x = *ip;
-                        mp_obj_t key = MP_OBJ_NEW_QSTR(qst);
-                        mp_map_elem_t *elem;
-                        if (x < self->members.alloc && self->members.table[x].key == key) {
-                            elem = &self->members.table[x];
-                        } else {
-                            elem = mp_map_lookup(&self->members, key, MP_MAP_LOOKUP);
-                            if (elem != NULL) {
-                                *(byte*)ip = elem - &self->members.table[0];
-                            } else {
-                                goto load_attr_cache_fail;
-                            }
+                        mp_obj_t *value = instance_member_cached(MP_OBJ_TO_PTR(top), qst, ip);
+                        if (value != NULL) {
+                            SET_TOP(*value);
+                            ip++;
+                            DISPATCH();
                         }
-                        SET_TOP(elem->value);
-                        ip++;
-                        DISPATCH();
                     }
-                load_attr_cache_fail:
                     SET_TOP(mp_load_attr(top, qst));
                     ip++;
                     DISPATCH();
                 }
                 #endif
 
+                #if MICROPY_OPT_SUPERINSTRUCTIONS
+                ENTRY(MP_BC_LOAD_FAST_ATTR): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_QSTR;
+                    mp_obj_t obj = fastn[-(mp_int_t)*ip++];
+                    if (obj == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    #if MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
+                    if (mp_obj_is_instance_type(mp_obj_get_type(obj))) {
+                        mp_obj_t *value = instance_member_cached(MP_OBJ_TO_PTR(obj), qst, ip);
+                        if (value != NULL) {
+                            PUSH(*value);
+                            ip++;
+                            DISPATCH();
+                        }
+                    }
+                    ip++;
+                    #endif
+                    PUSH(mp_load_attr(obj, qst));
+                    DISPATCH();
+                }
+                #endif
+
                 ENTRY(MP_BC_LOAD_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
@@ -437,26 +534,14 @@ dispatch_loop:
                     DECODE_QSTR;
                     mp_obj_t top = TOP();
                     if (mp_obj_is_instance_type(mp_obj_get_type(top)) && sp[-1] != MP_OBJ_NULL) {
-                        mp_obj_instance_t *self = MP_OBJ_TO_PTR(top);
-                        mp_uint_t x = *ip;
-                        mp_obj_t key = MP_OBJ_NEW_QSTR(qst);
-                        mp_map_elem_t *elem;
-                        if (x < self->members.alloc && self->members.table[x].key == key) {
-                            elem = &self->members.table[x];
-                        } else {
-                            elem = mp_map_lookup(&self->members, key, MP_MAP_LOOKUP);
-                            if (elem != NULL) {
-                                *(byte*)ip = elem - &self->members.table[0];
-                            } else {
-                                goto store_attr_cache_fail;
-                            }
+                        mp_obj_t *value = instance_member_cached(MP_OBJ_TO_PTR(top), qst, ip);
+                        if (value != NULL) {
+                            *value = sp[-1];
+                            sp -= 2;
+                            ip++;
+                            DISPATCH();
                         }
-                        elem->value = sp[-1];
-                        sp -= 2;
-                        ip++;
-                        DISPATCH();
                     }
-                store_attr_cache_fail:
                     mp_store_attr(sp[0], qst, sp[-1]);
                     sp -= 2;
                     ip++;
@@ -557,6 +642,22 @@ dispatch_loop:
                     DISPATCH_WITH_PEND_EXC_CHECK();
                 }
 
+                #if MICROPY_OPT_SUPERINSTRUCTIONS
+                ENTRY(MP_BC_BINARY_OP_POP_JUMP_IF_TRUE):
+                ENTRY(MP_BC_BINARY_OP_POP_JUMP_IF_FALSE): {
+                    MARK_EXC_IP_SELECTIVE();
+                    bool jump_if = ip[-1] == MP_BC_BINARY_OP_POP_JUMP_IF_TRUE;
+                    DECODE_SLABEL;
+                    mp_binary_op_t op = *ip++;
+                    mp_obj_t rhs = POP();
+                    mp_obj_t lhs = POP();
+                    if (binary_op_is_true(op, lhs, rhs) == jump_if) {
+                        ip += slab;
+                    }
+                    DISPATCH_WITH_PEND_EXC_CHECK();
+                }
+                #endif
+
                 ENTRY(MP_BC_JUMP_IF_TRUE_OR_POP): {
                     DECODE_SLABEL;
                     if (mp_obj_is_true(TOP())) {
@@ -42,9 +42,16 @@ static const void *const PLACE_IN_DTCM_DATA(entry_table[256]) = {
     [MP_BC_LOAD_NULL] = &&entry_MP_BC_LOAD_NULL,
     [MP_BC_LOAD_FAST_N] = &&entry_MP_BC_LOAD_FAST_N,
     [MP_BC_LOAD_DEREF] = &&entry_MP_BC_LOAD_DEREF,
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    [MP_BC_LOAD_FAST_FAST] = &&entry_MP_BC_LOAD_FAST_FAST,
+    [MP_BC_BINARY_OP_FAST_FAST] = &&entry_MP_BC_BINARY_OP_FAST_FAST,
+    #endif
     [MP_BC_LOAD_NAME] = &&entry_MP_BC_LOAD_NAME,
     [MP_BC_LOAD_GLOBAL] = &&entry_MP_BC_LOAD_GLOBAL,
     [MP_BC_LOAD_ATTR] = &&entry_MP_BC_LOAD_ATTR,
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    [MP_BC_LOAD_FAST_ATTR] = &&entry_MP_BC_LOAD_FAST_ATTR,
+    #endif
     [MP_BC_LOAD_METHOD] = &&entry_MP_BC_LOAD_METHOD,
     [MP_BC_LOAD_SUPER_METHOD] = &&entry_MP_BC_LOAD_SUPER_METHOD,
     [MP_BC_LOAD_BUILD_CLASS] = &&entry_MP_BC_LOAD_BUILD_CLASS,
@@ -67,6 +74,10 @@ static const void *const PLACE_IN_DTCM_DATA(entry_table[256]) = {
     [MP_BC_JUMP] = &&entry_MP_BC_JUMP,
     [MP_BC_POP_JUMP_IF_TRUE] = &&entry_MP_BC_POP_JUMP_IF_TRUE,
     [MP_BC_POP_JUMP_IF_FALSE] = &&entry_MP_BC_POP_JUMP_IF_FALSE,
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    [MP_BC_BINARY_OP_POP_JUMP_IF_TRUE] = &&entry_MP_BC_BINARY_OP_POP_JUMP_IF_TRUE,
+    [MP_BC_BINARY_OP_POP_JUMP_IF_FALSE] = &&entry_MP_BC_BINARY_OP_POP_JUMP_IF_FALSE,
+    #endif
     [MP_BC_JUMP_IF_TRUE_OR_POP] = &&entry_MP_BC_JUMP_IF_TRUE_OR_POP,
     [MP_BC_JUMP_IF_FALSE_OR_POP] = &&entry_MP_BC_JUMP_IF_FALSE_OR_POP,
     [MP_BC_SETUP_WITH] = &&entry_MP_BC_SETUP_WITH,
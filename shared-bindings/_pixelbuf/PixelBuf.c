@@ -38,11 +38,6 @@
 
 #include "shared-bindings/_pixelbuf/PixelBuf.h"
 #include "shared-module/_pixelbuf/PixelBuf.h"
-#include "shared-bindings/digitalio/DigitalInOut.h"
-
-#ifdef CIRCUITPY_ULAB
-#include "extmod/ulab/code/ndarray.h"
-#endif
 
 extern const int32_t colorwheel(float pos);
 
@@ -176,7 +171,8 @@ const mp_obj_property_t pixelbuf_pixelbuf_bpp_obj = {
 //|     """Float value between 0 and 1.  Output brightness.
 //|
 //|     When brightness is less than 1.0, a second buffer will be used to store the color values
-//|     before they are adjusted for brightness."""
+//|     before they are adjusted for brightness. Each color value is adjusted through a table that
+//|     is rebuilt when brightness or `gamma` changes."""
 //|
 STATIC mp_obj_t pixelbuf_pixelbuf_obj_get_brightness(mp_obj_t self_in) {
     return mp_obj_new_float(common_hal__pixelbuf_pixelbuf_get_brightness(self_in));
@@ -203,6 +199,34 @@ const mp_obj_property_t pixelbuf_pixelbuf_brightness_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|     gamma: float
+//|     """Gamma correction exponent applied to each color value before brightness. 1.0 (the
+//|     default) outputs colors linearly. Values above 1.0, such as 2.6, make mid-range colors look
+//|     more even on LEDs. Like `brightness`, values other than 1.0 use a second buffer."""
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_obj_get_gamma(mp_obj_t self_in) {
+    return mp_obj_new_float(common_hal__pixelbuf_pixelbuf_get_gamma(self_in));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(pixelbuf_pixelbuf_get_gamma_obj, pixelbuf_pixelbuf_obj_get_gamma);
+
+
+STATIC mp_obj_t pixelbuf_pixelbuf_obj_set_gamma(mp_obj_t self_in, mp_obj_t value) {
+    mp_float_t gamma = mp_obj_get_float(value);
+    if (gamma <= 0) {
+        mp_raise_ValueError_varg(translate("Invalid %q"), MP_QSTR_gamma);
+    }
+    common_hal__pixelbuf_pixelbuf_set_gamma(self_in, gamma);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_set_gamma_obj, pixelbuf_pixelbuf_obj_set_gamma);
+
+const mp_obj_property_t pixelbuf_pixelbuf_gamma_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&pixelbuf_pixelbuf_get_gamma_obj,
+              (mp_obj_t)&pixelbuf_pixelbuf_set_gamma_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 //|     auto_write: bool
 //|     """Whether to automatically write the pixels after each update."""
 //|
@@ -273,6 +297,51 @@ STATIC mp_obj_t pixelbuf_pixelbuf_fill(mp_obj_t self_in, mp_obj_t value) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_fill_obj, pixelbuf_pixelbuf_fill);
 
+//|     def load(self, buffer: ReadableBuffer, *, byteorder: str = "RGB", start: int = 0) -> None:
+//|         """Sets consecutive pixels from packed color bytes in one pass, starting at ``start``.
+//|         This is much faster than assigning tuples or ints for large numbers of pixels.
+//|
+//|         ``byteorder`` describes the bytes of each pixel in ``buffer`` and may differ from the
+//|         PixelBuf's own `byteorder`. A ``W`` byte sets white and a leading ``P`` byte sets the
+//|         DotStar brightness (0-255). As with RGB tuples, RGBW pixels given equal red, green and
+//|         blue values are shown using white instead.
+//|
+//|         :param ~_typing.ReadableBuffer buffer: Packed pixel bytes, such as from a `bytearray` or `array.array`
+//|         :param str byteorder: Byte order of each pixel in ``buffer`` (such as "RGB", "RGBW" or "PBGR")
+//|         :param int start: Index of the first pixel to set"""
+//|         ...
+//|
+
+STATIC mp_obj_t pixelbuf_pixelbuf_load(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_byteorder, ARG_start };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_byteorder, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = MP_OBJ_NEW_QSTR(MP_QSTR_RGB) } },
+        { MP_QSTR_start, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = 0 } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    pixelbuf_byteorder_details_t byteorder_details;
+    parse_byteorder(args[ARG_byteorder].u_obj, &byteorder_details);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_READ);
+
+    if (bufinfo.len % byteorder_details.bpp != 0) {
+        mp_raise_ValueError(translate("bytes length not a multiple of item size"));
+    }
+    size_t pixel_count = bufinfo.len / byteorder_details.bpp;
+    mp_int_t start = args[ARG_start].u_int;
+    size_t length = common_hal__pixelbuf_pixelbuf_get_len(pos_args[0]);
+    if (start < 0 || (size_t)start > length || pixel_count > length - start) {
+        mp_raise_IndexError_varg(translate("%q index out of range"), MP_QSTR_PixelBuf);
+    }
+    common_hal__pixelbuf_pixelbuf_load(pos_args[0], start, bufinfo.buf, pixel_count, &byteorder_details);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(pixelbuf_pixelbuf_load_obj, 2, pixelbuf_pixelbuf_load);
+
 //|     @overload
 //|     def __getitem__(self, index: slice) -> Union[Tuple[Tuple[int, int, int], ...], Tuple[Tuple[int, int, int, float], ...]]: ...
 //|     @overload
@@ -371,8 +440,10 @@ STATIC const mp_rom_map_elem_t pixelbuf_pixelbuf_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_bpp), MP_ROM_PTR(&pixelbuf_pixelbuf_bpp_obj)},
     { MP_ROM_QSTR(MP_QSTR_brightness), MP_ROM_PTR(&pixelbuf_pixelbuf_brightness_obj)},
     { MP_ROM_QSTR(MP_QSTR_byteorder), MP_ROM_PTR(&pixelbuf_pixelbuf_byteorder_str)},
+    { MP_ROM_QSTR(MP_QSTR_gamma), MP_ROM_PTR(&pixelbuf_pixelbuf_gamma_obj)},
     { MP_ROM_QSTR(MP_QSTR_show), MP_ROM_PTR(&pixelbuf_pixelbuf_show_obj)},
     { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&pixelbuf_pixelbuf_fill_obj)},
+    { MP_ROM_QSTR(MP_QSTR_load), MP_ROM_PTR(&pixelbuf_pixelbuf_load_obj)},
 };
 
 STATIC MP_DEFINE_CONST_DICT(pixelbuf_pixelbuf_locals_dict, pixelbuf_pixelbuf_locals_dict_table);
@@ -27,7 +27,7 @@
 #ifndef CP_SHARED_BINDINGS_PIXELBUF_INIT_H
 #define CP_SHARED_BINDINGS_PIXELBUF_INIT_H
 
-#include "common-hal/digitalio/DigitalInOut.h"
+#include <stdint.h>
 
 const int32_t colorwheel(float pos);
 
@@ -30,7 +30,6 @@
 #include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
-#include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/util.h"
 #include "shared-bindings/audiocore/RawSample.h"
 #include "supervisor/shared/translate.h"
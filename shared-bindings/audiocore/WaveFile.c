@@ -37,14 +37,17 @@
 //|     """Load a wave file for audio playback
 //|
 //|     A .wav file prepped for audio playback. Only mono and stereo files are supported. Samples must
-//|     be 8 bit unsigned or 16 bit signed. If a buffer is provided, it will be used instead of allocating
-//|     an internal buffer."""
+//|     be 8 bit unsigned, 16 bit signed or 4 bit IMA-ADPCM, which is decoded to 16 bit signed as it
+//|     plays. If a buffer is provided, it will be used instead of allocating an internal buffer.
+//|
+//|     The file is read ahead of playback in the background, into a ring of buffers, so that slow
+//|     storage doesn't interrupt the audio."""
 //|
 //|     def __init__(self, file: typing.BinaryIO, buffer: WriteableBuffer) -> None:
 //|         """Load a .wav file for playback with `audioio.AudioOut` or `audiobusio.I2SOut`.
 //|
 //|         :param typing.BinaryIO file: Already opened wave file
-//|         :param ~_typing.WriteableBuffer buffer: Optional pre-allocated buffer, that will be split in half and used for double-buffering of the data. If not provided, two 512 byte buffers are allocated internally.
+//|         :param ~_typing.WriteableBuffer buffer: Optional pre-allocated buffer, that will be split into equal parts and used as the ring of buffers for the data. If not provided, a ring of 256 byte buffers is allocated internally.
 //|
 //|
 //|         Playing a wave file from flash::
@@ -74,7 +77,7 @@ STATIC mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_ar
 
     audioio_wavefile_obj_t *self = m_new_obj(audioio_wavefile_obj_t);
     self->base.type = &audioio_wavefile_type;
-    if (!MP_OBJ_IS_TYPE(args[0], &mp_type_fileio)) {
+    if (!MP_OBJ_IS_TYPE(args[0], &mp_type_vfs_fat_fileio)) {
         mp_raise_TypeError(translate("file must be a file opened in byte mode"));
     }
     uint8_t *buffer = NULL;
@@ -29,7 +29,6 @@
 #include "py/obj.h"
 #include "py/runtime.h"
 
-#include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/audiocore/__init__.h"
 #include "shared-bindings/audiocore/RawSample.h"
 #include "shared-bindings/audiocore/WaveFile.h"
@@ -33,7 +33,6 @@
 #include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
-#include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/audiocore/RawSample.h"
 #include "shared-bindings/util.h"
 #include "supervisor/shared/translate.h"
@@ -42,7 +41,8 @@
 //|     """Mixes one or more audio samples together into one sample."""
 //|
 //|     def __init__(self, voice_count: int = 2, buffer_size: int = 1024, channel_count: int = 2, bits_per_sample: int = 16, samples_signed: bool = True, sample_rate: int = 8000) -> None:
-//|         """Create a Mixer object that can mix multiple channels with the same sample rate.
+//|         """Create a Mixer object that can mix multiple channels. Samples with other sample rates
+//|         are linearly resampled to the mixer's as they are played.
 //|         Samples are accessed and controlled with the mixer's `audiomixer.MixerVoice` objects.
 //|
 //|         :param int voice_count: The maximum number of voices to mix
@@ -50,7 +50,7 @@
 //|         :param int channel_count: The number of channels the source samples contain. 1 = mono; 2 = stereo.
 //|         :param int bits_per_sample: The bits per sample of the samples being played
 //|         :param bool samples_signed: Samples are signed (True) or unsigned (False)
-//|         :param int sample_rate: The sample rate to be used for all samples
+//|         :param int sample_rate: The sample rate of the mixed output
 //|
 //|         Playing a wave file from flash::
 //|
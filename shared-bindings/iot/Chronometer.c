@@ -67,6 +67,8 @@
 //|     print("Elapsed time: {} seconds".format(chrono.elapsed_time)
 //|
 STATIC mp_obj_t iot_chronometer_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    (void)pos_args;
     mp_arg_check_num(n_args, kw_args, 0, 0, false);
 
     iot_chronometer_obj_t *self = m_new_obj(iot_chronometer_obj_t);
@@ -0,0 +1,359 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2021 MicroPython & CircuitPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "py/mperrno.h"
+#include "py/mphal.h"
+#include "py/objtuple.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+
+#include "supervisor/shared/translate.h"
+#include "shared-bindings/iot/EventLoop.h"
+#include "shared-bindings/iot/Ticker.h"
+#include "shared-bindings/iot/TimeQueue.h"
+#include "shared-bindings/time/__init__.h"
+
+//| .. currentmodule:: iot
+//|
+//| :class:`EventLoop` -- Run coroutines on timers and stream readiness
+//| ====================================================================================
+//|
+//| EventLoop runs generator based coroutines and callbacks from a `TimeQueue`.
+//| Between them it sleeps until the next one is due. While coroutines wait for
+//| streams, ports that can block until a stream is ready (such as unix, with
+//| ``poll()``) do so. Other ports check the streams every millisecond instead.
+//|
+//| A coroutine controls when it runs next with the value it yields:
+//|
+//| * ``None``: after the other tasks that are due.
+//| * a number: after that many seconds.
+//| * a `Ticker`: at the ticker's next time.
+//| * ``loop.readable(stream)`` or ``loop.writable(stream)``: when the stream
+//|   can be read or written. Streams are checked with their stream protocol
+//|   ioctl, so this works without ``uselect``.
+//|
+//| Exceptions raised by a task or callback propagate out of `run`.
+//|
+//| Example::
+//|
+//|   def echo(loop, sock):
+//|       while True:
+//|           yield loop.readable(sock)
+//|           sock.write(sock.read(64))
+//|
+//|   loop = iot.EventLoop()
+//|   loop.create_task(echo(loop, sock))
+//|   loop.run()
+//|
+//| .. class:: EventLoop(max_tasks=16)
+//|
+//|   Create an EventLoop.
+//|
+//|   param int max_tasks: maximum number of tasks and callbacks waiting for a time.
+//|
+STATIC mp_obj_t iot_event_loop_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    enum { ARG_max_tasks };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_max_tasks, MP_ARG_INT, {.u_int = 16} },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    mp_int_t max_tasks = args[ARG_max_tasks].u_int;
+    if (max_tasks < 1) max_tasks = 1;
+
+    iot_event_loop_obj_t *self = m_new_obj(iot_event_loop_obj_t);
+    self->base.type = &iot_event_loop_type;
+    self->queue = iot_time_queue_new(max_tasks);
+    mp_map_init(&self->readers, 0);
+    mp_map_init(&self->writers, 0);
+    self->wait_stream = MP_OBJ_NULL;
+    self->wait_event = 0;
+    self->running = false;
+    self->stopped = false;
+    return MP_OBJ_FROM_PTR(self);
+}
+
+STATIC uint64_t time_after(mp_obj_t delay) {
+    uint64_t now = common_hal_time_monotonic_ns();
+    uint64_t time = iot_time_queue_time_after(delay);
+    // a task never goes before the ones already due
+    return (int64_t)(time - now) < 0 ? now : time;
+}
+
+//|   .. method:: create_task(coro)
+//|
+//|     Schedule a coroutine to start running.
+//|
+//|   param generator coro: coroutine to run.
+//|
+//|   return generator: coro.
+//|
+STATIC mp_obj_t iot_event_loop_create_task(mp_obj_t self_in, mp_obj_t coro) {
+    iot_event_loop_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    iot_time_queue_push(self->queue, common_hal_time_monotonic_ns(), coro);
+    return coro;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(iot_event_loop_create_task_obj, iot_event_loop_create_task);
+
+//|   .. method:: call_later(delay, callback)
+//|
+//|     Call callback without arguments after delay, or start a coroutine then.
+//|
+//|   param float delay: time in seconds.
+//|   param object callback: function or coroutine.
+//|
+STATIC mp_obj_t iot_event_loop_call_later(mp_obj_t self_in, mp_obj_t delay, mp_obj_t callback) {
+    iot_event_loop_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    iot_time_queue_push(self->queue, time_after(delay), callback);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(iot_event_loop_call_later_obj, iot_event_loop_call_later);
+
+STATIC mp_obj_t event_loop_wait_for(mp_obj_t self_in, mp_obj_t stream, mp_uint_t event) {
+    iot_event_loop_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    // raise now rather than when the loop polls the stream
+    mp_get_stream_raise(stream, MP_STREAM_OP_IOCTL);
+    mp_map_t *waiters = event == MP_STREAM_POLL_RD ? &self->readers : &self->writers;
+    if (mp_map_lookup(waiters, mp_obj_id(stream), MP_MAP_LOOKUP) != NULL) {
+        // another task is already waiting for it
+        mp_raise_OSError(MP_EBUSY);
+    }
+    self->wait_stream = stream;
+    self->wait_event = event;
+    return self_in;
+}
+
+//|   .. method:: readable(stream)
+//|
+//|     Yield the result from a coroutine to run it again once stream has data
+//|     to read (or is closed). Only one coroutine can wait to read a stream.
+//|
+//|   param object stream: socket or other stream that supports polling.
+//|
+STATIC mp_obj_t iot_event_loop_readable(mp_obj_t self_in, mp_obj_t stream) {
+    return event_loop_wait_for(self_in, stream, MP_STREAM_POLL_RD);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(iot_event_loop_readable_obj, iot_event_loop_readable);
+
+//|   .. method:: writable(stream)
+//|
+//|     Yield the result from a coroutine to run it again once stream can
+//|     be written. Only one coroutine can wait to write a stream.
+//|
+//|   param object stream: socket or other stream that supports polling.
+//|
+STATIC mp_obj_t iot_event_loop_writable(mp_obj_t self_in, mp_obj_t stream) {
+    return event_loop_wait_for(self_in, stream, MP_STREAM_POLL_WR);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(iot_event_loop_writable_obj, iot_event_loop_writable);
+
+STATIC void event_loop_park(iot_event_loop_obj_t *self, mp_obj_t task) {
+    mp_map_t *waiters = self->wait_event == MP_STREAM_POLL_RD ? &self->readers : &self->writers;
+    mp_obj_t waiter[2] = {self->wait_stream, task};
+    mp_map_lookup(waiters, mp_obj_id(self->wait_stream), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value =
+        mp_obj_new_tuple(2, waiter);
+    self->wait_stream = MP_OBJ_NULL;
+}
+
+STATIC void event_loop_run_task(iot_event_loop_obj_t *self, mp_obj_t task) {
+    if (mp_obj_is_callable(task)) {
+        mp_call_function_0(task);
+        return;
+    }
+    self->wait_stream = MP_OBJ_NULL;
+    mp_obj_t ret;
+    switch (mp_resume(task, mp_const_none, MP_OBJ_NULL, &ret)) {
+        case MP_VM_RETURN_NORMAL:
+            return;
+        case MP_VM_RETURN_EXCEPTION:
+            self->wait_stream = MP_OBJ_NULL;
+            nlr_raise(ret);
+        default:
+            break;
+    }
+    uint64_t time;
+    if (ret == MP_OBJ_FROM_PTR(self) && self->wait_stream != MP_OBJ_NULL) {
+        event_loop_park(self, task);
+        return;
+    } else if (ret == mp_const_none || ret == MP_OBJ_FROM_PTR(self)) {
+        time = common_hal_time_monotonic_ns();
+    } else if (MP_OBJ_IS_TYPE(ret, &iot_ticker_type)) {
+        iot_ticker_obj_t *ticker = MP_OBJ_TO_PTR(ret);
+        uint64_t now = common_hal_time_monotonic_ns();
+        // same as Ticker.next_time
+        while (ticker->period > 0 && ticker->start_time < now) ticker->start_time += ticker->period;
+        time = ticker->start_time;
+    } else {
+        time = time_after(ret);
+    }
+    iot_time_queue_push(self->queue, time, task);
+}
+
+// Queues the tasks in waiters whose stream is ready for event, or has failed, asking
+// each stream with the MP_STREAM_POLL ioctl like extmod/moduselect.c. Returns whether
+// there were any.
+STATIC bool event_loop_wake(iot_event_loop_obj_t *self, mp_map_t *waiters, mp_uint_t event, uint64_t now) {
+    bool woke = false;
+    for (size_t i = 0; i < waiters->alloc; i++) {
+        if (!MP_MAP_SLOT_IS_FILLED(waiters, i)) {
+            continue;
+        }
+        mp_obj_tuple_t *waiter = MP_OBJ_TO_PTR(waiters->table[i].value);
+        mp_obj_t stream = waiter->items[0];
+        int errcode;
+        mp_uint_t ret = mp_get_stream(stream)->ioctl(stream, MP_STREAM_POLL, event, &errcode);
+        if (ret == MP_STREAM_ERROR) {
+            // let the task find out about the error when it uses the stream
+            ret = MP_STREAM_POLL_ERR;
+        }
+        if (ret & (event | MP_STREAM_POLL_ERR | MP_STREAM_POLL_HUP)) {
+            iot_time_queue_push(self->queue, now, waiter->items[1]);
+            // removing leaves the other slots where they are
+            mp_map_lookup(waiters, waiters->table[i].key, MP_MAP_LOOKUP_REMOVE_IF_FOUND);
+            woke = true;
+        }
+    }
+    return woke;
+}
+
+MP_WEAK bool iot_event_loop_wait_streams(mp_map_t *readers, mp_map_t *writers, mp_int_t timeout_ms) {
+    (void)readers;
+    (void)writers;
+    (void)timeout_ms;
+    return false;
+}
+
+// Waits up to timeout_ms (forever if negative) for streams and queues the tasks waiting for them.
+// Unless the port can block until a stream is ready, they are checked every millisecond.
+STATIC void event_loop_poll(iot_event_loop_obj_t *self, mp_int_t timeout_ms) {
+    if (iot_event_loop_wait_streams(&self->readers, &self->writers, timeout_ms)) {
+        uint64_t now = common_hal_time_monotonic_ns();
+        event_loop_wake(self, &self->readers, MP_STREAM_POLL_RD, now);
+        event_loop_wake(self, &self->writers, MP_STREAM_POLL_WR, now);
+        return;
+    }
+    uint64_t deadline = common_hal_time_monotonic_ns() + (uint64_t)timeout_ms * 1000000;
+    for (;;) {
+        uint64_t now = common_hal_time_monotonic_ns();
+        bool woke = event_loop_wake(self, &self->readers, MP_STREAM_POLL_RD, now);
+        woke |= event_loop_wake(self, &self->writers, MP_STREAM_POLL_WR, now);
+        if (woke || (timeout_ms >= 0 && now >= deadline)) {
+            return;
+        }
+        mp_hal_delay_ms(1);
+        mp_handle_pending();
+    }
+}
+
+STATIC void event_loop_run(iot_event_loop_obj_t *self) {
+    mp_obj_time_queue_t *queue = self->queue;
+    while (!self->stopped) {
+        bool waiting = self->readers.used + self->writers.used > 0;
+        if (queue->len == 0 && !waiting) {
+            break;
+        }
+        // Run everything due now. Tasks that yield None are queued after now, so
+        // they run after streams have been checked.
+        uint64_t now = common_hal_time_monotonic_ns();
+        while (queue->len > 0 && queue->items[0].time <= now && !self->stopped) {
+            event_loop_run_task(self, iot_time_queue_pop(queue));
+        }
+        if (self->stopped) {
+            break;
+        }
+        // Sleep until the next task is due or a stream is ready. Round up to the millisecond
+        // resolution of event_loop_poll() and mp_hal_delay_ms() so tasks never wake early and spin.
+        mp_int_t timeout_ms = -1;
+        if (queue->len > 0) {
+            now = common_hal_time_monotonic_ns();
+            uint64_t next = queue->items[0].time;
+            timeout_ms = next > now ? (next - now + 999999) / 1000000 : 0;
+        }
+        if (self->readers.used + self->writers.used > 0) {
+            event_loop_poll(self, timeout_ms);
+        } else if (timeout_ms > 0) {
+            mp_hal_delay_ms(timeout_ms);
+        }
+    }
+}
+
+//|   .. method:: run()
+//|
+//|     Run tasks and callbacks until `stop` is called or none are left,
+//|     either queued or waiting for a stream.
+//|
+STATIC mp_obj_t iot_event_loop_run(mp_obj_t self_in) {
+    iot_event_loop_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->running) {
+        mp_raise_RuntimeError(translate("Already running"));
+    }
+    self->running = true;
+    self->stopped = false;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        event_loop_run(self);
+        nlr_pop();
+    } else {
+        self->running = false;
+        nlr_jump(nlr.ret_val);
+    }
+    self->running = false;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(iot_event_loop_run_obj, iot_event_loop_run);
+
+//|   .. method:: stop()
+//|
+//|     Make `run` return once the running task or callback yields or returns.
+//|
+STATIC mp_obj_t iot_event_loop_stop(mp_obj_t self_in) {
+    iot_event_loop_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    self->stopped = true;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(iot_event_loop_stop_obj, iot_event_loop_stop);
+
+STATIC const mp_rom_map_elem_t iot_event_loop_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_create_task), MP_ROM_PTR(&iot_event_loop_create_task_obj) },
+    { MP_ROM_QSTR(MP_QSTR_call_later), MP_ROM_PTR(&iot_event_loop_call_later_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readable), MP_ROM_PTR(&iot_event_loop_readable_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writable), MP_ROM_PTR(&iot_event_loop_writable_obj) },
+    { MP_ROM_QSTR(MP_QSTR_run), MP_ROM_PTR(&iot_event_loop_run_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&iot_event_loop_stop_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(iot_event_loop_locals_dict, iot_event_loop_locals_dict_table);
+
+const mp_obj_type_t iot_event_loop_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_EventLoop,
+    .make_new = iot_event_loop_make_new,
+    .locals_dict = (mp_obj_dict_t*)&iot_event_loop_locals_dict,
+};
@@ -0,0 +1,56 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2021 MicroPython & CircuitPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_IOT_EVENT_LOOP_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_IOT_EVENT_LOOP_H
+
+#include "py/obj.h"
+#include "shared-bindings/iot/TimeQueue.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    // Tasks and callbacks that are due, or sleeping until a time.
+    mp_obj_time_queue_t *queue;
+    // (stream, task) tuples of the tasks waiting for a stream, keyed by the id
+    // of the stream, as streams needn't be hashable.
+    mp_map_t readers;
+    mp_map_t writers;
+    // Set by readable() and writable() until the running task yields.
+    mp_obj_t wait_stream;
+    mp_uint_t wait_event;
+    bool running;
+    bool stopped;
+} iot_event_loop_obj_t;
+
+extern const mp_obj_type_t iot_event_loop_type;
+
+// Waits up to timeout_ms (forever if negative) until one of the streams in readers can be
+// read or one in writers can be written, as EventLoop stores them. Ports that can block
+// until then implement this and return true once they have waited. The default returns
+// false, and EventLoop checks the streams itself.
+bool iot_event_loop_wait_streams(mp_map_t *readers, mp_map_t *writers, mp_int_t timeout_ms);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_IOT_EVENT_LOOP_H
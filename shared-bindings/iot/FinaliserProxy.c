@@ -59,6 +59,7 @@
 
 
 STATIC mp_obj_t iot_finaliser_proxy_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
     enum { ARG_callback };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_callback, MP_ARG_OBJ | MP_ARG_REQUIRED },
@@ -50,6 +50,7 @@
 //|   param float offset: start time (default: now).
 //|
 STATIC mp_obj_t iot_ticker_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
     enum { ARG_period, ARG_offset };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_period, MP_ARG_OBJ | MP_ARG_REQUIRED },
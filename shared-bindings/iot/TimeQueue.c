@@ -33,24 +33,13 @@
 #include "py/smallint.h"
 
 #include "supervisor/shared/translate.h"
+#include "shared-bindings/iot/TimeQueue.h"
 #include "shared-bindings/time/__init__.h"
 
 #define DEBUG 0
 
 // the algorithm here is modelled on CPython's heapq.py
 
-struct qentry {
-    uint64_t time;
-    mp_obj_t callback;
-};
-
-typedef struct _mp_obj_time_queue_t {
-    mp_obj_base_t base;
-    mp_uint_t alloc;
-    mp_uint_t len;
-    struct qentry items[];
-} mp_obj_time_queue_t;
-
 STATIC mp_obj_time_queue_t *get_heap(mp_obj_t self_in) {
     return MP_OBJ_TO_PTR(self_in);
 }
@@ -84,12 +73,30 @@ STATIC mp_obj_t time_queue_make_new(const mp_obj_type_t *type, size_t n_args, co
     int length  = args[ARG_length].u_int;
     if (length < 1) length = 1;
 
-    mp_obj_time_queue_t *self = m_new_obj_var(mp_obj_time_queue_t, struct qentry, length);
+    mp_obj_time_queue_t *self = iot_time_queue_new(length);
     self->base.type = type;
+    return MP_OBJ_FROM_PTR(self);
+}
+
+mp_obj_time_queue_t *iot_time_queue_new(mp_uint_t length) {
+    mp_obj_time_queue_t *self = m_new_obj_var(mp_obj_time_queue_t, struct qentry, length);
+    self->base.type = &iot_time_queue_type;
     memset(self->items, 0, sizeof(*self->items) * length);
     self->alloc = length;
     self->len = 0;
-    return MP_OBJ_FROM_PTR(self);
+    self->slots = m_new(struct qslot, length);
+    for (mp_uint_t i = 0; i < length; i++) {
+        self->slots[i].position = i + 1;
+        self->slots[i].generation = 0;
+    }
+    self->free_slot = 0;
+    return self;
+}
+
+// All moves within the heap go through here so that slots track their entry.
+static inline void heap_set(mp_obj_time_queue_t *heap, mp_uint_t pos, struct qentry *item) {
+    heap->items[pos] = *item;
+    heap->slots[item->slot].position = pos;
 }
 
 STATIC void heap_siftdown(mp_obj_time_queue_t *heap, mp_uint_t start_pos, mp_uint_t pos) {
@@ -99,13 +106,13 @@ STATIC void heap_siftdown(mp_obj_time_queue_t *heap, mp_uint_t start_pos, mp_uin
         struct qentry *parent = &heap->items[parent_pos];
         bool lessthan = time_less_than(&item, parent);
         if (lessthan) {
-            heap->items[pos] = *parent;
+            heap_set(heap, pos, parent);
             pos = parent_pos;
         } else {
             break;
         }
     }
-    heap->items[pos] = item;
+    heap_set(heap, pos, &item);
 }
 
 STATIC void heap_siftup(mp_obj_time_queue_t *heap, mp_uint_t pos) {
@@ -121,13 +128,55 @@ STATIC void heap_siftup(mp_obj_time_queue_t *heap, mp_uint_t pos) {
             }
         }
         // bubble up the smaller child
-        heap->items[pos] = heap->items[child_pos];
+        heap_set(heap, pos, &heap->items[child_pos]);
         pos = child_pos;
     }
-    heap->items[pos] = item;
+    heap_set(heap, pos, &item);
     heap_siftdown(heap, start_pos, pos);
 }
 
+// Restore the heap invariant after the time of the entry at pos changed.
+STATIC void heap_fix(mp_obj_time_queue_t *heap, mp_uint_t pos) {
+    if (pos > 0 && time_less_than(&heap->items[pos], &heap->items[(pos - 1) >> 1])) {
+        heap_siftdown(heap, 0, pos);
+    } else {
+        heap_siftup(heap, pos);
+    }
+}
+
+// Handles combine the slot with its generation, wrapping before they outgrow a small int.
+STATIC mp_uint_t heap_handle(mp_obj_time_queue_t *heap, mp_uint_t slot) {
+    return heap->slots[slot].generation * heap->alloc + slot;
+}
+
+STATIC bool heap_lookup(mp_obj_time_queue_t *heap, mp_uint_t handle, mp_uint_t *pos) {
+    mp_uint_t slot = handle % heap->alloc;
+    if (heap->slots[slot].generation != handle / heap->alloc) {
+        return false;
+    }
+    // a free slot's position links to the next free slot, never to an entry holding it
+    *pos = heap->slots[slot].position;
+    return *pos < heap->len && heap->items[*pos].slot == slot;
+}
+
+// Remove the entry at pos and release its slot, invalidating its handle.
+STATIC void heap_remove(mp_obj_time_queue_t *heap, mp_uint_t pos) {
+    mp_uint_t slot = heap->items[pos].slot;
+    heap->len -= 1;
+    if (pos < heap->len) {
+        heap_set(heap, pos, &heap->items[heap->len]);
+        heap_fix(heap, pos);
+    }
+    heap->items[heap->len].callback = MP_OBJ_NULL; // so we don't retain a pointer
+    struct qslot *s = &heap->slots[slot];
+    s->generation += 1;
+    if (s->generation > (mp_uint_t)MP_SMALL_INT_MAX / heap->alloc - 1) {
+        s->generation = 0;
+    }
+    s->position = heap->free_slot;
+    heap->free_slot = slot;
+}
+
 //|   .. method:: after(delay, item)
 //|
 //|     Insert item in queue to be extracted with specified delay.
@@ -135,20 +184,86 @@ STATIC void heap_siftup(mp_obj_time_queue_t *heap, mp_uint_t pos) {
 //|   param float delay: time after item comes due, in seconds.
 //|   param object item: arbitrary object, typically a handler function or object.
 //|
-STATIC mp_obj_t mod_time_queue_after(const mp_obj_t self_in, const mp_obj_t time, const mp_obj_t callback) {
-    mp_obj_time_queue_t *heap = get_heap(self_in);
+//|   return int: handle to pass to cancel or reschedule.
+//|
+mp_uint_t iot_time_queue_push(mp_obj_time_queue_t *heap, uint64_t time, mp_obj_t callback) {
     if (heap->len == heap->alloc) {
         mp_raise_IndexError(translate("queue overflow"));
     }
-    mp_uint_t l = heap->len;
-    heap->items[l].time = common_hal_time_monotonic_ns() + (long)(1e9*mp_obj_get_float(time));
-    heap->items[l].callback = callback;
+    mp_uint_t slot = heap->free_slot;
+    heap->free_slot = heap->slots[slot].position;
+    struct qentry item = { .time = time, .callback = callback, .slot = slot };
+    heap_set(heap, heap->len, &item);
     heap_siftdown(heap, 0, heap->len);
     heap->len++;
-    return mp_const_none;
+    return heap_handle(heap, slot);
+}
+
+uint64_t iot_time_queue_time_after(mp_obj_t delay) {
+    int64_t delay_ns;
+    if (MP_OBJ_IS_SMALL_INT(delay)) {
+        delay_ns = (int64_t)MP_OBJ_SMALL_INT_VALUE(delay) * 1000000000;
+    } else {
+        delay_ns = (int64_t)(MICROPY_FLOAT_CONST(1e9) * mp_obj_get_float(delay));
+    }
+    return common_hal_time_monotonic_ns() + delay_ns;
+}
+
+STATIC mp_obj_t mod_time_queue_after(const mp_obj_t self_in, const mp_obj_t time, const mp_obj_t callback) {
+    mp_obj_time_queue_t *heap = get_heap(self_in);
+    return MP_OBJ_NEW_SMALL_INT(iot_time_queue_push(heap, iot_time_queue_time_after(time), callback));
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(mod_time_queue_after_obj, mod_time_queue_after);
 
+//|   .. method:: cancel(handle)
+//|
+//|     Remove the item scheduled by the after call that returned handle.
+//|
+//|   param int handle: value returned by after.
+//|
+//|   return bool: False if the item was already popped or cancelled.
+//|
+bool iot_time_queue_cancel(mp_obj_time_queue_t *heap, mp_uint_t handle) {
+    mp_uint_t pos;
+    if (!heap_lookup(heap, handle, &pos)) {
+        return false;
+    }
+    heap_remove(heap, pos);
+    return true;
+}
+
+STATIC mp_obj_t mod_time_queue_cancel(mp_obj_t self_in, mp_obj_t handle_in) {
+    mp_obj_time_queue_t *heap = get_heap(self_in);
+    return mp_obj_new_bool(iot_time_queue_cancel(heap, mp_obj_get_int(handle_in)));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_time_queue_cancel_obj, mod_time_queue_cancel);
+
+//|   .. method:: reschedule(handle, delay)
+//|
+//|     Move the item scheduled by the after call that returned handle so that it
+//|     comes due after delay instead. The handle remains valid.
+//|
+//|   param int handle: value returned by after.
+//|   param float delay: new time after item comes due, in seconds.
+//|
+//|   return bool: False if the item was already popped or cancelled.
+//|
+bool iot_time_queue_reschedule(mp_obj_time_queue_t *heap, mp_uint_t handle, uint64_t time) {
+    mp_uint_t pos;
+    if (!heap_lookup(heap, handle, &pos)) {
+        return false;
+    }
+    heap->items[pos].time = time;
+    heap_fix(heap, pos);
+    return true;
+}
+
+STATIC mp_obj_t mod_time_queue_reschedule(mp_obj_t self_in, mp_obj_t handle_in, mp_obj_t delay) {
+    mp_obj_time_queue_t *heap = get_heap(self_in);
+    return mp_obj_new_bool(iot_time_queue_reschedule(heap, mp_obj_get_int(handle_in), iot_time_queue_time_after(delay)));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(mod_time_queue_reschedule_obj, mod_time_queue_reschedule);
+
 //|   .. method:: pop()
 //|
 //|     Remove top item from queue. Typically call peek_time first.
@@ -156,21 +271,18 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_3(mod_time_queue_after_obj, mod_time_queue_after)
 //|
 //|   return object: item.
 //|
-STATIC mp_obj_t mod_time_queue_pop(mp_obj_t self_in) {
-    mp_obj_time_queue_t *heap = get_heap(self_in);
+mp_obj_t iot_time_queue_pop(mp_obj_time_queue_t *heap) {
     if (heap->len == 0) {
         mp_raise_IndexError(translate("heap empty"));
     }
-    struct qentry *item = &heap->items[0];
-    mp_obj_t result = item->callback;
-    heap->len -= 1;
-    heap->items[0] = heap->items[heap->len];
-    heap->items[heap->len].callback = MP_OBJ_NULL; // so we don't retain a pointer
-    if (heap->len) {
-        heap_siftup(heap, 0);
-    }
+    mp_obj_t result = heap->items[0].callback;
+    heap_remove(heap, 0);
     return result;
 }
+
+STATIC mp_obj_t mod_time_queue_pop(mp_obj_t self_in) {
+    return iot_time_queue_pop(get_heap(self_in));
+}
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_time_queue_pop_obj, mod_time_queue_pop);
 
 //|   .. method:: get(index)
@@ -238,6 +350,8 @@ const mp_obj_property_t iot_time_queue_peek_time_obj = {
 STATIC const mp_rom_map_elem_t time_queue_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR_after), MP_ROM_PTR(&mod_time_queue_after_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cancel), MP_ROM_PTR(&mod_time_queue_cancel_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reschedule), MP_ROM_PTR(&mod_time_queue_reschedule_obj) },
     { MP_ROM_QSTR(MP_QSTR_pop), MP_ROM_PTR(&mod_time_queue_pop_obj) },
     { MP_ROM_QSTR(MP_QSTR_get), MP_ROM_PTR(&mod_time_queue_get_obj) },
     // Property
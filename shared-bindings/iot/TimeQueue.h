@@ -27,6 +27,40 @@
 #ifndef MICROPY_INCLUDED_SHARED_BINDINGS_IOT_TIME_QUEUE_H
 #define MICROPY_INCLUDED_SHARED_BINDINGS_IOT_TIME_QUEUE_H
 
+#include "py/obj.h"
+
+struct qentry {
+    uint64_t time;
+    mp_obj_t callback;
+    mp_uint_t slot;
+};
+
+// One per handle: where the entry sits in items (or the next free slot) and
+// how often the slot has been released, so that stale handles are rejected.
+struct qslot {
+    mp_uint_t position;
+    mp_uint_t generation;
+};
+
+typedef struct _mp_obj_time_queue_t {
+    mp_obj_base_t base;
+    mp_uint_t alloc;
+    mp_uint_t len;
+    mp_uint_t free_slot;
+    struct qslot *slots;
+    struct qentry items[];
+} mp_obj_time_queue_t;
+
 extern const mp_obj_type_t iot_time_queue_type;
 
+// Used by EventLoop to share the queue implementation. Times are in common_hal_time_monotonic_ns() units.
+mp_obj_time_queue_t *iot_time_queue_new(mp_uint_t length);
+// push returns a handle for cancel and reschedule; these return false if the entry is already gone.
+mp_uint_t iot_time_queue_push(mp_obj_time_queue_t *heap, uint64_t time, mp_obj_t callback);
+mp_obj_t iot_time_queue_pop(mp_obj_time_queue_t *heap);
+bool iot_time_queue_cancel(mp_obj_time_queue_t *heap, mp_uint_t handle);
+bool iot_time_queue_reschedule(mp_obj_time_queue_t *heap, mp_uint_t handle, uint64_t time);
+// The time delay seconds from now. Whole seconds are exact, and fractions use mp_float_t.
+uint64_t iot_time_queue_time_after(mp_obj_t delay);
+
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_IOT_TIME_QUEUE_H
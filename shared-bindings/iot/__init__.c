@@ -33,6 +33,7 @@
 
 #include "shared-bindings/iot/__init__.h"
 #include "shared-bindings/iot/Chronometer.h"
+#include "shared-bindings/iot/EventLoop.h"
 #include "shared-bindings/iot/TimeQueue.h"
 #include "shared-bindings/iot/Ticker.h"
 #include "shared-bindings/iot/FinaliserProxy.h"
@@ -55,31 +56,91 @@
 //|     Chronometer
 //|     TimeQueue
 //|     Ticker
+//|     EventLoop
 //|     FinaliserProxy
 //|
 //| Timers should be deinitialized when no longer needed to free up resources.
 //|
 
-//| def dupterm(io: terminal=None) -> None:
-//|     """Add/remove secondary terminal."""
+//| def dupterm(terminal: Optional[Any] = None, *, buffer_size: int = 0, block: bool = False) -> Optional[Any]:
+//|     """Add/remove secondary terminal and return the previous one. Called
+//|     without arguments, returns the current terminal and changes nothing.
+//|
+//|     Console output normally goes to ``terminal.write`` as it is produced. With
+//|     ``buffer_size`` greater than zero, it is collected in a buffer of that many
+//|     bytes instead and written in bulk once it has waited a few milliseconds, or
+//|     by `dupterm_flush`. ``terminal.write`` must return the number of bytes it
+//|     took, like a stream; the rest stays in the buffer and is written later.
+//|     When the buffer is full, ``block`` selects between writing it out right
+//|     away, which holds up the program until the terminal takes the output, and
+//|     dropping the output that doesn't fit. Output is also dropped when a
+//|     blocking write finds the terminal takes none of it. Dropped output is
+//|     counted by `dupterm_stats`."""
 //|     ...
 //|
-mp_obj_t iot_dupterm(size_t n_args, const mp_obj_t *args) {
+STATIC mp_obj_t iot_dupterm(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_terminal, ARG_buffer_size, ARG_block };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_terminal, MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_buffer_size, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_block, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t buffer_size = args[ARG_buffer_size].u_int;
+    if (buffer_size < 0) {
+        mp_raise_ValueError_varg(translate("%q must be >= 0"), MP_QSTR_buffer_size);
+    }
+
     mp_obj_t res = shared_module_iot_terminal();
-    if (n_args == 1) shared_module_iot_dupterm(args[0]);
+    if (args[ARG_terminal].u_obj != MP_OBJ_NULL) {
+        shared_module_iot_dupterm(args[ARG_terminal].u_obj);
+        if (args[ARG_terminal].u_obj != mp_const_none) {
+            shared_module_iot_dupterm_buffer(buffer_size, args[ARG_block].u_bool);
+        }
+    }
     return res;
 }
+MP_DEFINE_CONST_FUN_OBJ_KW(iot_dupterm_obj, 0, iot_dupterm);
+
+//| def dupterm_flush() -> None:
+//|     """Write output buffered for the secondary terminal now, as much as
+//|     the terminal takes."""
+//|     ...
+//|
+STATIC mp_obj_t iot_dupterm_flush(void) {
+    shared_module_iot_dupterm_flush();
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(iot_dupterm_flush_obj, iot_dupterm_flush);
 
-MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(iot_dupterm_obj, 0, 1, iot_dupterm);
+//| def dupterm_stats() -> Tuple[int, int]:
+//|     """Return the number of bytes waiting in the secondary terminal's buffer
+//|     and the number of bytes dropped because it was full, since the terminal
+//|     was set."""
+//|     ...
+//|
+STATIC mp_obj_t iot_dupterm_stats(void) {
+    mp_obj_t items[2] = {
+        mp_obj_new_int_from_uint(shared_module_iot_dupterm_pending()),
+        mp_obj_new_int_from_uint(shared_module_iot_dupterm_dropped()),
+    };
+    return mp_obj_new_tuple(2, items);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(iot_dupterm_stats_obj, iot_dupterm_stats);
 
 STATIC const mp_rom_map_elem_t iot_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_iot) },
     { MP_ROM_QSTR(MP_QSTR_Chronometer), MP_ROM_PTR(&iot_chronometer_type) },
     { MP_ROM_QSTR(MP_QSTR_TimeQueue), MP_ROM_PTR(&iot_time_queue_type) },
     { MP_ROM_QSTR(MP_QSTR_Ticker), MP_ROM_PTR(&iot_ticker_type) },
+    { MP_ROM_QSTR(MP_QSTR_EventLoop), MP_ROM_PTR(&iot_event_loop_type) },
     { MP_ROM_QSTR(MP_QSTR_FinaliserProxy), MP_ROM_PTR(&iot_finaliser_proxy_type) },
 
     { MP_ROM_QSTR(MP_QSTR_dupterm), MP_ROM_PTR(&iot_dupterm_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dupterm_flush), MP_ROM_PTR(&iot_dupterm_flush_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dupterm_stats), MP_ROM_PTR(&iot_dupterm_stats_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(iot_module_globals, iot_module_globals_table);
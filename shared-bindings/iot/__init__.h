@@ -33,6 +33,11 @@
 
 void shared_module_iot_dupterm(mp_obj_t terminal);
 mp_obj_t shared_module_iot_terminal(void);
+// size 0 writes output straight to the terminal
+void shared_module_iot_dupterm_buffer(size_t size, bool block);
+void shared_module_iot_dupterm_flush(void);
+size_t shared_module_iot_dupterm_pending(void);
+uint32_t shared_module_iot_dupterm_dropped(void);
 
 char common_hal_dupterm_read(void);                // read single char
 bool common_hal_dupterm_bytes_available(void);
@@ -37,6 +37,7 @@
 //|         :param bytes data: representation."""
 //|
 STATIC mp_obj_t mod_msgpack_exttype_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
     mod_msgpack_extype_obj_t *self = m_new_obj(mod_msgpack_extype_obj_t);
     self->base.type = &mod_msgpack_exttype_type;
     enum { ARG_code, ARG_data };
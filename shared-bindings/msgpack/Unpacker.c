@@ -0,0 +1,152 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 MicroPython & CircuitPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "shared-bindings/msgpack/Unpacker.h"
+
+#define MP_OBJ_IS_METH(o) (MP_OBJ_IS_OBJ(o) && (((mp_obj_base_t*)MP_OBJ_TO_PTR(o))->type->name == MP_QSTR_bound_method))
+
+//| class Unpacker:
+//|     """Incrementally unpack objects from bytes fed in arbitrary pieces,
+//|     for example as they are received from a socket.
+//|
+//|     Example::
+//|
+//|        import msgpack
+//|
+//|        unpacker = msgpack.Unpacker()
+//|        while True:
+//|            unpacker.feed(sock.recv(64))
+//|            for obj in unpacker:
+//|                print(obj)
+//|
+//|     The buffer passed to `feed` is parsed in place. Bytes of an object that
+//|     is still incomplete are copied away when iteration stops, so the buffer
+//|     may be reused once the unpacker has been iterated to exhaustion."""
+//|
+//|     def __init__(self, *, ext_hook: Union[Callable[[int, bytes], object], None] = None, use_list: bool = True, use_memoryview: bool = False) -> None:
+//|         """Create an unpacker with no data fed yet.
+//|
+//|         :param Optional[~_typing.Callable[[int, bytes], object]] ext_hook: function called for objects in
+//|                msgpack ext format.
+//|         :param Optional[bool] use_list: return array as list or tuple (use_list=False).
+//|         :param Optional[bool] use_memoryview: return bin objects as read-only memoryviews of the fed
+//|                bytes rather than copying them into new bytes objects. The views are only valid
+//|                as long as the buffer passed to `feed` is not modified."""
+//|         ...
+//|
+STATIC mp_obj_t mod_msgpack_unpacker_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    enum { ARG_ext_hook, ARG_use_list, ARG_use_memoryview };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_ext_hook, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_use_list, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = true } },
+        { MP_QSTR_use_memoryview, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = false } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t hook = args[ARG_ext_hook].u_obj;
+    if (hook != mp_const_none && !MP_OBJ_IS_FUN(hook) && !MP_OBJ_IS_METH(hook)) {
+        mp_raise_ValueError(translate("ext_hook is not a function"));
+    }
+
+    msgpack_unpacker_obj_t *self = m_new_obj(msgpack_unpacker_obj_t);
+    self->base.type = &mod_msgpack_unpacker_type;
+    common_hal_msgpack_unpacker_construct(self, hook, args[ARG_use_list].u_bool, args[ARG_use_memoryview].u_bool);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def feed(self, data: ReadableBuffer) -> None:
+//|         """Append data to the bytes still to be unpacked.
+//|
+//|         A ``bytes`` object is unpacked in place, so it is kept until its objects
+//|         have been read. The contents of a writeable buffer are copied, so it may be
+//|         reused for the next read right away."""
+//|         ...
+//|
+STATIC mp_obj_t mod_msgpack_unpacker_feed(mp_obj_t self_in, mp_obj_t data) {
+    msgpack_unpacker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_msgpack_unpacker_feed(self, data);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(mod_msgpack_unpacker_feed_obj, mod_msgpack_unpacker_feed);
+
+//|     def unpack_into(self, target: Union[list, WriteableBuffer]) -> Union[list, int, None]:
+//|         """Unpack the next object into an existing object instead of allocating a new one.
+//|
+//|         An array is unpacked into ``target`` if it is a list, which is resized to the length
+//|         of the array. A bin object is copied into ``target`` if it is a writeable buffer.
+//|         Raises `TypeError` if the next object does not fit ``target``, in which case it is
+//|         not consumed.
+//|
+//|         :return: ``target`` for arrays, the number of bytes written for bin objects and
+//|                  None if no complete object has been fed yet."""
+//|         ...
+//|
+STATIC mp_obj_t mod_msgpack_unpacker_unpack_into(mp_obj_t self_in, mp_obj_t target) {
+    msgpack_unpacker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t result = common_hal_msgpack_unpacker_unpack_into(self, target);
+    if (result == MP_OBJ_NULL) {
+        return mp_const_none;
+    }
+    return result;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(mod_msgpack_unpacker_unpack_into_obj, mod_msgpack_unpacker_unpack_into);
+
+//|     def __iter__(self) -> Unpacker:
+//|         """Returns itself since it is the iterator."""
+//|         ...
+//|
+//|     def __next__(self) -> object:
+//|         """Returns the next complete object. Raises `StopIteration` if the data fed so far
+//|         does not hold one; iteration may be resumed after more data has been fed."""
+//|         ...
+//|
+STATIC mp_obj_t mod_msgpack_unpacker_iternext(mp_obj_t self_in) {
+    msgpack_unpacker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t obj = common_hal_msgpack_unpacker_next(self);
+    if (obj == MP_OBJ_NULL) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    return obj;
+}
+
+STATIC const mp_rom_map_elem_t mod_msgpack_unpacker_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_feed), MP_ROM_PTR(&mod_msgpack_unpacker_feed_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack_into), MP_ROM_PTR(&mod_msgpack_unpacker_unpack_into_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(mod_msgpack_unpacker_locals_dict, mod_msgpack_unpacker_locals_dict_table);
+
+const mp_obj_type_t mod_msgpack_unpacker_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Unpacker,
+    .make_new = mod_msgpack_unpacker_make_new,
+    .getiter = mp_identity_getiter,
+    .iternext = mod_msgpack_unpacker_iternext,
+    .locals_dict = (mp_obj_dict_t*)&mod_msgpack_unpacker_locals_dict,
+};
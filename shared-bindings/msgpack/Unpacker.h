@@ -0,0 +1,41 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 MicroPython & CircuitPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_MSGPACK_UNPACKER_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_MSGPACK_UNPACKER_H
+
+#include "py/obj.h"
+#include "shared-module/msgpack/Unpacker.h"
+
+extern const mp_obj_type_t mod_msgpack_unpacker_type;
+
+void common_hal_msgpack_unpacker_construct(msgpack_unpacker_obj_t *self, mp_obj_t ext_hook, bool use_list, bool use_memoryview);
+void common_hal_msgpack_unpacker_feed(msgpack_unpacker_obj_t *self, mp_obj_t data);
+// Both return MP_OBJ_NULL when no complete object has been fed yet.
+mp_obj_t common_hal_msgpack_unpacker_next(msgpack_unpacker_obj_t *self);
+mp_obj_t common_hal_msgpack_unpacker_unpack_into(msgpack_unpacker_obj_t *self, mp_obj_t target);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_MSGPACK_UNPACKER_H
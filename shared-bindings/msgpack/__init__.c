@@ -30,6 +30,7 @@
 #include "shared-bindings/msgpack/__init__.h"
 #include "shared-module/msgpack/__init__.h"
 #include "shared-bindings/msgpack/ExtType.h"
+#include "shared-bindings/msgpack/Unpacker.h"
 
 #define MP_OBJ_IS_METH(o) (MP_OBJ_IS_OBJ(o) && (((mp_obj_base_t*)MP_OBJ_TO_PTR(o))->type->name == MP_QSTR_bound_method))
 
@@ -114,6 +115,53 @@ STATIC mp_obj_t mod_msgpack_pack(size_t n_args, const mp_obj_t *pos_args, mp_map
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(mod_msgpack_pack_obj, 1, mod_msgpack_pack);
 
+//| def pack_into(obj: object, buffer: WriteableBuffer, offset: int = 0, *, default: Union[Callable[[object], None], None] = None) -> int:
+//|     """Output object in msgpack format into buffer starting at offset, without
+//|     allocating. offset may be negative to count from the end of buffer.
+//|     Raises `ValueError` if the object does not fit.
+//|
+//|     :param object obj: Object to convert to msgpack format.
+//|     :param ~_typing.WriteableBuffer buffer: buffer to write into, e.g. a bytearray
+//|     :param int offset: position in buffer of the first byte written
+//|     :param Optional[~_typing.Callable[[object], None]] default:
+//|           function called for python objects that do not have
+//|           a representation in msgpack format.
+//|
+//|     :return int: offset just past the last byte written, to pack the next object at."""
+//|     ...
+//|
+STATIC mp_obj_t mod_msgpack_pack_into(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_obj, ARG_buffer, ARG_offset, ARG_default };
+    STATIC const mp_arg_t allowed_args[] = {
+        { MP_QSTR_obj, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_offset, MP_ARG_INT, { .u_int = 0 } },
+        { MP_QSTR_default, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t handler = args[ARG_default].u_obj;
+    if (handler != mp_const_none && !MP_OBJ_IS_FUN(handler) && !MP_OBJ_IS_METH(handler)) {
+        mp_raise_ValueError(translate("default is not a function"));
+    }
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_WRITE);
+    mp_int_t offset = args[ARG_offset].u_int;
+    if (offset < 0) {
+        // negative offsets are relative to the end of the buffer
+        offset += (mp_int_t)bufinfo.len;
+    }
+    if (offset < 0 || (size_t)offset > bufinfo.len) {
+        mp_raise_ValueError(translate("offset out of bounds"));
+    }
+
+    size_t n = common_hal_msgpack_pack_into(args[ARG_obj].u_obj, args[ARG_buffer].u_obj, offset, handler);
+    return MP_OBJ_NEW_SMALL_INT(offset + n);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(mod_msgpack_pack_into_obj, 2, mod_msgpack_pack_into);
+
 
 //| def unpack(buffer: ReadableBuffer, *, ext_hook: Union[Callable[[int, bytes], object], None] = None, use_list: bool=True) -> object:
 //|     """Unpack and return one object from buffer.
@@ -151,7 +199,9 @@ STATIC const mp_rom_map_elem_t msgpack_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_msgpack) },
     { MP_ROM_QSTR(MP_QSTR_ExtType), MP_ROM_PTR(&mod_msgpack_exttype_type) },
     { MP_ROM_QSTR(MP_QSTR_pack), MP_ROM_PTR(&mod_msgpack_pack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pack_into), MP_ROM_PTR(&mod_msgpack_pack_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_unpack), MP_ROM_PTR(&mod_msgpack_unpack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_Unpacker), MP_ROM_PTR(&mod_msgpack_unpacker_type) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(msgpack_module_globals, msgpack_module_globals_table);
@@ -13,6 +13,8 @@ void common_hal_vectorio_circle_set_on_dirty(vectorio_circle_t *self, vectorio_e
 
 uint32_t common_hal_vectorio_circle_get_pixel(void *circle, int16_t x, int16_t y);
 
+int common_hal_vectorio_circle_get_spans(void *circle, int16_t y, int16_t x, int16_t *spans, int max_spans);
+
 void common_hal_vectorio_circle_get_area(void *circle, displayio_area_t *out_area);
 
 
@@ -13,6 +13,8 @@ void common_hal_vectorio_polygon_set_on_dirty(vectorio_polygon_t *self, vectorio
 
 uint32_t common_hal_vectorio_polygon_get_pixel(void *polygon, int16_t x, int16_t y);
 
+int common_hal_vectorio_polygon_get_spans(void *polygon, int16_t y, int16_t x, int16_t *spans, int max_spans);
+
 void common_hal_vectorio_polygon_get_area(void *polygon, displayio_area_t *out_area);
 
 
@@ -10,6 +10,8 @@ void common_hal_vectorio_rectangle_construct(vectorio_rectangle_t *self, uint32_
 
 uint32_t common_hal_vectorio_rectangle_get_pixel(void *rectangle, int16_t x, int16_t y);
 
+int common_hal_vectorio_rectangle_get_spans(void *rectangle, int16_t y, int16_t x, int16_t *spans, int max_spans);
+
 void common_hal_vectorio_rectangle_get_area(void *rectangle, displayio_area_t *out_area);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_VECTORIO_RECTANGLE_H
@@ -25,11 +25,13 @@
  */
 
 
+#include "py/binary.h"
 #include "py/obj.h"
 #include "py/objstr.h"
 #include "py/objtype.h"
 #include "py/runtime.h"
 #include "shared-bindings/_pixelbuf/PixelBuf.h"
+#include <math.h>
 #include <string.h>
 
 // Helper to ensure we have the native super class instead of a subclass.
@@ -69,6 +71,8 @@ void common_hal__pixelbuf_pixelbuf_construct(pixelbuf_pixelbuf_obj_t *self, size
     }
     // Call set_brightness so that it can allocate a second buffer if needed.
     self->brightness = 1.0;
+    self->gamma = 1.0;
+    self->brightness_lut = NULL;
     common_hal__pixelbuf_pixelbuf_set_brightness(MP_OBJ_FROM_PTR(self), brightness);
 
     // Turn on auto_write. We don't want to do it with the above brightness call.
@@ -105,26 +109,30 @@ mp_float_t common_hal__pixelbuf_pixelbuf_get_brightness(mp_obj_t self_in) {
     return self->brightness;
 }
 
-void common_hal__pixelbuf_pixelbuf_set_brightness(mp_obj_t self_in, mp_float_t brightness) {
-    pixelbuf_pixelbuf_obj_t* self = native_pixelbuf(self_in);
-    // Skip out if the brightness is already set. The default of self->brightness is 1.0. So, this
-    // also prevents the pre_brightness_buffer allocation when brightness is set to 1.0 again.
-    mp_float_t change = brightness - self->brightness;
-    if (-0.001 < change && change < 0.001) {
-        return;
-    }
-    self->brightness = brightness;
+// Rebuilds the lookup table for the current brightness and gamma and applies it to every pixel.
+static void pixelbuf_update_lut(mp_obj_t self_in, pixelbuf_pixelbuf_obj_t* self) {
     size_t pixel_len = self->pixel_count * self->bytes_per_pixel;
     if (self->pre_brightness_buffer == NULL) {
         self->pre_brightness_buffer = m_malloc(pixel_len, false);
         memcpy(self->pre_brightness_buffer, self->post_brightness_buffer, pixel_len);
     }
+    if (self->brightness_lut == NULL) {
+        self->brightness_lut = m_malloc(256, false);
+    }
+    uint8_t* lut = self->brightness_lut;
+    for (size_t i = 0; i < 256; i++) {
+        if (self->gamma == 1.0) {
+            lut[i] = i * self->brightness;
+        } else {
+            lut[i] = MICROPY_FLOAT_C_FUN(pow)(i / MICROPY_FLOAT_CONST(255.0), self->gamma) * 255 * self->brightness + MICROPY_FLOAT_CONST(0.5);
+        }
+    }
     for (size_t i = 0; i < pixel_len; i++) {
         // Don't adjust per-pixel luminance bytes in dotstar mode
         if (self->byteorder.is_dotstar && i % 4 == 0) {
             continue;
         }
-        self->post_brightness_buffer[i] = self->pre_brightness_buffer[i] * self->brightness;
+        self->post_brightness_buffer[i] = lut[self->pre_brightness_buffer[i]];
     }
 
     if (self->auto_write) {
@@ -132,6 +140,33 @@ void common_hal__pixelbuf_pixelbuf_set_brightness(mp_obj_t self_in, mp_float_t b
     }
 }
 
+void common_hal__pixelbuf_pixelbuf_set_brightness(mp_obj_t self_in, mp_float_t brightness) {
+    pixelbuf_pixelbuf_obj_t* self = native_pixelbuf(self_in);
+    // Skip out if the brightness is already set. The default of self->brightness is 1.0. So, this
+    // also prevents the pre_brightness_buffer allocation when brightness is set to 1.0 again.
+    mp_float_t change = brightness - self->brightness;
+    if (-0.001 < change && change < 0.001) {
+        return;
+    }
+    self->brightness = brightness;
+    pixelbuf_update_lut(self_in, self);
+}
+
+mp_float_t common_hal__pixelbuf_pixelbuf_get_gamma(mp_obj_t self_in) {
+    pixelbuf_pixelbuf_obj_t* self = native_pixelbuf(self_in);
+    return self->gamma;
+}
+
+void common_hal__pixelbuf_pixelbuf_set_gamma(mp_obj_t self_in, mp_float_t gamma) {
+    pixelbuf_pixelbuf_obj_t* self = native_pixelbuf(self_in);
+    mp_float_t change = gamma - self->gamma;
+    if (-0.001 < change && change < 0.001) {
+        return;
+    }
+    self->gamma = gamma;
+    pixelbuf_update_lut(self_in, self);
+}
+
 uint8_t _pixelbuf_get_as_uint8(mp_obj_t obj) {
     if (MP_OBJ_IS_SMALL_INT(obj)) {
         return MP_OBJ_SMALL_INT_VALUE(obj);
@@ -209,16 +244,22 @@ void _pixelbuf_set_pixel_color(pixelbuf_pixelbuf_obj_t* self, size_t index, uint
     }
 
     uint8_t* post_brightness_buffer = self->post_brightness_buffer + offset;
-    if (self->bytes_per_pixel == 4) {
+    const uint8_t* lut = self->brightness_lut;
+    if (lut != NULL) {
+        r = lut[r];
+        g = lut[g];
+        b = lut[b];
         // Only apply brightness if w is actually white (aka not DotStar.)
         if (!self->byteorder.is_dotstar) {
-            w *= self->brightness;
+            w = lut[w];
         }
+    }
+    if (self->bytes_per_pixel == 4) {
         post_brightness_buffer[rgbw_order->w] = w;
     }
-    post_brightness_buffer[rgbw_order->r] = r * self->brightness;
-    post_brightness_buffer[rgbw_order->g] = g * self->brightness;
-    post_brightness_buffer[rgbw_order->b] = b * self->brightness;
+    post_brightness_buffer[rgbw_order->r] = r;
+    post_brightness_buffer[rgbw_order->g] = g;
+    post_brightness_buffer[rgbw_order->b] = b;
 }
 
 void _pixelbuf_set_pixel(pixelbuf_pixelbuf_obj_t* self, size_t index, mp_obj_t value) {
@@ -230,10 +271,68 @@ void _pixelbuf_set_pixel(pixelbuf_pixelbuf_obj_t* self, size_t index, mp_obj_t v
     _pixelbuf_set_pixel_color(self, index, r, g, b, w);
 }
 
+static void pixelbuf_load(pixelbuf_pixelbuf_obj_t* self, size_t start, const uint8_t* buffer, size_t pixel_count,
+    const pixelbuf_byteorder_details_t* byteorder) {
+    const pixelbuf_rgbw_t* order = &byteorder->byteorder;
+    const pixelbuf_rgbw_t* own_order = &self->byteorder.byteorder;
+    uint8_t bpp = byteorder->bpp;
+    // Copy the buffer as is when it's already in the transmitted form.
+    if (self->pre_brightness_buffer == NULL && !self->byteorder.is_dotstar && !byteorder->is_dotstar &&
+        bpp == self->bytes_per_pixel && order->r == own_order->r && order->g == own_order->g &&
+        order->b == own_order->b && (bpp == 3 || order->w == own_order->w)) {
+        memcpy(self->post_brightness_buffer + start * bpp, buffer, pixel_count * bpp);
+        return;
+    }
+    bool white_from_rgb = !self->byteorder.is_dotstar && self->byteorder.has_white && !byteorder->has_white;
+    for (size_t i = 0; i < pixel_count; i++) {
+        const uint8_t* pixel = buffer + i * bpp;
+        uint8_t r = pixel[order->r];
+        uint8_t g = pixel[order->g];
+        uint8_t b = pixel[order->b];
+        // Like tuples, the fourth value is white or the DotStar brightness.
+        uint8_t w = self->byteorder.is_dotstar ? 255 : 0;
+        if (bpp == 4) {
+            w = pixel[order->w];
+        }
+        if (white_from_rgb && r == g && r == b) {
+            w = r;
+            r = 0;
+            g = 0;
+            b = 0;
+        }
+        _pixelbuf_set_pixel_color(self, start + i, r, g, b, w);
+    }
+}
+
+void common_hal__pixelbuf_pixelbuf_load(mp_obj_t self_in, size_t start, const uint8_t* buffer, size_t pixel_count,
+    const pixelbuf_byteorder_details_t* byteorder) {
+    pixelbuf_pixelbuf_obj_t* self = native_pixelbuf(self_in);
+    pixelbuf_load(self, start, buffer, pixel_count, byteorder);
+    if (self->auto_write) {
+        common_hal__pixelbuf_pixelbuf_show(self_in);
+    }
+}
+
 void common_hal__pixelbuf_pixelbuf_set_pixels(mp_obj_t self_in, size_t start, mp_int_t step, size_t slice_len, mp_obj_t* values,
     mp_obj_tuple_t *flatten_to)
 {
     pixelbuf_pixelbuf_obj_t* self = native_pixelbuf(self_in);
+    // Flattened bytes are (Red, Green, Blue[, White]) values, so they can be loaded in one pass.
+    mp_buffer_info_t bufinfo;
+    if (flatten_to != mp_const_none && step == 1 && mp_get_buffer(values, &bufinfo, MP_BUFFER_READ) &&
+        (bufinfo.typecode == 'B' || bufinfo.typecode == BYTEARRAY_TYPECODE)) {
+        pixelbuf_byteorder_details_t byteorder = {
+            .bpp = self->byteorder.bpp,
+            .byteorder = { .r = PIXEL_R, .g = PIXEL_G, .b = PIXEL_B, .w = PIXEL_W },
+            .is_dotstar = self->byteorder.is_dotstar,
+            .has_white = self->byteorder.has_white,
+        };
+        pixelbuf_load(self, start, bufinfo.buf, slice_len, &byteorder);
+        if (self->auto_write) {
+            common_hal__pixelbuf_pixelbuf_show(self_in);
+        }
+        return;
+    }
     mp_obj_iter_buf_t iter_buf;
     mp_obj_t iterable = mp_getiter(values, &iter_buf);
     mp_obj_t item;
@@ -52,6 +52,10 @@ typedef struct {
     size_t bytes_per_pixel;
     pixelbuf_byteorder_details_t byteorder;
     mp_float_t brightness;
+    mp_float_t gamma;
+    // Output value of each color value for the current brightness and gamma. NULL until either
+    // changes, while colors are output as they are.
+    uint8_t *brightness_lut;
     mp_obj_t transmit_buffer_obj;
     // The post_brightness_buffer is offset into the buffer allocated in transmit_buffer_obj to
     // account for any header.
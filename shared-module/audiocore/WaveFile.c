@@ -42,9 +42,13 @@ struct wave_format_chunk {
     uint32_t byte_rate;
     uint16_t block_align;
     uint16_t bits_per_sample;
-    uint16_t extra_params; // Assumed to be zero below.
+    uint16_t extra_params; // Assumed to be zero below, except for IMA-ADPCM.
+    uint16_t samples_per_block; // IMA-ADPCM only.
 };
 
+#define WAVE_FORMAT_PCM (0x0001)
+#define WAVE_FORMAT_IMA_ADPCM (0x0011)
+
 void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
                                            pyb_file_obj_t* file,
                                            uint8_t *buffer,
@@ -77,10 +81,26 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
     if (bytes_read != format_size) {
     }
 
-    if (format.audio_format != 1 ||
+    self->block_align = 0;
+    if (format.audio_format == WAVE_FORMAT_IMA_ADPCM) {
+        // Each block starts with the first sample and step index of each channel, followed
+        // by groups of 4 bytes of 4 bit samples for each channel in turn.
+        if (format_size != 20 ||
+            format.extra_params != 2 ||
+            format.num_channels > 2 ||
+            format.bits_per_sample != 4 ||
+            format.block_align <= 4 * format.num_channels ||
+            format.block_align % (4 * format.num_channels) != 0 ||
+            format.samples_per_block != (format.block_align - 4 * format.num_channels) * 2 / format.num_channels + 1) {
+            mp_raise_ValueError(translate("Unsupported format"));
+        }
+        self->block_align = format.block_align;
+        // Samples are decoded to 16 bits.
+        format.bits_per_sample = 16;
+    } else if (format.audio_format != WAVE_FORMAT_PCM ||
         format.num_channels > 2 ||
         format.bits_per_sample > 16 ||
-        (format_size == 18 &&
+        (format_size >= 18 &&
          format.extra_params != 0)) {
         mp_raise_ValueError(translate("Unsupported format"));
     }
@@ -89,54 +109,56 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
     self->channel_count = format.num_channels;
     self->bits_per_sample = format.bits_per_sample;
 
-    // TODO(tannewt): Skip any extra chunks that occur before the data section.
-
-    uint8_t data_tag[4];
-    if (f_read(&self->file->fp, &data_tag, 4, &bytes_read) != FR_OK) {
-        mp_raise_OSError(MP_EIO);
-    }
-    if (bytes_read != 4 ||
-        memcmp((uint8_t *) data_tag, "data", 4) != 0) {
-        mp_raise_ValueError(translate("Data chunk must follow fmt chunk"));
-    }
-
+    // Skip any other chunks, such as the fact chunk of compressed files, that occur before
+    // the data chunk.
     uint32_t data_length;
-    if (f_read(&self->file->fp, &data_length, 4, &bytes_read) != FR_OK) {
-        mp_raise_OSError(MP_EIO);
-    }
-    if (bytes_read != 4) {
-        mp_raise_ValueError(translate("Invalid file"));
+    while (true) {
+        uint8_t data_tag[4];
+        if (f_read(&self->file->fp, &data_tag, 4, &bytes_read) != FR_OK ||
+            (bytes_read == 4 && f_read(&self->file->fp, &data_length, 4, &bytes_read) != FR_OK)) {
+            mp_raise_OSError(MP_EIO);
+        }
+        if (bytes_read != 4) {
+            mp_raise_ValueError(translate("Data chunk must follow fmt chunk"));
+        }
+        if (memcmp((uint8_t *) data_tag, "data", 4) == 0) {
+            break;
+        }
+        // Chunks are padded to an even length.
+        if (f_lseek(&self->file->fp, self->file->fp.fptr + data_length + (data_length & 1)) != FR_OK) {
+            mp_raise_OSError(MP_EIO);
+        }
     }
     self->file_length = data_length;
     self->data_start = self->file->fp.fptr;
 
-    // Try to allocate two buffers, one will be loaded from file and the other
-    // DMAed to DAC.
+    // Split the memory into a ring of buffers. Two are DMAed to the DAC while the others are
+    // loaded from the file.
     if (buffer_size) {
-        self->len = buffer_size / 2;
+        self->len = buffer_size / CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS / sizeof(uint32_t) * sizeof(uint32_t);
+        if (self->len == 0) {
+            mp_raise_ValueError(translate("Buffer is too small"));
+        }
         self->buffer = buffer;
-        self->second_buffer = buffer + self->len;
     } else {
         self->len = 256;
-        self->buffer = m_malloc(self->len, false);
+        self->buffer = m_malloc(self->len * CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS, false);
         if (self->buffer == NULL) {
             common_hal_audioio_wavefile_deinit(self);
             mp_raise_msg(&mp_type_MemoryError,
                          translate("Couldn't allocate first buffer"));
         }
-
-        self->second_buffer = m_malloc(self->len, false);
-        if (self->second_buffer == NULL) {
-            common_hal_audioio_wavefile_deinit(self);
-            mp_raise_msg(&mp_type_MemoryError,
-                         translate("Couldn't allocate second buffer"));
-        }
     }
+    if (self->block_align) {
+        self->block = m_malloc(self->block_align, false);
+    }
+    self->buffer_index = 0;
+    audioio_wavefile_reset_buffer(self, false, 0);
 }
 
 void common_hal_audioio_wavefile_deinit(audioio_wavefile_obj_t* self) {
     self->buffer = NULL;
-    self->second_buffer = NULL;
+    self->block = NULL;
 }
 
 bool common_hal_audioio_wavefile_deinited(audioio_wavefile_obj_t* self) {
@@ -168,19 +190,175 @@ uint32_t audioio_wavefile_max_buffer_length(audioio_wavefile_obj_t* self) {
     return 512;
 }
 
+static const int16_t ima_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60,
+    66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371,
+    408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707,
+    1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132,
+    7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+    27086, 29794, 32767
+};
+
+static const int8_t ima_index_table[8] = {
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static int16_t adpcm_decode_nibble(audioio_wavefile_obj_t* self, uint8_t channel, uint8_t nibble) {
+    int32_t step = ima_step_table[self->adpcm_step_index[channel]];
+    int32_t diff = step >> 3;
+    if (nibble & 1) {
+        diff += step >> 2;
+    }
+    if (nibble & 2) {
+        diff += step >> 1;
+    }
+    if (nibble & 4) {
+        diff += step;
+    }
+    int32_t predictor = self->adpcm_predictor[channel];
+    predictor += (nibble & 8) ? -diff : diff;
+    predictor = MIN(MAX(predictor, INT16_MIN), INT16_MAX);
+    self->adpcm_predictor[channel] = predictor;
+    int32_t index = self->adpcm_step_index[channel] + ima_index_table[nibble & 7];
+    self->adpcm_step_index[channel] = MIN(MAX(index, 0), 88);
+    return predictor;
+}
+
+// Decodes up to length bytes of samples into buffer, reading blocks from the file as needed.
+// Returns the number of bytes decoded or -1 if the file can't be read.
+static int32_t adpcm_decode(audioio_wavefile_obj_t* self, int16_t* buffer, uint32_t length) {
+    uint8_t channel_count = self->channel_count;
+    uint32_t frames = length / (channel_count * sizeof(int16_t));
+    uint32_t frame = 0;
+    while (frame < frames) {
+        if (self->block_frame == self->block_frames) {
+            if (self->bytes_remaining == 0) {
+                break;
+            }
+            UINT block_length = MIN(self->block_align, self->bytes_remaining);
+            UINT length_read;
+            if (f_read(&self->file->fp, self->block, block_length, &length_read) != FR_OK || length_read != block_length) {
+                return -1;
+            }
+            self->bytes_remaining -= length_read;
+            if (length_read < 4 * channel_count) {
+                self->block_frames = 0;
+                self->block_frame = 0;
+                continue;
+            }
+            // The last block may be short.
+            self->block_frames = 1 + (length_read - 4 * channel_count) / (4 * channel_count) * 8;
+            self->block_frame = 0;
+            for (uint8_t c = 0; c < channel_count; c++) {
+                self->adpcm_predictor[c] = (int16_t) (self->block[4 * c] | (self->block[4 * c + 1] << 8));
+                self->adpcm_step_index[c] = MIN(self->block[4 * c + 2], 88);
+            }
+        }
+        if (self->block_frame == 0) {
+            for (uint8_t c = 0; c < channel_count; c++) {
+                buffer[frame * channel_count + c] = self->adpcm_predictor[c];
+            }
+        } else {
+            uint32_t sample = self->block_frame - 1;
+            const uint8_t* group = self->block + 4 * channel_count * (1 + sample / 8);
+            for (uint8_t c = 0; c < channel_count; c++) {
+                uint8_t byte = group[4 * c + (sample % 8) / 2];
+                uint8_t nibble = sample % 2 ? byte >> 4 : byte & 0xf;
+                buffer[frame * channel_count + c] = adpcm_decode_nibble(self, c, nibble);
+            }
+        }
+        self->block_frame++;
+        frame++;
+    }
+    return frame * channel_count * sizeof(int16_t);
+}
+
+// Loads the next buffer of the ring from the file. Returns false if the file can't be read.
+static bool load_buffer(audioio_wavefile_obj_t* self) {
+    uint8_t index = (self->buffer_index + self->buffers_loaded) % CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS;
+    uint8_t* buffer = self->buffer + index * self->len;
+    uint32_t length_read;
+    if (self->block_align) {
+        int32_t length = adpcm_decode(self, (int16_t*) buffer, self->len);
+        if (length < 0) {
+            return false;
+        }
+        length_read = length;
+    } else {
+        uint16_t num_bytes_to_load = self->len;
+        if (num_bytes_to_load > self->bytes_remaining) {
+            num_bytes_to_load = self->bytes_remaining;
+        }
+        UINT bytes_read;
+        if (f_read(&self->file->fp, buffer, num_bytes_to_load, &bytes_read) != FR_OK || bytes_read != num_bytes_to_load) {
+            return false;
+        }
+        self->bytes_remaining -= bytes_read;
+        length_read = bytes_read;
+    }
+    bool last = self->bytes_remaining == 0 && (self->block_align == 0 || self->block_frame == self->block_frames);
+    // Pad the last buffer to word align it.
+    if (last && length_read % sizeof(uint32_t) != 0) {
+        uint32_t pad = length_read % sizeof(uint32_t);
+        length_read += pad;
+        if (self->bits_per_sample == 8) {
+            for (uint32_t i = 0; i < pad; i++) {
+                buffer[length_read / sizeof(uint8_t) - i - 1] = 0x80;
+            }
+        } else if (self->bits_per_sample == 16) {
+            // We know the buffer is aligned because we allocated it onto the heap ourselves.
+            #pragma GCC diagnostic push
+            #pragma GCC diagnostic ignored "-Wcast-align"
+            ((int16_t*) buffer)[length_read / sizeof(int16_t) - 1] = 0;
+            #pragma GCC diagnostic pop
+        }
+    }
+    self->buffer_length[index] = length_read;
+    if (last) {
+        self->last_buffer = index;
+    }
+    self->buffers_loaded += 1;
+    return true;
+}
+
+// Fills the buffers that the audio output isn't holding. This runs as a background callback, in
+// the same context as the audio outputs call get_buffer, so the two never overlap.
+static void wavefile_load_ahead(void* self_in) {
+    audioio_wavefile_obj_t* self = self_in;
+    while (self->buffer != NULL &&
+           self->last_buffer < 0 &&
+           self->buffers_loaded < CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS - 2) {
+        if (!load_buffer(self)) {
+            // get_buffer will try again and report the error.
+            return;
+        }
+    }
+}
+
+static void queue_load_ahead(audioio_wavefile_obj_t* self) {
+    if (CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS > 2 && self->last_buffer < 0) {
+        background_callback_add(&self->callback, wavefile_load_ahead, self);
+    }
+}
+
 void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t* self,
                                    bool single_channel,
                                    uint8_t channel) {
     if (single_channel && channel == 1) {
         return;
     }
-    // We don't reset the buffer index in case we're looping and we have an odd number of buffer
-    // loads
+    // We don't reset the buffer index in case we're looping and the output is still playing
+    // the last buffers.
     self->bytes_remaining = self->file_length;
     f_lseek(&self->file->fp, self->data_start);
+    self->buffers_loaded = 0;
+    self->last_buffer = -1;
+    self->block_frames = 0;
+    self->block_frame = 0;
     self->read_count = 0;
     self->left_read_count = 0;
     self->right_read_count = 0;
+    queue_load_ahead(self);
 }
 
 audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t* self,
@@ -199,61 +377,29 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t*
 
     bool need_more_data = self->read_count == channel_read_count;
 
-    if (self->bytes_remaining == 0 && need_more_data) {
-        *buffer = NULL;
-        *buffer_length = 0;
-        return GET_BUFFER_DONE;
-    }
-
     if (need_more_data) {
-        uint16_t num_bytes_to_load = self->len;
-        if (num_bytes_to_load > self->bytes_remaining) {
-            num_bytes_to_load = self->bytes_remaining;
-        }
-        UINT length_read;
-        if (self->buffer_index % 2 == 1) {
-            *buffer = self->second_buffer;
-        } else {
-            *buffer = self->buffer;
-        }
-        if (f_read(&self->file->fp, *buffer, num_bytes_to_load, &length_read) != FR_OK || length_read != num_bytes_to_load) {
-            return GET_BUFFER_ERROR;
-        }
-        self->bytes_remaining -= length_read;
-        // Pad the last buffer to word align it.
-        if (self->bytes_remaining == 0 && length_read % sizeof(uint32_t) != 0) {
-            uint32_t pad = length_read % sizeof(uint32_t);
-            length_read += pad;
-            if (self->bits_per_sample == 8) {
-                for (uint32_t i = 0; i < pad; i++) {
-                    ((uint8_t*) (*buffer))[length_read / sizeof(uint8_t) - i - 1] = 0x80;
-                }
-            } else if (self->bits_per_sample == 16) {
-                // We know the buffer is aligned because we allocated it onto the heap ourselves.
-                #pragma GCC diagnostic push
-                #pragma GCC diagnostic ignored "-Wcast-align"
-                ((int16_t*) (*buffer))[length_read / sizeof(int16_t) - 1] = 0;
-                #pragma GCC diagnostic pop
+        if (self->buffers_loaded == 0) {
+            if (self->last_buffer >= 0) {
+                *buffer = NULL;
+                *buffer_length = 0;
+                return GET_BUFFER_DONE;
+            }
+            // The read ahead didn't keep up so load the buffer now.
+            if (!load_buffer(self)) {
+                return GET_BUFFER_ERROR;
             }
         }
-        *buffer_length = length_read;
-        if (self->buffer_index % 2 == 1) {
-            self->second_buffer_length = length_read;
-        } else {
-            self->buffer_length = length_read;
-        }
-        self->buffer_index += 1;
+        self->buffer_index = (self->buffer_index + 1) % CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS;
+        self->buffers_loaded -= 1;
         self->read_count += 1;
+        queue_load_ahead(self);
     }
 
+    // The buffer given out last, or the one before it for a channel that is behind.
     uint32_t buffers_back = self->read_count - 1 - channel_read_count;
-    if ((self->buffer_index - buffers_back) % 2 == 0) {
-        *buffer = self->second_buffer;
-        *buffer_length = self->second_buffer_length;
-    } else {
-        *buffer = self->buffer;
-        *buffer_length = self->buffer_length;
-    }
+    uint8_t index = (self->buffer_index + 2 * CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS - 1 - buffers_back) % CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS;
+    *buffer = self->buffer + index * self->len;
+    *buffer_length = self->buffer_length[index];
 
     if (channel == 0) {
         self->left_read_count += 1;
@@ -262,7 +408,7 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t*
         *buffer = *buffer + self->bits_per_sample / 8;
     }
 
-    return self->bytes_remaining == 0 ? GET_BUFFER_DONE : GET_BUFFER_MORE_DATA;
+    return index == self->last_buffer ? GET_BUFFER_DONE : GET_BUFFER_MORE_DATA;
 }
 
 void audioio_wavefile_get_buffer_structure(audioio_wavefile_obj_t* self, bool single_channel,
@@ -31,18 +31,20 @@
 #include "py/obj.h"
 
 #include "shared-module/audiocore/__init__.h"
+#include "supervisor/background_callback.h"
 
 typedef struct {
     mp_obj_base_t base;
+    // CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS buffers of len bytes each, used as a ring.
     uint8_t* buffer;
-    uint32_t buffer_length;
-    uint8_t* second_buffer;
-    uint32_t second_buffer_length;
+    uint32_t buffer_length[CIRCUITPY_AUDIOCORE_WAVEFILE_BUFFERS];
     uint32_t file_length; // In bytes
-    uint16_t data_start; // Where the data values start
-    uint8_t bits_per_sample;
-    uint16_t buffer_index;
-    uint32_t bytes_remaining;
+    uint32_t data_start; // Where the data values start
+    uint8_t bits_per_sample; // Of the samples in the buffers, after any decoding.
+    uint8_t buffer_index; // The next buffer to play.
+    uint8_t buffers_loaded; // Buffers loaded ahead, from buffer_index on.
+    int8_t last_buffer; // The buffer holding the end of the data, or -1 until it's loaded.
+    uint32_t bytes_remaining; // Bytes of data left to read from the file.
 
     uint8_t channel_count;
     uint32_t sample_rate;
@@ -53,6 +55,16 @@ typedef struct {
     uint32_t read_count;
     uint32_t left_read_count;
     uint32_t right_read_count;
+
+    background_callback_t callback;
+
+    // IMA-ADPCM files are read a block at a time and decoded into the buffers.
+    uint8_t* block;
+    uint16_t block_align; // 0 for PCM files.
+    uint16_t block_frames; // Frames in the block read last.
+    uint16_t block_frame; // The next frame to decode from it.
+    int16_t adpcm_predictor[2];
+    uint8_t adpcm_step_index[2];
 } audioio_wavefile_obj_t;
 
 // These are not available from Python because it may be called in an interrupt.
@@ -61,11 +61,14 @@ void common_hal_audiomixer_mixer_construct(audiomixer_mixer_obj_t* self,
     self->channel_count = channel_count;
     self->sample_rate = sample_rate;
     self->voice_count = voice_count;
+    // Allocated when a voice first plays a sample at another rate.
+    self->resample_buffer = NULL;
 }
 
 void common_hal_audiomixer_mixer_deinit(audiomixer_mixer_obj_t* self) {
     self->first_buffer = NULL;
     self->second_buffer = NULL;
+    self->resample_buffer = NULL;
 }
 
 bool common_hal_audiomixer_mixer_deinited(audiomixer_mixer_obj_t* self) {
@@ -101,6 +104,16 @@ void audiomixer_mixer_reset_buffer(audiomixer_mixer_obj_t* self,
     }
 }
 
+// Samples are mixed as pairs of 16-bit or quads of 8-bit signed lanes packed into words. Cores
+// with the ARM DSP extension work on whole words with its SIMD instructions. Elsewhere, including
+// the unix port, the lanes are mixed by plain loops that compilers can vectorise.
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#define AUDIOMIXER_ARM_DSP (1)
+#else
+#define AUDIOMIXER_ARM_DSP (0)
+#endif
+
+#if AUDIOMIXER_ARM_DSP
 __attribute__((always_inline))
 static inline uint32_t add16signed(uint32_t a, uint32_t b) {
     return __QADD16(a, b);
@@ -120,14 +133,6 @@ static inline uint32_t mult16signed(uint32_t val, int32_t mul) {
     return val;
 }
 
-static inline uint32_t tounsigned8(uint32_t val) {
-    return __UADD8(val, 0x80808080);
-}
-
-static inline uint32_t tounsigned16(uint32_t val) {
-    return __UADD16(val, 0x80008000);
-}
-
 static inline uint32_t tosigned16(uint32_t val) {
     return __UADD16(val, 0x80008000);
 }
@@ -139,88 +144,233 @@ static inline uint32_t unpack8(uint16_t val) {
 static inline uint32_t pack8(uint32_t val) {
     return ((val & 0xff000000) >> 16) | ((val & 0xff00) >> 8);
 }
+#else
+static inline int32_t saturate16(int32_t val) {
+    return val < INT16_MIN ? INT16_MIN : (val > INT16_MAX ? INT16_MAX : val);
+}
 
-static void mix_down_one_voice(audiomixer_mixer_obj_t* self,
-        audiomixer_mixervoice_obj_t* voice, bool voices_active,
-        uint32_t* word_buffer, uint32_t length) {
-    while (length != 0) {
-        if (voice->buffer_length == 0) {
-            if (!voice->more_data) {
-                if (voice->loop) {
-                    audiosample_reset_buffer(voice->sample, false, 0);
-                } else {
-                    voice->sample = NULL;
-                    break;
+// Same as the DSP path: the product is shifted down by 15 and saturated to 16 bits.
+static inline int32_t mult16signed(int32_t val, int32_t mul) {
+    return saturate16((val * mul) >> 15);
+}
+#endif
+
+// Flipping the top bit of each lane converts between signed and unsigned samples.
+static inline uint32_t tounsigned8(uint32_t val) {
+    return val ^ 0x80808080;
+}
+
+static inline uint32_t tounsigned16(uint32_t val) {
+    return val ^ 0x80008000;
+}
+
+// Scales n words of samples from src by level and copies them into word_buffer when first is
+// true, or adds them to it with saturation otherwise.
+static void mix_words(audiomixer_mixer_obj_t* self, uint32_t* word_buffer, const uint32_t* src,
+        uint32_t n, uint16_t level, bool src_signed, bool first) {
+#if AUDIOMIXER_ARM_DSP
+    if (first) {
+        if (MP_LIKELY(self->bits_per_sample == 16)) {
+            if (MP_LIKELY(src_signed)) {
+                for (uint32_t i = 0; i<n; i++) {
+                    uint32_t v = src[i];
+                    word_buffer[i] = mult16signed(v, level);
+                }
+            } else {
+                for (uint32_t i = 0; i<n; i++) {
+                    uint32_t v = src[i];
+                    v = tosigned16(v);
+                    word_buffer[i] = mult16signed(v, level);
                 }
             }
-            if (voice->sample) {
-                // Load another buffer
-                audioio_get_buffer_result_t result = audiosample_get_buffer(voice->sample, false, 0, (uint8_t**) &voice->remaining_buffer, &voice->buffer_length);
-                // Track length in terms of words.
-                voice->buffer_length /= sizeof(uint32_t);
-                voice->more_data = result == GET_BUFFER_MORE_DATA;
+        } else {
+            uint16_t *hword_buffer = (uint16_t*)word_buffer;
+            const uint16_t *hsrc = (const uint16_t*)src;
+            for (uint32_t i = 0; i<n*2; i++) {
+                uint32_t word = unpack8(hsrc[i]);
+                if (MP_LIKELY(!src_signed)) {
+                    word = tosigned16(word);
+                }
+                word = mult16signed(word, level);
+                hword_buffer[i] = pack8(word);
             }
         }
-
-        uint32_t n = MIN(voice->buffer_length, length);
-        uint32_t *src = voice->remaining_buffer;
-        uint16_t level = voice->level;
-
-        // First active voice gets copied over verbatim.
-        if (!voices_active) {
-            if (MP_LIKELY(self->bits_per_sample == 16)) {
-                if (MP_LIKELY(self->samples_signed)) {
-                    for (uint32_t i = 0; i<n; i++) {
-                        uint32_t v = src[i];
-                        word_buffer[i] = mult16signed(v, level);
-                    }
-                } else {
-                    for (uint32_t i = 0; i<n; i++) {
-                        uint32_t v = src[i];
-                        v = tosigned16(v);
-                        word_buffer[i] = mult16signed(v, level);
-                    }
+    } else {
+        if (MP_LIKELY(self->bits_per_sample == 16)) {
+            if (MP_LIKELY(src_signed)) {
+                for (uint32_t i = 0; i<n; i++) {
+                    uint32_t word = src[i];
+                    word_buffer[i] = add16signed(mult16signed(word, level), word_buffer[i]);
                 }
             } else {
-                uint16_t *hword_buffer = (uint16_t*)word_buffer;
-                uint16_t *hsrc = (uint16_t*)src;
-                for (uint32_t i = 0; i<n*2; i++) {
-                    uint32_t word = unpack8(hsrc[i]);
-                    if (MP_LIKELY(!self->samples_signed)) {
-                        word = tosigned16(word);
-                    }
-                    word = mult16signed(word, level);
-                    hword_buffer[i] = pack8(word);
+                for (uint32_t i = 0; i<n; i++) {
+                    uint32_t word = src[i];
+                    word = tosigned16(word);
+                    word_buffer[i] = add16signed(mult16signed(word, level), word_buffer[i]);
                 }
             }
         } else {
-            if (MP_LIKELY(self->bits_per_sample == 16)) {
-                if (MP_LIKELY(self->samples_signed)) {
-                    for (uint32_t i = 0; i<n; i++) {
-                        uint32_t word = src[i];
-                        word_buffer[i] = add16signed(mult16signed(word, level), word_buffer[i]);
-                    }
+            uint16_t *hword_buffer = (uint16_t*)word_buffer;
+            const uint16_t *hsrc = (const uint16_t*)src;
+            for (uint32_t i = 0; i<n*2; i++) {
+                uint32_t word = unpack8(hsrc[i]);
+                if (MP_LIKELY(!src_signed)) {
+                    word = tosigned16(word);
+                }
+                word = mult16signed(word, level);
+                word = add16signed(word, unpack8(hword_buffer[i]));
+                hword_buffer[i] = pack8(word);
+            }
+        }
+    }
+#else
+    if (MP_LIKELY(self->bits_per_sample == 16)) {
+        int16_t *out = (int16_t*)word_buffer;
+        const int16_t *in = (const int16_t*)src;
+        int32_t flip = src_signed ? 0 : 0x8000;
+        if (first) {
+            for (uint32_t i = 0; i < n * 2; i++) {
+                out[i] = mult16signed((int16_t)(in[i] ^ flip), level);
+            }
+        } else {
+            for (uint32_t i = 0; i < n * 2; i++) {
+                out[i] = saturate16(out[i] + mult16signed((int16_t)(in[i] ^ flip), level));
+            }
+        }
+    } else {
+        // 8-bit samples are mixed in the top byte of 16-bit lanes, like the DSP path.
+        int8_t *out = (int8_t*)word_buffer;
+        const int8_t *in = (const int8_t*)src;
+        int32_t flip = src_signed ? 0 : 0x80;
+        if (first) {
+            for (uint32_t i = 0; i < n * 4; i++) {
+                out[i] = mult16signed((int8_t)(in[i] ^ flip) * 256, level) >> 8;
+            }
+        } else {
+            for (uint32_t i = 0; i < n * 4; i++) {
+                out[i] = saturate16(out[i] * 256 + mult16signed((int8_t)(in[i] ^ flip) * 256, level)) >> 8;
+            }
+        }
+    }
+#endif
+}
+
+// Loads the voice's next buffer, starting the sample over when it loops. Returns false and stops
+// the voice when the sample has ended.
+static bool load_next_buffer(audiomixer_mixervoice_obj_t* voice) {
+    if (!voice->more_data) {
+        if (voice->loop) {
+            audiosample_reset_buffer(voice->sample, false, 0);
+        } else {
+            voice->sample = NULL;
+            return false;
+        }
+    }
+    audioio_get_buffer_result_t result = audiosample_get_buffer(voice->sample, false, 0, (uint8_t**) &voice->remaining_buffer, &voice->buffer_length);
+    // Track length in terms of words.
+    voice->buffer_length /= sizeof(uint32_t);
+    voice->more_data = result == GET_BUFFER_MORE_DATA;
+    voice->frame_in_word = 0;
+    return true;
+}
+
+// Fills out with up to length words of the voice's sample at the mixer's sample rate, linearly
+// interpolated between the sample's frames and converted to signed. Returns how many words were
+// filled, which is less than length once the sample ends.
+static uint32_t resample_voice(audiomixer_mixer_obj_t* self, audiomixer_mixervoice_obj_t* voice,
+        uint32_t* out, uint32_t length) {
+    uint8_t channel_count = self->channel_count;
+    uint8_t bytes_per_sample = self->bits_per_sample / 8;
+    uint8_t frame_size = channel_count * bytes_per_sample;
+    uint8_t frames_per_word = sizeof(uint32_t) / frame_size;
+    int32_t flip = self->samples_signed ? 0 : 1 << (self->bits_per_sample - 1);
+    int16_t *out16 = (int16_t*) out;
+    int8_t *out8 = (int8_t*) out;
+    uint32_t out_samples = length * frames_per_word * channel_count;
+    uint32_t i = 0;
+    while (i < out_samples) {
+        // The phase is the position between the previous frame and the current one. Move on
+        // to the frame before the output position first.
+        bool ended = false;
+        while (voice->resample_phase >= (1 << 16)) {
+            if (voice->buffer_length == 0 && (!load_next_buffer(voice) || voice->buffer_length == 0)) {
+                ended = true;
+                break;
+            }
+            const uint8_t* frame = (uint8_t*) voice->remaining_buffer + voice->frame_in_word * frame_size;
+            for (uint8_t c = 0; c < channel_count; c++) {
+                if (bytes_per_sample == 2) {
+                    voice->resample_previous[c] = (int16_t)(((const int16_t*) frame)[c] ^ flip);
                 } else {
-                    for (uint32_t i = 0; i<n; i++) {
-                        uint32_t word = src[i];
-                        word = tosigned16(word);
-                        word_buffer[i] = add16signed(mult16signed(word, level), word_buffer[i]);
-                        }
+                    voice->resample_previous[c] = (int8_t)(((const int8_t*) frame)[c] ^ flip);
                 }
-            } else {
-                uint16_t *hword_buffer = (uint16_t*)word_buffer;
-                uint16_t *hsrc = (uint16_t*)src;
-                for (uint32_t i = 0; i<n*2; i++) {
-                    uint32_t word = unpack8(hsrc[i]);
-                    if (MP_LIKELY(!self->samples_signed)) {
-                        word = tosigned16(word);
+            }
+            voice->frame_in_word++;
+            if (voice->frame_in_word == frames_per_word) {
+                voice->frame_in_word = 0;
+                voice->remaining_buffer++;
+                voice->buffer_length--;
+            }
+            voice->resample_phase -= 1 << 16;
+        }
+        if (ended || (voice->buffer_length == 0 && (!load_next_buffer(voice) || voice->buffer_length == 0))) {
+            // The last frame of a sample that has stopped is output as is.
+            if (voice->sample == NULL && voice->resample_phase == 0) {
+                for (uint8_t c = 0; c < channel_count; c++) {
+                    if (bytes_per_sample == 2) {
+                        out16[i++] = voice->resample_previous[c];
+                    } else {
+                        out8[i++] = voice->resample_previous[c];
                     }
-                    word = mult16signed(word, level);
-                    word = add16signed(word, unpack8(hword_buffer[i]));
-                    hword_buffer[i] = pack8(word);
                 }
             }
+            break;
         }
+        const uint8_t* frame = (uint8_t*) voice->remaining_buffer + voice->frame_in_word * frame_size;
+        // A 15 bit fraction keeps the product within 32 bits.
+        int32_t fraction = voice->resample_phase >> 1;
+        for (uint8_t c = 0; c < channel_count; c++) {
+            int32_t previous = voice->resample_previous[c];
+            if (bytes_per_sample == 2) {
+                int32_t current = (int16_t)(((const int16_t*) frame)[c] ^ flip);
+                out16[i++] = previous + (((current - previous) * fraction) >> 15);
+            } else {
+                int32_t current = (int8_t)(((const int8_t*) frame)[c] ^ flip);
+                out8[i++] = previous + (((current - previous) * fraction) >> 15);
+            }
+        }
+        voice->resample_phase += voice->resample_step;
+    }
+    // Silence the rest of a partly filled word.
+    uint32_t words = (i + frames_per_word * channel_count - 1) / (frames_per_word * channel_count);
+    for (; i < words * frames_per_word * channel_count; i++) {
+        if (bytes_per_sample == 2) {
+            out16[i] = 0;
+        } else {
+            out8[i] = 0;
+        }
+    }
+    return words;
+}
+
+static void mix_down_one_voice(audiomixer_mixer_obj_t* self,
+        audiomixer_mixervoice_obj_t* voice, bool voices_active,
+        uint32_t* word_buffer, uint32_t length) {
+    if (voice->resample_step != 0) {
+        uint32_t n = resample_voice(self, voice, self->resample_buffer, length);
+        mix_words(self, word_buffer, self->resample_buffer, n, voice->level, true, !voices_active);
+        length -= n;
+        word_buffer += n;
+    }
+    while (length != 0 && voice->resample_step == 0) {
+        if (voice->buffer_length == 0) {
+            if (!load_next_buffer(voice)) {
+                break;
+            }
+        }
+
+        uint32_t n = MIN(voice->buffer_length, length);
+        mix_words(self, word_buffer, voice->remaining_buffer, n, voice->level, self->samples_signed, !voices_active);
         length -= n;
         word_buffer += n;
         voice->remaining_buffer += n;
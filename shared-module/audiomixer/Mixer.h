@@ -36,6 +36,7 @@ typedef struct {
     mp_obj_base_t base;
     uint32_t* first_buffer;
     uint32_t* second_buffer;
+    uint32_t* resample_buffer; // one buffer of samples for resampling voices into
     uint32_t len; // in words
     uint8_t bits_per_sample;
     bool use_first_buffer;
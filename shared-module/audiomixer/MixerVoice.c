@@ -50,9 +50,6 @@ void common_hal_audiomixer_mixervoice_set_level(audiomixer_mixervoice_obj_t* sel
 }
 
 void common_hal_audiomixer_mixervoice_play(audiomixer_mixervoice_obj_t* self, mp_obj_t sample, bool loop) {
-    if (audiosample_sample_rate(sample) != self->parent->sample_rate) {
-        mp_raise_ValueError(translate("The sample's sample rate does not match the mixer's"));
-    }
     if (audiosample_channel_count(sample) != self->parent->channel_count) {
         mp_raise_ValueError(translate("The sample's channel count does not match the mixer's"));
     }
@@ -68,6 +65,21 @@ void common_hal_audiomixer_mixervoice_play(audiomixer_mixervoice_obj_t* self, mp
     if (samples_signed != self->parent->samples_signed) {
         mp_raise_ValueError(translate("The sample's signedness does not match the mixer's"));
     }
+    // Samples at other rates are resampled as they're mixed.
+    uint32_t sample_rate = audiosample_sample_rate(sample);
+    self->resample_step = 0;
+    if (sample_rate != self->parent->sample_rate) {
+        if (self->parent->resample_buffer == NULL) {
+            self->parent->resample_buffer = m_malloc(self->parent->len, false);
+        }
+        self->resample_step = ((uint64_t) sample_rate << 16) / self->parent->sample_rate;
+        if (self->resample_step == 0) {
+            self->resample_step = 1;
+        }
+    }
+    // Start on the first frame.
+    self->resample_phase = 1 << 16;
+    self->frame_in_word = 0;
     self->sample = sample;
     self->loop = loop;
 
@@ -40,6 +40,11 @@ typedef struct {
     uint32_t* remaining_buffer;
     uint32_t buffer_length;
     uint16_t level;
+    // Sample frames per mixer frame in 16.16 fixed point, or 0 when the rates match.
+    uint32_t resample_step;
+    uint32_t resample_phase;
+    uint8_t frame_in_word;
+    int16_t resample_previous[2];
 } audiomixer_mixervoice_obj_t;
 
 
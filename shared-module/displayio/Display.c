@@ -34,6 +34,7 @@
 #include "shared-bindings/time/__init__.h"
 #include "shared-module/displayio/__init__.h"
 #include "shared-module/displayio/display_core.h"
+#include "shared-module/displayio/tiles.h"
 #include "supervisor/shared/display.h"
 #include "supervisor/shared/tick.h"
 #include "supervisor/usb.h"
@@ -325,16 +326,27 @@ STATIC bool _refresh_area(displayio_display_obj_t* self, const displayio_area_t*
     return true;
 }
 
+#if CIRCUITPY_DISPLAYIO_TILE_SIZE > 0
+STATIC bool _refresh_tile_area(void* self, const displayio_area_t* area) {
+    return _refresh_area(self, area);
+}
+#endif
+
 STATIC void _refresh_display(displayio_display_obj_t* self) {
     if (!displayio_display_core_start_refresh(&self->core)) {
         // A refresh on this bus is already in progress.  Try next display.
         return;
     }
     const displayio_area_t* current_area = _get_refresh_areas(self);
+    #if CIRCUITPY_DISPLAYIO_TILE_SIZE > 0
+    displayio_tiles_refresh(&self->core, current_area, CIRCUITPY_DISPLAYIO_TILE_SIZE,
+        _refresh_tile_area, self);
+    #else
     while (current_area != NULL) {
         _refresh_area(self, current_area);
         current_area = current_area->next;
     }
+    #endif
     displayio_display_core_finish_refresh(&self->core);
 }
 
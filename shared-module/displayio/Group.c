@@ -368,6 +368,55 @@ bool displayio_group_fill_area(displayio_group_t *self, const _displayio_colorsp
     return full_coverage;
 }
 
+size_t displayio_group_get_layers(displayio_group_t *self, const displayio_area_t* area, mp_obj_t* layers, size_t count, size_t max) {
+    for (int32_t i = self->size - 1; i >= 0 ; i--) {
+        mp_obj_t layer = self->children[i].native;
+#if CIRCUITPY_VECTORIO
+        if (MP_OBJ_IS_TYPE(layer, &vectorio_vector_shape_type)) {
+            // Vector shapes check their own bounds when filling.
+        }
+        else
+#endif
+        if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
+            displayio_tilegrid_t* tilegrid = layer;
+            displayio_area_t overlap;
+            if (tilegrid->hidden || tilegrid->hidden_by_parent ||
+                !displayio_area_compute_overlap(area, &tilegrid->current_area, &overlap)) {
+                continue;
+            }
+        } else if (MP_OBJ_IS_TYPE(layer, &displayio_group_type)) {
+            count = displayio_group_get_layers(layer, area, layers, count, max);
+            if (count > max) {
+                return count;
+            }
+            continue;
+        }
+        if (count == max) {
+            return max + 1;
+        }
+        layers[count++] = layer;
+    }
+    return count;
+}
+
+bool displayio_layers_fill_area(const mp_obj_t* layers, size_t count, const _displayio_colorspace_t* colorspace, const displayio_area_t* area, uint32_t* mask, uint32_t* buffer) {
+    for (size_t i = 0; i < count; i++) {
+        mp_obj_t layer = layers[i];
+#if CIRCUITPY_VECTORIO
+        if (MP_OBJ_IS_TYPE(layer, &vectorio_vector_shape_type)) {
+            if (vectorio_vector_shape_fill_area(layer, colorspace, area, mask, buffer)) {
+                return true;
+            }
+        }
+        else
+#endif
+        if (displayio_tilegrid_fill_area(layer, colorspace, area, mask, buffer)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void displayio_group_finish_refresh(displayio_group_t *self) {
     self->item_removed = false;
     for (int32_t i = self->size - 1; i >= 0 ; i--) {
@@ -60,6 +60,12 @@ void displayio_group_construct(displayio_group_t* self, displayio_group_child_t*
 void displayio_group_set_hidden_by_parent(displayio_group_t *self, bool hidden);
 bool displayio_group_get_previous_area(displayio_group_t *group, displayio_area_t* area);
 bool displayio_group_fill_area(displayio_group_t *group, const _displayio_colorspace_t* colorspace, const displayio_area_t* area, uint32_t* mask, uint32_t *buffer);
+// Appends the TileGrids and vector shapes of group that may draw into area to
+// layers[count:], topmost first, and returns the new count. Returns max + 1 if
+// they do not all fit.
+size_t displayio_group_get_layers(displayio_group_t *group, const displayio_area_t* area, mp_obj_t* layers, size_t count, size_t max);
+// Fills area from a list made by displayio_group_get_layers.
+bool displayio_layers_fill_area(const mp_obj_t* layers, size_t count, const _displayio_colorspace_t* colorspace, const displayio_area_t* area, uint32_t* mask, uint32_t *buffer);
 void displayio_group_update_transform(displayio_group_t *group, const displayio_buffer_transform_t* parent_transform);
 void displayio_group_finish_refresh(displayio_group_t *self);
 displayio_area_t* displayio_group_get_refresh_areas(displayio_group_t *self, displayio_area_t* tail);
@@ -117,15 +117,120 @@ void common_hal_displayio_ondiskbitmap_construct(displayio_ondiskbitmap_t *self,
         self->stride = (bit_stride / 8);
     }
 
+    #if CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHED_ROWS > 0
+    // The decoded rows and the raw row they are read into share one allocation. Fall back to
+    // reading pixels individually when it doesn't fit.
+    size_t cache_size = CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHED_ROWS * self->width * sizeof(uint32_t);
+    self->row_cache = m_malloc_maybe(cache_size + self->stride, false);
+    if (self->row_cache != NULL) {
+        self->row_buffer = ((uint8_t*) self->row_cache) + cache_size;
+    }
+    for (uint8_t i = 0; i < CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHED_ROWS; i++) {
+        self->cached_row[i] = -1;
+    }
+    self->next_cached_row = 0;
+    #endif
 }
 
 
+// Converts the bytes_per_pixel little endian bytes of the pixel at x into RGB888.
+static uint32_t decode_pixel(displayio_ondiskbitmap_t *self, uint32_t pixel_data, int16_t x) {
+    uint8_t bytes_per_pixel = (self->bits_per_pixel / 8)  ? (self->bits_per_pixel /8) : 1;
+    uint8_t pixels_per_byte = 8 / self->bits_per_pixel;
+    uint32_t tmp = 0;
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    if (bytes_per_pixel == 1) {
+        uint8_t offset = (x % pixels_per_byte) * self->bits_per_pixel;
+        uint8_t mask = (1 << self->bits_per_pixel) - 1;
+
+        uint8_t index = (pixel_data >> ((8 - self->bits_per_pixel) - offset)) & mask;
+        if (self->bits_per_pixel == 1) {
+            if (index == 1) {
+                return 0xFFFFFF;
+            } else {
+                return 0x000000;
+            }
+        }
+        return self->palette_data[index];
+    } else if (bytes_per_pixel == 2) {
+        if (self->g_bitmask == 0x07e0) { // 565
+            red =((pixel_data & self->r_bitmask) >>11);
+            green = ((pixel_data & self->g_bitmask) >>5);
+            blue = ((pixel_data & self->b_bitmask) >> 0);
+        } else { // 555
+            red =((pixel_data & self->r_bitmask) >>10);
+            green = ((pixel_data & self->g_bitmask) >>4);
+            blue = ((pixel_data & self->b_bitmask) >> 0);
+        }
+        tmp = (red << 19 | green << 10 | blue << 3);
+        return tmp;
+    } else if ((bytes_per_pixel == 4) && (self->bitfield_compressed)) {
+        return pixel_data & 0x00FFFFFF;
+    } else {
+        return pixel_data;
+    }
+}
+
+#if CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHED_ROWS > 0
+const uint32_t* displayio_ondiskbitmap_get_row(displayio_ondiskbitmap_t *self, int16_t y) {
+    if (self->row_cache == NULL || y < 0 || y >= self->height) {
+        return NULL;
+    }
+    for (uint8_t i = 0; i < CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHED_ROWS; i++) {
+        if (self->cached_row[i] == y) {
+            return self->row_cache + i * self->width;
+        }
+    }
+
+    // Rows are stored bottom up.
+    uint32_t location = self->data_offset + (self->height - y - 1) * self->stride;
+    UINT bytes_read;
+    if (f_lseek(&self->file->fp, location) != FR_OK ||
+        f_read(&self->file->fp, self->row_buffer, self->stride, &bytes_read) != FR_OK ||
+        bytes_read != self->stride) {
+        return NULL;
+    }
+
+    uint8_t slot = self->next_cached_row;
+    self->next_cached_row = (slot + 1) % CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHED_ROWS;
+    uint32_t* row = self->row_cache + slot * self->width;
+    uint8_t bytes_per_pixel = (self->bits_per_pixel / 8)  ? (self->bits_per_pixel /8) : 1;
+    uint8_t pixels_per_byte = 8 / self->bits_per_pixel;
+    for (uint16_t x = 0; x < self->width; x++) {
+        const uint8_t* data;
+        if (pixels_per_byte == 0) {
+            data = self->row_buffer + x * bytes_per_pixel;
+        } else {
+            data = self->row_buffer + x / pixels_per_byte;
+        }
+        uint32_t pixel_data = 0;
+        for (uint8_t i = 0; i < bytes_per_pixel; i++) {
+            pixel_data |= data[i] << (8 * i);
+        }
+        row[x] = decode_pixel(self, pixel_data, x);
+    }
+    self->cached_row[slot] = y;
+    return row;
+}
+#else
+const uint32_t* displayio_ondiskbitmap_get_row(displayio_ondiskbitmap_t *self, int16_t y) {
+    return NULL;
+}
+#endif
+
 uint32_t common_hal_displayio_ondiskbitmap_get_pixel(displayio_ondiskbitmap_t *self,
         int16_t x, int16_t y) {
     if (x < 0 || x >= self->width || y < 0 || y >= self->height) {
         return 0;
     }
 
+    const uint32_t* row = displayio_ondiskbitmap_get_row(self, y);
+    if (row != NULL) {
+        return row[x];
+    }
+
     uint32_t location;
     uint8_t bytes_per_pixel = (self->bits_per_pixel / 8)  ? (self->bits_per_pixel /8) : 1;
     uint8_t pixels_per_byte = 8 / self->bits_per_pixel;
@@ -134,46 +239,13 @@ uint32_t common_hal_displayio_ondiskbitmap_get_pixel(displayio_ondiskbitmap_t *s
     } else {
         location = self->data_offset + (self->height - y - 1) * self->stride + x / pixels_per_byte;
     }
-    // We don't cache here because the underlying FS caches sectors.
+    // Without a row cache we rely on the underlying FS to cache sectors.
     f_lseek(&self->file->fp, location);
     UINT bytes_read;
     uint32_t pixel_data = 0;
     uint32_t result = f_read(&self->file->fp, &pixel_data, bytes_per_pixel, &bytes_read);
     if (result == FR_OK) {
-        uint32_t tmp = 0;
-        uint8_t red;
-        uint8_t green;
-        uint8_t blue;
-        if (bytes_per_pixel == 1) {
-            uint8_t offset = (x % pixels_per_byte) * self->bits_per_pixel;
-            uint8_t mask = (1 << self->bits_per_pixel) - 1;
-
-            uint8_t index = (pixel_data >> ((8 - self->bits_per_pixel) - offset)) & mask;
-            if (self->bits_per_pixel == 1) {
-                if (index == 1) {
-                    return 0xFFFFFF;
-                } else {
-                    return 0x000000;
-                }
-            }
-            return self->palette_data[index];
-        } else if (bytes_per_pixel == 2) {
-            if (self->g_bitmask == 0x07e0) { // 565
-                red =((pixel_data & self->r_bitmask) >>11);
-                green = ((pixel_data & self->g_bitmask) >>5);
-                blue = ((pixel_data & self->b_bitmask) >> 0);
-            } else { // 555
-                red =((pixel_data & self->r_bitmask) >>10);
-                green = ((pixel_data & self->g_bitmask) >>4);
-                blue = ((pixel_data & self->b_bitmask) >> 0);
-            }
-            tmp = (red << 19 | green << 10 | blue << 3);
-            return tmp;
-        } else if ((bytes_per_pixel == 4) && (self->bitfield_compressed)) {
-            return pixel_data & 0x00FFFFFF;
-        } else {
-            return pixel_data;
-        }
+        return decode_pixel(self, pixel_data, x);
     }
     return 0;
 }
@@ -47,6 +47,17 @@ typedef struct {
     pyb_file_obj_t* file;
     uint8_t bits_per_pixel;
     uint32_t* palette_data;
+    #if CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHED_ROWS > 0
+    // Decoded rows of width pixels each. NULL when there wasn't room for them, in which
+    // case pixels are read from the file one at a time.
+    uint32_t* row_cache;
+    uint8_t* row_buffer;
+    int16_t cached_row[CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHED_ROWS];
+    uint8_t next_cached_row;
+    #endif
 } displayio_ondiskbitmap_t;
 
+// Returns the decoded RGB888 pixels of row y, or NULL if the row can't be read.
+const uint32_t* displayio_ondiskbitmap_get_row(displayio_ondiskbitmap_t *self, int16_t y);
+
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_ONDISKBITMAP_H
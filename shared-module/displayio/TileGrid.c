@@ -316,6 +316,121 @@ void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint
     self->full_change = true;
 }
 
+// Reads the value at x of a bitmap row without bounds checks.
+static inline uint32_t _bitmap_row_value(const displayio_bitmap_t *bitmap, const size_t* row, uint16_t x) {
+    switch (bitmap->bits_per_value) {
+        case 8:
+            return ((const uint8_t*) row)[x];
+        case 16:
+            return ((const uint16_t*) row)[x];
+        case 32:
+            return ((const uint32_t*) row)[x];
+        default: {
+            size_t word = row[x >> bitmap->x_shift];
+            return (word >> (sizeof(size_t) * 8 - ((x & bitmap->x_mask) + 1) * bitmap->bits_per_value)) & bitmap->bitmask;
+        }
+    }
+}
+
+// Fills area for the common case of a Bitmap or OnDiskBitmap shaded by a Palette or an
+// undithered ColorConverter that isn't flipped, transposed or scaled, onto a 16 bit display.
+// Rows are filled in runs of pixels from the same tile, and the mask is read and
+// written a word at a time. OnDiskBitmaps are read a decoded row at a time.
+STATIC bool _fill_area_rgb565(displayio_tilegrid_t *self, const _displayio_colorspace_t* colorspace,
+    const uint8_t* tiles, uint32_t* mask, uint16_t* buffer, uint32_t start, int16_t y_stride,
+    int16_t start_x, int16_t end_x, int16_t start_y, int16_t end_y, int16_t x_shift, int16_t y_shift,
+    bool full_coverage) {
+    displayio_bitmap_t *bitmap = NULL;
+    displayio_ondiskbitmap_t *disk_bitmap = NULL;
+    if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_bitmap_type)) {
+        bitmap = self->bitmap;
+    } else {
+        disk_bitmap = self->bitmap;
+    }
+    const displayio_palette_t *palette = NULL;
+    const displayio_colorconverter_t *converter = NULL;
+    if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type)) {
+        palette = self->pixel_shader;
+    } else {
+        converter = self->pixel_shader;
+    }
+    bool swap = colorspace->reverse_bytes_in_word;
+
+    for (int16_t y = start_y; y < end_y; y++) {
+        uint32_t offset = start + (y - start_y + y_shift) * y_stride + x_shift;
+        uint16_t tile_row = ((y / self->tile_height + self->top_left_y) % self->height_in_tiles) * self->width_in_tiles;
+        uint16_t y_in_tile = y % self->tile_height;
+        for (int16_t x = start_x; x < end_x; ) {
+            uint16_t x_in_tile = x % self->tile_width;
+            uint16_t run = MIN(self->tile_width - x_in_tile, end_x - x);
+            uint8_t tile = tiles[tile_row + (x / self->tile_width + self->top_left_x) % self->width_in_tiles];
+            uint16_t tile_x = (tile % self->bitmap_width_in_tiles) * self->tile_width + x_in_tile;
+            uint16_t tile_y = (tile / self->bitmap_width_in_tiles) * self->tile_height + y_in_tile;
+            const size_t* row = NULL;
+            const uint32_t* disk_row = NULL;
+            // Pixels outside of the bitmap read as 0, like common_hal_displayio_bitmap_get_pixel.
+            uint16_t limit = 0;
+            if (bitmap != NULL) {
+                row = bitmap->data + tile_y * bitmap->stride;
+                limit = tile_y < bitmap->height ? bitmap->width : 0;
+            } else {
+                disk_row = displayio_ondiskbitmap_get_row(disk_bitmap, tile_y);
+                limit = disk_row != NULL ? disk_bitmap->width : 0;
+            }
+            x += run;
+
+            while (run > 0) {
+                uint32_t* word = &mask[offset / 32];
+                uint8_t first_bit = offset % 32;
+                uint8_t count = MIN(run, 32 - first_bit);
+                uint32_t done = *word;
+                uint32_t set = 0;
+                if (done != 0xffffffff) {
+                    for (uint8_t i = 0; i < count; i++) {
+                        uint32_t bit = 1u << (first_bit + i);
+                        if ((done & bit) != 0) {
+                            continue;
+                        }
+                        uint16_t value_x = tile_x + i;
+                        uint32_t value;
+                        if (row != NULL) {
+                            value = value_x < limit ? _bitmap_row_value(bitmap, row, value_x) : 0;
+                        } else if (disk_row != NULL) {
+                            value = value_x < limit ? disk_row[value_x] : 0;
+                        } else {
+                            value = common_hal_displayio_ondiskbitmap_get_pixel(disk_bitmap, value_x, tile_y);
+                        }
+                        uint16_t color;
+                        if (palette != NULL) {
+                            if (value >= palette->color_count || palette->colors[value].transparent) {
+                                full_coverage = false;
+                                continue;
+                            }
+                            color = palette->colors[value].rgb565;
+                        } else {
+                            if (value == converter->transparent_color) {
+                                full_coverage = false;
+                                continue;
+                            }
+                            color = displayio_colorconverter_compute_rgb565(value);
+                        }
+                        if (swap) {
+                            color = __builtin_bswap16(color);
+                        }
+                        buffer[offset + i] = color;
+                        set |= bit;
+                    }
+                    *word = done | set;
+                }
+                tile_x += count;
+                offset += count;
+                run -= count;
+            }
+        }
+    }
+    return full_coverage;
+}
+
 bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self, const _displayio_colorspace_t* colorspace, const displayio_area_t* area, uint32_t* mask, uint32_t *buffer) {
     // If no tiles are present we have no impact.
     uint8_t* tiles = self->tiles;
@@ -401,6 +516,18 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self, const _displayio_c
         y_shift = temp_shift;
     }
 
+    if (colorspace->depth == 16 && !colorspace->grayscale && !colorspace->tricolor &&
+        x_stride == 1 && y_stride > 0 && self->transpose_xy == self->absolute_transform->transpose_xy &&
+        self->absolute_transform->scale == 1 &&
+        (MP_OBJ_IS_TYPE(self->bitmap, &displayio_bitmap_type) ||
+         MP_OBJ_IS_TYPE(self->bitmap, &displayio_ondiskbitmap_type)) &&
+        (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type) ||
+         (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_colorconverter_type) &&
+          !((displayio_colorconverter_t*) self->pixel_shader)->dither))) {
+        return _fill_area_rgb565(self, colorspace, tiles, mask, (uint16_t*) buffer, start, y_stride,
+            start_x, end_x, start_y, end_y, x_shift, y_shift, full_coverage);
+    }
+
     uint8_t pixels_per_byte = 8 / colorspace->depth;
 
     displayio_input_pixel_t input_pixel;
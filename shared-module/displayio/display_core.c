@@ -55,6 +55,7 @@ void displayio_display_core_construct(displayio_display_core_t* self,
     self->colorspace.reverse_bytes_in_word = reverse_bytes_in_word;
     self->colorspace.dither = false;
     self->current_group = NULL;
+    self->layers = NULL;
     self->colstart = colstart;
     self->rowstart = rowstart;
     self->last_refresh = 0;
@@ -354,6 +355,9 @@ void displayio_display_core_collect_ptrs(displayio_display_core_t* self) {
 }
 
 bool displayio_display_core_fill_area(displayio_display_core_t *self, displayio_area_t* area, uint32_t* mask, uint32_t *buffer) {
+    if (self->layers != NULL) {
+        return displayio_layers_fill_area(self->layers, self->layer_count, &self->colorspace, area, mask, buffer);
+    }
     return displayio_group_fill_area(self->current_group, &self->colorspace, area, mask, buffer);
 }
 
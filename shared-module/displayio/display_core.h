@@ -53,6 +53,10 @@ typedef struct {
     _displayio_colorspace_t colorspace;
     int16_t colstart;
     int16_t rowstart;
+    // Layers that may draw into the area being refreshed, set by the tiled
+    // renderer. NULL means walk the whole group.
+    const mp_obj_t *layers;
+    size_t layer_count;
     bool full_refresh; // New group means we need to refresh the whole display.
     bool refresh_in_progress;
 } displayio_display_core_t;
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2021 MicroPython & CircuitPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-module/displayio/tiles.h"
+
+#include <string.h>
+
+#include "shared-module/displayio/Group.h"
+
+#define TILE_WORD(i) ((i) / 32)
+#define TILE_BIT(i) (1u << ((i) % 32))
+
+static inline bool _tile_dirty(const uint32_t* dirty, uint32_t i) {
+    return (dirty[TILE_WORD(i)] & TILE_BIT(i)) != 0;
+}
+
+void displayio_tiles_refresh(displayio_display_core_t* core, const displayio_area_t* areas,
+    uint16_t tile_size, displayio_tiles_refresh_area_fn refresh_area, void* display) {
+    const displayio_area_t* screen = &core->area;
+    uint16_t columns = (displayio_area_width(screen) + tile_size - 1) / tile_size;
+    uint16_t rows = (displayio_area_height(screen) + tile_size - 1) / tile_size;
+    uint32_t dirty[(columns * rows + 31) / 32];
+    memset(dirty, 0, sizeof(dirty));
+
+    // Mark every tile touched by a dirty area.
+    for (const displayio_area_t* area = areas; area != NULL; area = area->next) {
+        displayio_area_t clipped;
+        if (!displayio_area_compute_overlap(screen, area, &clipped)) {
+            continue;
+        }
+        uint16_t c1 = (clipped.x1 - screen->x1) / tile_size;
+        uint16_t c2 = (clipped.x2 - screen->x1 - 1) / tile_size;
+        uint16_t r1 = (clipped.y1 - screen->y1) / tile_size;
+        uint16_t r2 = (clipped.y2 - screen->y1 - 1) / tile_size;
+        for (uint16_t r = r1; r <= r2; r++) {
+            for (uint16_t c = c1; c <= c2; c++) {
+                uint32_t i = r * columns + c;
+                dirty[TILE_WORD(i)] |= TILE_BIT(i);
+            }
+        }
+    }
+
+    mp_obj_t layers[DISPLAYIO_TILES_MAX_LAYERS];
+    for (uint16_t r = 0; r < rows; r++) {
+        for (uint16_t c = 0; c < columns; c++) {
+            if (!_tile_dirty(dirty, r * columns + c)) {
+                continue;
+            }
+            // Grow a rectangle right along the row, then down while every tile
+            // beneath it is dirty too.
+            uint16_t c2 = c + 1;
+            while (c2 < columns && _tile_dirty(dirty, r * columns + c2)) {
+                c2++;
+            }
+            uint16_t r2 = r + 1;
+            while (r2 < rows) {
+                uint16_t k = c;
+                while (k < c2 && _tile_dirty(dirty, r2 * columns + k)) {
+                    k++;
+                }
+                if (k < c2) {
+                    break;
+                }
+                r2++;
+            }
+            for (uint16_t rr = r; rr < r2; rr++) {
+                for (uint16_t cc = c; cc < c2; cc++) {
+                    uint32_t i = rr * columns + cc;
+                    dirty[TILE_WORD(i)] &= ~TILE_BIT(i);
+                }
+            }
+
+            displayio_area_t rect = {
+                .x1 = screen->x1 + c * tile_size,
+                .y1 = screen->y1 + r * tile_size,
+                .x2 = screen->x1 + c2 * tile_size,
+                .y2 = screen->y1 + r2 * tile_size,
+                .next = NULL
+            };
+            // Trim the rectangle back to the dirty areas inside it so that
+            // rounding out to whole tiles doesn't add pixels to redraw.
+            displayio_area_t dirty_bounds;
+            bool first = true;
+            for (const displayio_area_t* area = areas; area != NULL; area = area->next) {
+                displayio_area_t overlap;
+                if (!displayio_area_compute_overlap(&rect, area, &overlap)) {
+                    continue;
+                }
+                if (first) {
+                    displayio_area_copy(&overlap, &dirty_bounds);
+                    first = false;
+                } else {
+                    displayio_area_expand(&dirty_bounds, &overlap);
+                }
+            }
+            displayio_area_copy(&dirty_bounds, &rect);
+
+            // Only the layers that overlap this rectangle are composited into it.
+            if (core->current_group != NULL) {
+                size_t count = displayio_group_get_layers(core->current_group, &rect, layers, 0, DISPLAYIO_TILES_MAX_LAYERS);
+                if (count <= DISPLAYIO_TILES_MAX_LAYERS) {
+                    core->layers = layers;
+                    core->layer_count = count;
+                }
+            }
+            refresh_area(display, &rect);
+            core->layers = NULL;
+            c = c2 - 1;
+        }
+    }
+}
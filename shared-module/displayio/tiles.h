@@ -0,0 +1,45 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2021 MicroPython & CircuitPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_TILES_H
+#define MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_TILES_H
+
+#include "shared-module/displayio/area.h"
+#include "shared-module/displayio/display_core.h"
+
+// Most layers culled into a tile rectangle. Rectangles covered by more layers
+// fall back to walking the whole group.
+#define DISPLAYIO_TILES_MAX_LAYERS (32)
+
+typedef bool (*displayio_tiles_refresh_area_fn)(void* display, const displayio_area_t* area);
+
+// Marks the tile_size square tiles touched by areas as dirty, merges them into
+// rectangles and calls refresh_area once per rectangle with core->layers set
+// to the layers that overlap it.
+void displayio_tiles_refresh(displayio_display_core_t* core, const displayio_area_t* areas,
+    uint16_t tile_size, displayio_tiles_refresh_area_fn refresh_area, void* display);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_TILES_H
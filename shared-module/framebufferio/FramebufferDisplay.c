@@ -33,6 +33,7 @@
 #include "shared-bindings/time/__init__.h"
 #include "shared-module/displayio/__init__.h"
 #include "shared-module/displayio/display_core.h"
+#include "shared-module/displayio/tiles.h"
 #include "supervisor/shared/display.h"
 #include "supervisor/shared/tick.h"
 #include "supervisor/usb.h"
@@ -251,6 +252,18 @@ STATIC bool _refresh_area(framebufferio_framebufferdisplay_obj_t* self, const di
     return true;
 }
 
+#if CIRCUITPY_DISPLAYIO_TILE_SIZE > 0
+typedef struct {
+    framebufferio_framebufferdisplay_obj_t* self;
+    uint8_t *dirty_row_bitmask;
+} _tile_refresh_t;
+
+STATIC bool _refresh_tile_area(void* context, const displayio_area_t* area) {
+    _tile_refresh_t* refresh = context;
+    return _refresh_area(refresh->self, area, refresh->dirty_row_bitmask);
+}
+#endif
+
 STATIC void _refresh_display(framebufferio_framebufferdisplay_obj_t* self) {
     self->framebuffer_protocol->get_bufinfo(self->framebuffer, &self->bufinfo);
     if(!self->bufinfo.buf) {
@@ -262,10 +275,16 @@ STATIC void _refresh_display(framebufferio_framebufferdisplay_obj_t* self) {
         uint8_t dirty_row_bitmask[(self->core.height + 7) / 8];
         memset(dirty_row_bitmask, 0, sizeof(dirty_row_bitmask));
         self->framebuffer_protocol->get_bufinfo(self->framebuffer, &self->bufinfo);
+        #if CIRCUITPY_DISPLAYIO_TILE_SIZE > 0
+        _tile_refresh_t refresh = { self, dirty_row_bitmask };
+        displayio_tiles_refresh(&self->core, current_area, CIRCUITPY_DISPLAYIO_TILE_SIZE,
+            _refresh_tile_area, &refresh);
+        #else
         while (current_area != NULL) {
             _refresh_area(self, current_area, dirty_row_bitmask);
             current_area = current_area->next;
         }
+        #endif
         self->framebuffer_protocol->swapbuffers(self->framebuffer, dirty_row_bitmask);
     }
     displayio_display_core_finish_refresh(&self->core);
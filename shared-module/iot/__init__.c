@@ -32,16 +32,67 @@
 #include "py/stream.h"
 #include "py/mpstate.h"
 #include "py/runtime.h"
+#include "py/ringbuf.h"
 #include "lib/utils/interrupt_char.h"
+#include "supervisor/shared/tick.h"
 
 #include "shared-bindings/iot/__init__.h"
+#include "shared-bindings/time/__init__.h"
+#include "shared-module/iot/__init__.h"
 
 
+STATIC size_t dupterm_flush(iot_dupterm_buffer_t *buffer);
+
 void shared_module_iot_dupterm(mp_obj_t term) {
+    // the old terminal gets what was written while it was in place
+    shared_module_iot_dupterm_buffer(0, false);
     MP_STATE_VM(dupterm_objs[0]) = term;
 }
 
-mp_obj_t shared_module_iot_terminal() {
+void shared_module_iot_dupterm_buffer(size_t size, bool block) {
+    iot_dupterm_buffer_t *buffer = MP_STATE_VM(iot_dupterm_buffer);
+    if (buffer != NULL) {
+        dupterm_flush(buffer);
+        if (buffer->pending) {
+            // the terminal didn't take all of it
+            supervisor_disable_tick();
+        }
+        MP_STATE_VM(iot_dupterm_buffer) = NULL;
+        ringbuf_free(&buffer->ringbuf);
+        m_del_obj(iot_dupterm_buffer_t, buffer);
+    }
+    if (size == 0) {
+        return;
+    }
+    buffer = m_new_obj(iot_dupterm_buffer_t);
+    if (!ringbuf_alloc(&buffer->ringbuf, size, true)) {
+        m_malloc_fail(size);
+    }
+    buffer->pending = false;
+    buffer->dropped = 0;
+    buffer->block = block;
+    buffer->flushing = false;
+    MP_STATE_VM(iot_dupterm_buffer) = buffer;
+}
+
+void shared_module_iot_dupterm_flush(void) {
+    iot_dupterm_buffer_t *buffer = MP_STATE_VM(iot_dupterm_buffer);
+    if (buffer != NULL) {
+        dupterm_flush(buffer);
+    }
+}
+
+size_t shared_module_iot_dupterm_pending(void) {
+    iot_dupterm_buffer_t *buffer = MP_STATE_VM(iot_dupterm_buffer);
+    return buffer == NULL ? 0 : ringbuf_num_filled(&buffer->ringbuf);
+}
+
+uint32_t shared_module_iot_dupterm_dropped(void) {
+    iot_dupterm_buffer_t *buffer = MP_STATE_VM(iot_dupterm_buffer);
+    return buffer == NULL ? 0 : buffer->dropped;
+}
+
+mp_obj_t shared_module_iot_terminal(void) {
     if (MP_STATE_VM(dupterm_objs[0]) == MP_OBJ_NULL) {
         MP_STATE_VM(dupterm_objs[0]) = mp_const_none;
     }
@@ -57,7 +108,7 @@ STATIC void dupterm_deactivate(const char *msg, mp_obj_t exc) {
     }
 }
 
-bool common_hal_dupterm_bytes_available() {
+bool common_hal_dupterm_bytes_available(void) {
     mp_obj_t terminal = MP_STATE_VM(dupterm_objs[0]);
     if (terminal == MP_OBJ_NULL || terminal == mp_const_none) {
         return false;
@@ -71,26 +122,31 @@ bool common_hal_dupterm_bytes_available() {
     return false;
 }
 
-STATIC void dupterm_read_write(void *buf, mp_uint_t size, qstr qst) {
+// Calls terminal.readinto or terminal.write with buf, returning how many bytes it
+// says it read or wrote. None, as from a non-blocking stream with no room, counts as 0.
+STATIC mp_uint_t dupterm_read_write(void *buf, mp_uint_t size, qstr qst) {
     mp_obj_t terminal = MP_STATE_VM(dupterm_objs[0]);
     if (terminal == MP_OBJ_NULL || terminal == mp_const_none) {
-        return;
+        return 0;
     }
+    mp_uint_t n = 0;
     nlr_buf_t nlr;
     if (nlr_push(&nlr) == 0) {
         mp_obj_t dest[3];
         mp_load_method_maybe(terminal, qst, dest);
-        if (dest[1] == MP_OBJ_NULL) {
-            // method does not exist
-            return;
+        if (dest[1] != MP_OBJ_NULL) {
+            mp_obj_array_t ar = {{&mp_type_bytearray}, BYTEARRAY_TYPECODE, 0, size, buf};
+            dest[2] = MP_OBJ_FROM_PTR(&ar);
+            mp_obj_t ret = mp_call_method_n_kw(1, 0, dest);
+            if (ret != mp_const_none) {
+                n = MIN((mp_uint_t)mp_obj_get_int(ret), size);
+            }
         }
-        mp_obj_array_t ar = {{&mp_type_bytearray}, BYTEARRAY_TYPECODE, 0, size, buf};
-        dest[2] = MP_OBJ_FROM_PTR(&ar);;
-        mp_call_method_n_kw(1, 0, dest);
         nlr_pop();
     } else {
         dupterm_deactivate("dupterm: Exception in read/write, deactivating: ", MP_OBJ_FROM_PTR(nlr.ret_val));
     }
+    return n;
 }
 
 char common_hal_dupterm_read(void) {
@@ -99,6 +155,92 @@ char common_hal_dupterm_read(void) {
     return text[0];
 }
 
+STATIC bool dupterm_active(void) {
+    mp_obj_t terminal = MP_STATE_VM(dupterm_objs[0]);
+    return terminal != MP_OBJ_NULL && terminal != mp_const_none;
+}
+
+// Write what is buffered to the terminal, one write per contiguous span. If the
+// terminal takes less than it is given, the rest waits for the next background
+// flush. Returns the number of bytes written.
+STATIC size_t dupterm_flush(iot_dupterm_buffer_t *buffer) {
+    if (buffer->flushing) {
+        return 0;
+    }
+    buffer->flushing = true;
+    size_t written = 0;
+    uint8_t *data;
+    size_t len;
+    while ((len = ringbuf_peek_span(&buffer->ringbuf, &data)) > 0) {
+        if (!dupterm_active()) {
+            // deactivated by an exception in write
+            ringbuf_clear(&buffer->ringbuf);
+            break;
+        }
+        size_t n = dupterm_read_write(data, len, MP_QSTR_write);
+        ringbuf_skip_n(&buffer->ringbuf, n);
+        written += n;
+        if (n < len) {
+            break;
+        }
+    }
+    buffer->flushing = false;
+    if (buffer->pending) {
+        if (ringbuf_num_filled(&buffer->ringbuf) == 0) {
+            buffer->pending = false;
+            supervisor_disable_tick();
+        } else {
+            // try the rest again after another interval
+            buffer->pending_since_ms = common_hal_time_monotonic_ms();
+        }
+    }
+    return written;
+}
+
+void iot_dupterm_background(void) {
+    iot_dupterm_buffer_t *buffer = MP_STATE_VM(iot_dupterm_buffer);
+    if (buffer == NULL || !buffer->pending) {
+        return;
+    }
+    if (common_hal_time_monotonic_ms() - buffer->pending_since_ms >= CIRCUITPY_IOT_DUPTERM_FLUSH_INTERVAL_MS) {
+        dupterm_flush(buffer);
+    }
+}
+
+void iot_reset(void) {
+    shared_module_iot_dupterm_buffer(0, false);
+}
+
 void common_hal_dupterm_write_substring(uint8_t* text, uint32_t length) {
-    dupterm_read_write(text, length, MP_QSTR_write);
+    iot_dupterm_buffer_t *buffer = MP_STATE_VM(iot_dupterm_buffer);
+    if (buffer == NULL) {
+        dupterm_read_write(text, length, MP_QSTR_write);
+        return;
+    }
+    if (!dupterm_active()) {
+        return;
+    }
+    for (;;) {
+        size_t n = ringbuf_put_n(&buffer->ringbuf, text, length);
+        text += n;
+        length -= n;
+        if (length == 0 || !buffer->block || buffer->flushing) {
+            break;
+        }
+        // back-pressure: make room by writing out what is buffered, unless
+        // the terminal takes none of it, when the rest is dropped
+        if (dupterm_flush(buffer) == 0) {
+            break;
+        }
+        if (!dupterm_active()) {
+            return;
+        }
+    }
+    buffer->dropped += length;
+    if (!buffer->pending && ringbuf_num_filled(&buffer->ringbuf) > 0) {
+        // keep the background tasks running until the output has been flushed
+        buffer->pending = true;
+        buffer->pending_since_ms = common_hal_time_monotonic_ms();
+        supervisor_enable_tick();
+    }
 }
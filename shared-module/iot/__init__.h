@@ -0,0 +1,51 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2021 MicroPython & CircuitPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_IOT___INIT___H
+#define MICROPY_INCLUDED_SHARED_MODULE_IOT___INIT___H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/ringbuf.h"
+
+// Console output waiting to be written to the dupterm terminal in bulk.
+typedef struct _iot_dupterm_buffer_t {
+    ringbuf_t ringbuf;
+    uint64_t pending_since_ms;
+    uint32_t dropped;
+    bool block;
+    // set while output waits, which keeps the tick running
+    bool pending;
+    bool flushing;
+} iot_dupterm_buffer_t;
+
+// Writes buffered output that has waited long enough. Called from background tasks.
+void iot_dupterm_background(void);
+// Writes buffered output and goes back to unbuffered. Called before the heap goes away.
+void iot_reset(void);
+
+#endif  // MICROPY_INCLUDED_SHARED_MODULE_IOT___INIT___H
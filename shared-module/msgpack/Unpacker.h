@@ -0,0 +1,53 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 MicroPython & CircuitPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_MSGPACK_UNPACKER_H
+#define MICROPY_INCLUDED_SHARED_MODULE_MSGPACK_UNPACKER_H
+
+#include "py/obj.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t ext_hook;
+    // Read-only buffer passed to the last feed(), parsed in place.
+    // MP_OBJ_NULL when the bytes live in our own buffer instead.
+    mp_obj_t input;
+    // Start of the block holding the bytes (base for memoryviews), the
+    // offset of the first byte in it, and the valid length after that.
+    byte *data;
+    size_t offset;
+    size_t len;
+    size_t pos;
+    // Own buffer for partial objects that span several feed() calls.
+    byte *own;
+    size_t own_alloc;
+    bool use_list;
+    bool use_memoryview;
+    // A memoryview into own may be alive, so own must not be overwritten.
+    bool own_shared;
+} msgpack_unpacker_obj_t;
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_MSGPACK_UNPACKER_H
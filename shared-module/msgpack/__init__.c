@@ -25,6 +25,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <inttypes.h>
 
 #include "py/obj.h"
@@ -38,6 +39,8 @@
 
 #include "supervisor/shared/translate.h"
 #include "shared-bindings/msgpack/ExtType.h"
+#include "shared-bindings/msgpack/Unpacker.h"
+#include "shared-module/msgpack/__init__.h"
 
 ////////////////////////////////////////////////////////////////
 // stream management
@@ -47,19 +50,38 @@ typedef struct _msgpack_stream_t {
     mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
     mp_uint_t (*write)(mp_obj_t obj, const void *buf, mp_uint_t size, int *errcode);
     int errcode;
+    // Buffer object pack_into writes to, else MP_OBJ_NULL.
+    mp_obj_t sink;
+    // In-memory source used by Unpacker, or sink used by pack_into, in
+    // which case stream_obj is MP_OBJ_NULL. buf is base + offset; base is
+    // kept for memoryviews. When packing to a stream this is the write
+    // buffer, flushed to the stream when full.
+    byte *base;
+    size_t offset;
+    size_t pos;
+    size_t len;
+    bool use_memoryview;
 } msgpack_stream_t;
 
 STATIC msgpack_stream_t get_stream(mp_obj_t stream_obj, int flags) {
     const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, flags);
-    msgpack_stream_t s = {stream_obj, stream_p->read, stream_p->write, 0};
+    msgpack_stream_t s = {stream_obj, stream_p->read, stream_p->write, 0, MP_OBJ_NULL, NULL, 0, 0, 0, false};
     return s;
 }
 
 ////////////////////////////////////////////////////////////////
 // readers
 
-STATIC void read(msgpack_stream_t *s, void *buf, mp_uint_t size) {
+STATIC void read_bytes(msgpack_stream_t *s, void *buf, mp_uint_t size) {
     if (size == 0) return;
+    if (s->stream_obj == MP_OBJ_NULL) {
+        if (s->len - s->pos < size) {
+            mp_raise_ValueError(translate("short read"));
+        }
+        memcpy(buf, s->base + s->offset + s->pos, size);
+        s->pos += size;
+        return;
+    }
     mp_uint_t ret = s->read(s->stream_obj, buf, size, &s->errcode);
     if (s->errcode != 0) {
         mp_raise_OSError(s->errcode);
@@ -74,13 +96,13 @@ STATIC void read(msgpack_stream_t *s, void *buf, mp_uint_t size) {
 
 STATIC uint8_t read1(msgpack_stream_t *s) {
     uint8_t res = 0;
-    read(s, &res, 1);
+    read_bytes(s, &res, 1);
     return res;
 }
 
 STATIC uint16_t read2(msgpack_stream_t *s) {
     uint16_t res = 0;
-    read(s, &res, 2);
+    read_bytes(s, &res, 2);
     int n = 1;
     if (*(char *)&n == 1) res = __builtin_bswap16(res);
     return res;
@@ -88,7 +110,7 @@ STATIC uint16_t read2(msgpack_stream_t *s) {
 
 STATIC uint32_t read4(msgpack_stream_t *s) {
     uint32_t res = 0;
-    read(s, &res, 4);
+    read_bytes(s, &res, 4);
     int n = 1;
     if (*(char *)&n == 1) res = __builtin_bswap32(res);
     return res;
@@ -107,7 +129,7 @@ STATIC size_t read_size(msgpack_stream_t *s, uint8_t len_index) {
 ////////////////////////////////////////////////////////////////
 // writers
 
-STATIC void write(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
+STATIC void write_stream(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
     mp_uint_t ret = s->write(s->stream_obj, buf, size, &s->errcode);
     if (s->errcode != 0) {
         mp_raise_OSError(s->errcode);
@@ -117,20 +139,58 @@ STATIC void write(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
     }
 }
 
+STATIC void flush(msgpack_stream_t *s) {
+    if (s->pos > 0) {
+        write_stream(s, s->base + s->offset, s->pos);
+        s->pos = 0;
+    }
+}
+
+STATIC void write_bytes(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
+    if (s->len - s->pos < size) {
+        if (s->stream_obj == MP_OBJ_NULL) {
+            mp_raise_ValueError(translate("buffer too small"));
+        }
+        flush(s);
+        if (size >= s->len) {
+            // too big to be worth buffering
+            write_stream(s, buf, size);
+            return;
+        }
+    }
+    memcpy(s->base + s->offset + s->pos, buf, size);
+    s->pos += size;
+}
+
+// Python code may have resized the buffer pack_into writes to, so look
+// it up again.
+STATIC void refresh_sink(msgpack_stream_t *s) {
+    if (s->sink == MP_OBJ_NULL) {
+        return;
+    }
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(s->sink, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.len < s->offset + s->pos) {
+        mp_raise_ValueError(translate("buffer too small"));
+    }
+    s->base = bufinfo.buf;
+    s->len = bufinfo.len - s->offset;
+}
+
 STATIC void write1(msgpack_stream_t *s, uint8_t obj) {
-    write(s, &obj, 1);
+    write_bytes(s, &obj, 1);
 }
 
 STATIC void write2(msgpack_stream_t *s, uint16_t obj) {
     int n = 1;
     if (*(char *)&n == 1) obj = __builtin_bswap16(obj);
-    write(s, &obj, 2);
+    write_bytes(s, &obj, 2);
 }
 
 STATIC void write4(msgpack_stream_t *s, uint32_t obj) {
     int n = 1;
     if (*(char *)&n == 1) obj = __builtin_bswap32(obj);
-    write(s, &obj, 4);
+    write_bytes(s, &obj, 4);
 }
 
 // compute and write msgpack size code (array structures)
@@ -184,7 +244,7 @@ STATIC void pack_int(msgpack_stream_t *s, int32_t x) {
 
 STATIC void pack_bin(msgpack_stream_t *s, const uint8_t* data, size_t len) {
     write_size(s, 0xc4, len);
-    if (len > 0) write(s, data, len);
+    if (len > 0) write_bytes(s, data, len);
 }
 
 STATIC void  pack_ext(msgpack_stream_t *s, int8_t code, const uint8_t* data, size_t len) {
@@ -202,7 +262,7 @@ STATIC void  pack_ext(msgpack_stream_t *s, int8_t code, const uint8_t* data, siz
         write_size(s, 0xc7, len);
     }
     write1(s, code);    // type byte
-    if (len > 0) write(s, data, len);
+    if (len > 0) write_bytes(s, data, len);
 }
 
 STATIC void pack_str(msgpack_stream_t *s, const char* str, size_t len) {
@@ -211,7 +271,7 @@ STATIC void pack_str(msgpack_stream_t *s, const char* str, size_t len) {
     } else {
         write_size(s, 0xd9, len);
     }
-    if (len > 0) write(s, str, len);
+    if (len > 0) write_bytes(s, str, len);
 }
 
 STATIC void pack_array(msgpack_stream_t *s, size_t len) {
@@ -299,7 +359,9 @@ STATIC void pack(mp_obj_t obj, msgpack_stream_t *s, mp_obj_t default_handler) {
         } else if (default_handler != mp_const_none) {
             // set default_handler to mp_const_none to avoid infinite recursion
             // this also precludes some valid outputs
-            pack(mp_call_function_1(default_handler, obj), s, mp_const_none);
+            mp_obj_t res = mp_call_function_1(default_handler, obj);
+            refresh_sink(s);
+            pack(res, s, mp_const_none);
         } else {
             mp_raise_ValueError(translate("no default packer"));
         }
@@ -333,16 +395,32 @@ STATIC mp_obj_t unpack_bytes(msgpack_stream_t *s, size_t size) {
     byte *p = (byte*)vstr.buf;
     // read in chunks: (some drivers - e.g. UART) limit the
     // maximum number of bytes that can be read at once
-    // read(s, p, size);
+    // read_bytes(s, p, size);
     while (size > 0) {
         int n = size > 256 ? 256 : size;
-        read(s, p, n);
+        read_bytes(s, p, n);
         size -= n;
         p += n;
     }
     return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
 }
 
+STATIC mp_obj_t unpack_bin(msgpack_stream_t *s, size_t size) {
+    #if MICROPY_PY_BUILTINS_MEMORYVIEW
+    if (s->use_memoryview) {
+        // view into the fed bytes instead of copying them
+        if (s->len - s->pos < size) {
+            mp_raise_ValueError(translate("short read"));
+        }
+        mp_obj_array_t *view = MP_OBJ_TO_PTR(mp_obj_new_memoryview('B', size, s->base));
+        view->free = s->offset + s->pos;
+        s->pos += size;
+        return MP_OBJ_FROM_PTR(view);
+    }
+    #endif
+    return unpack_bytes(s, size);
+}
+
 STATIC mp_obj_t unpack_ext(msgpack_stream_t *s, size_t size, mp_obj_t ext_hook) {
     int8_t code = read1(s);
     mp_obj_t data = unpack_bytes(s, size);
@@ -368,7 +446,7 @@ STATIC mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         size_t len = code & 0b11111;
         // allocate on stack; len < 32
         char str[len];
-        read(s, &str, len);
+        read_bytes(s, &str, len);
         return mp_obj_new_str(str, len);
     }
     if ((code & 0b11110000) == 0b10010000) {
@@ -380,7 +458,9 @@ STATIC mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         size_t len = code & 0b1111;
         mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
         for (size_t i=0; i<len; i++) {
-            mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
+            // unpack the key first, argument evaluation order is unspecified
+            mp_obj_t key = unpack(s, ext_hook, use_list);
+            mp_obj_dict_store(d, key, unpack(s, ext_hook, use_list));
         }
         return MP_OBJ_FROM_PTR(d);
     }
@@ -392,7 +472,7 @@ STATIC mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         case 0xc5:
         case 0xc6: {
             // bin 8, 16, 32
-            return unpack_bytes(s, read_size(s, code-0xc4));
+            return unpack_bin(s, read_size(s, code-0xc4));
         }
         case 0xcc: // uint8
         case 0xd0: // int8
@@ -417,7 +497,7 @@ STATIC mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
             vstr_t vstr;
             vstr_init_len(&vstr, size);
             byte *p = (byte*)vstr.buf;
-            read(s, p, size);
+            read_bytes(s, p, size);
             return mp_obj_new_str_from_vstr(&mp_type_str, &vstr);
         }
         case 0xde:
@@ -426,7 +506,8 @@ STATIC mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
             size_t len = read_size(s, code - 0xde + 1);
             mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
             for (size_t i=0; i<len; i++) {
-                mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
+                mp_obj_t key = unpack(s, ext_hook, use_list);
+                mp_obj_dict_store(d, key, unpack(s, ext_hook, use_list));
             }
             return MP_OBJ_FROM_PTR(d);
         }
@@ -462,10 +543,264 @@ STATIC mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
 
 void common_hal_msgpack_pack(mp_obj_t obj, mp_obj_t stream_obj, mp_obj_t default_handler) {
     msgpack_stream_t stream = get_stream(stream_obj, MP_STREAM_OP_WRITE);
+    // collect the many small writes of headers and scalars, so that the
+    // stream sees a few large writes instead
+    byte buf[MSGPACK_WRITE_BUFFER_SIZE];
+    stream.base = buf;
+    stream.len = sizeof(buf);
     pack(obj, &stream, default_handler);
+    flush(&stream);
+}
+
+size_t common_hal_msgpack_pack_into(mp_obj_t obj, mp_obj_t buffer, size_t offset, mp_obj_t default_handler) {
+    msgpack_stream_t stream = {MP_OBJ_NULL, NULL, NULL, 0, buffer, NULL, offset, 0, 0, false};
+    refresh_sink(&stream);
+    pack(obj, &stream, default_handler);
+    return stream.pos;
 }
 
 mp_obj_t common_hal_msgpack_unpack(mp_obj_t stream_obj, mp_obj_t ext_hook, bool use_list) {
     msgpack_stream_t stream = get_stream(stream_obj, MP_STREAM_OP_READ);
     return unpack(&stream, ext_hook, use_list);
 }
+
+////////////////////////////////////////////////////////////////
+// streaming unpacker
+
+// Read a big endian size field of n bytes.
+STATIC size_t peek_size(const byte *p, size_t n) {
+    size_t res = 0;
+    while (n--) {
+        res = (res << 8) | *p++;
+    }
+    return res;
+}
+
+// Check whether buf[*pos:len] starts with a complete object and, if so,
+// advance *pos past it. Only the headers are looked at and nothing is
+// allocated, so this is cheap compared to a failed unpack. Containers are
+// handled by counting the items still to skip rather than by recursion.
+STATIC bool skip_object(const byte *buf, size_t len, size_t *pos) {
+    size_t p = *pos;
+    size_t todo = 1;
+    while (todo > 0) {
+        if (p >= len) {
+            return false;
+        }
+        todo--;
+        uint8_t code = buf[p++];
+        size_t hdr = 0;     // length of the size field following code
+        size_t extra = 0;   // payload bytes on top of the size field value
+        size_t fixed = 0;   // payload bytes when there is no size field
+        size_t per = 0;     // 0: size is bytes, else objects per count
+        if (((code & 0b10000000) == 0) || ((code & 0b11100000) == 0b11100000)) {
+            // fixint
+        } else if ((code & 0b11100000) == 0b10100000) {
+            fixed = code & 0b11111;
+        } else if ((code & 0b11110000) == 0b10010000) {
+            todo += code & 0b1111;
+        } else if ((code & 0b11110000) == 0b10000000) {
+            todo += 2 * (code & 0b1111);
+        } else {
+            switch (code) {
+                case 0xc4: case 0xd9: hdr = 1; break;   // bin 8, str 8
+                case 0xc5: case 0xda: hdr = 2; break;   // bin 16, str 16
+                case 0xc6: case 0xdb: hdr = 4; break;   // bin 32, str 32
+                case 0xc7: hdr = 1; extra = 1; break;   // ext 8
+                case 0xc8: hdr = 2; extra = 1; break;   // ext 16
+                case 0xc9: hdr = 4; extra = 1; break;   // ext 32
+                case 0xcc: case 0xd0: fixed = 1; break;
+                case 0xcd: case 0xd1: fixed = 2; break;
+                case 0xca: case 0xce: case 0xd2: fixed = 4; break;
+                case 0xcb: case 0xcf: case 0xd3: fixed = 8; break;
+                case 0xd4: fixed = 2; break;            // fixext 1
+                case 0xd5: fixed = 3; break;            // fixext 2
+                case 0xd6: fixed = 5; break;            // fixext 4
+                case 0xd7: fixed = 9; break;            // fixext 8
+                case 0xd8: fixed = 17; break;           // fixext 16
+                case 0xdc: hdr = 2; per = 1; break;     // array 16
+                case 0xdd: hdr = 4; per = 1; break;     // array 32
+                case 0xde: hdr = 2; per = 2; break;     // map 16
+                case 0xdf: hdr = 4; per = 2; break;     // map 32
+                default: break;                         // nil, bool, 0xc1
+            }
+        }
+        if (hdr > 0) {
+            if (len - p < hdr) {
+                return false;
+            }
+            size_t size = peek_size(buf + p, hdr);
+            p += hdr;
+            if (per > 0) {
+                // every object takes at least one byte, which also keeps
+                // todo from overflowing on bogus counts
+                if (size > (len - p) / per) {
+                    return false;
+                }
+                todo += size * per;
+            } else {
+                if (size > len - p || extra > len - p - size) {
+                    return false;
+                }
+                p += size + extra;
+            }
+        } else {
+            if (fixed > len - p) {
+                return false;
+            }
+            p += fixed;
+        }
+    }
+    *pos = p;
+    return true;
+}
+
+// Move the unconsumed bytes, followed by buf[0:n], into our own buffer.
+STATIC void unpacker_keep(msgpack_unpacker_obj_t *self, const byte *buf, size_t n) {
+    size_t remaining = self->len - self->pos;
+    const byte *src = self->data + self->offset + self->pos;
+    size_t need = remaining + n;
+    if (self->data == self->own && !self->own_shared) {
+        memmove(self->own, src, remaining);
+        src = self->own;
+    }
+    if (self->own_shared || self->own_alloc < need) {
+        size_t alloc = need + need / 2;
+        byte *fresh = m_new(byte, alloc);
+        memcpy(fresh, src, remaining);
+        if (self->own != NULL && !self->own_shared) {
+            m_del(byte, self->own, self->own_alloc);
+        }
+        self->own = fresh;
+        self->own_alloc = alloc;
+        self->own_shared = false;
+    } else if (src != self->own) {
+        memmove(self->own, src, remaining);
+    }
+    memcpy(self->own + remaining, buf, n);
+    self->input = MP_OBJ_NULL;
+    self->data = self->own;
+    self->offset = 0;
+    self->len = need;
+    self->pos = 0;
+}
+
+// Called when the fed bytes hold no complete object: stop referring to the
+// caller's buffer so that it may be reused for the next read.
+STATIC void unpacker_release_input(msgpack_unpacker_obj_t *self) {
+    if (self->input != MP_OBJ_NULL) {
+        unpacker_keep(self, NULL, 0);
+    }
+}
+
+// Return a stream over the next complete object, or false if there is none.
+STATIC bool unpacker_stream(msgpack_unpacker_obj_t *self, msgpack_stream_t *s) {
+    size_t end = self->pos;
+    if (!skip_object(self->data + self->offset, self->len, &end)) {
+        unpacker_release_input(self);
+        return false;
+    }
+    msgpack_stream_t stream = {MP_OBJ_NULL, NULL, NULL, 0, MP_OBJ_NULL,
+                               self->data, self->offset, self->pos, end, self->use_memoryview};
+    *s = stream;
+    if (self->use_memoryview && self->data == self->own) {
+        self->own_shared = true;
+    }
+    // consume the object up front so that a failed unpack cannot wedge the
+    // unpacker on the same bytes
+    self->pos = end;
+    return true;
+}
+
+void common_hal_msgpack_unpacker_construct(msgpack_unpacker_obj_t *self, mp_obj_t ext_hook, bool use_list, bool use_memoryview) {
+    self->ext_hook = ext_hook;
+    self->input = MP_OBJ_NULL;
+    self->data = NULL;
+    self->offset = 0;
+    self->len = 0;
+    self->pos = 0;
+    self->own = NULL;
+    self->own_alloc = 0;
+    self->use_list = use_list;
+    self->use_memoryview = use_memoryview;
+    self->own_shared = false;
+}
+
+void common_hal_msgpack_unpacker_feed(msgpack_unpacker_obj_t *self, mp_obj_t data) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(data, &bufinfo, MP_BUFFER_READ);
+    if (bufinfo.len == 0) {
+        return;
+    }
+    mp_buffer_info_t writable;
+    if (self->pos < self->len || mp_get_buffer(data, &writable, MP_BUFFER_WRITE)) {
+        // append to a pending partial object; copy writable buffers too,
+        // as the caller may change or resize them before the next call
+        unpacker_keep(self, bufinfo.buf, bufinfo.len);
+        return;
+    }
+    // nothing pending and the bytes can't change: parse them in place
+    self->input = data;
+    self->data = bufinfo.buf;
+    self->offset = 0;
+    #if MICROPY_PY_BUILTINS_MEMORYVIEW
+    if (MP_OBJ_IS_TYPE(data, &mp_type_memoryview)) {
+        // memoryviews of our memoryviews must point at the start of the block
+        mp_obj_array_t *view = MP_OBJ_TO_PTR(data);
+        self->data = view->items;
+        self->offset = (byte *)bufinfo.buf - (byte *)view->items;
+    }
+    #endif
+    self->len = bufinfo.len;
+    self->pos = 0;
+}
+
+mp_obj_t common_hal_msgpack_unpacker_next(msgpack_unpacker_obj_t *self) {
+    msgpack_stream_t s;
+    if (!unpacker_stream(self, &s)) {
+        return MP_OBJ_NULL;
+    }
+    return unpack(&s, self->ext_hook, self->use_list);
+}
+
+mp_obj_t common_hal_msgpack_unpacker_unpack_into(msgpack_unpacker_obj_t *self, mp_obj_t target) {
+    size_t end = self->pos;
+    if (!skip_object(self->data + self->offset, self->len, &end)) {
+        unpacker_release_input(self);
+        return MP_OBJ_NULL;
+    }
+    uint8_t code = self->data[self->offset + self->pos];
+    bool is_array = (code & 0b11110000) == 0b10010000 || code == 0xdc || code == 0xdd;
+    bool is_bin = code >= 0xc4 && code <= 0xc6;
+    bool is_list = MP_OBJ_IS_TYPE(target, &mp_type_list);
+    mp_buffer_info_t bufinfo;
+    if (!(is_list && is_array) && !(is_bin && !is_list && mp_get_buffer(target, &bufinfo, MP_BUFFER_WRITE))) {
+        mp_raise_TypeError(translate("next object does not fit target"));
+    }
+    msgpack_stream_t s;
+    unpacker_stream(self, &s);
+    read1(&s);
+    if (is_bin) {
+        size_t size = read_size(&s, code - 0xc4);
+        if (size > bufinfo.len) {
+            mp_raise_ValueError(translate("buffer too small"));
+        }
+        read_bytes(&s, bufinfo.buf, size);
+        return MP_OBJ_NEW_SMALL_INT(size);
+    }
+    size_t size = code < 0xdc ? (code & 0b1111) : read_size(&s, code - 0xdc + 1);
+    mp_obj_list_t *list = MP_OBJ_TO_PTR(target);
+    // reuse the list's storage, only growing it when needed
+    if (list->alloc < size) {
+        list->items = m_renew(mp_obj_t, list->items, list->alloc, size);
+        list->alloc = size;
+    } else if (size < list->len) {
+        mp_seq_clear(list->items, size, list->len, sizeof(*list->items));
+    }
+    list->len = 0;
+    for (size_t i = 0; i < size; i++) {
+        list->items[i] = unpack(&s, self->ext_hook, self->use_list);
+        list->len = i + 1;
+    }
+    return target;
+}
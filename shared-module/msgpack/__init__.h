@@ -28,7 +28,12 @@
 
 #include "py/stream.h"
 
+// Bytes collected on the stack by pack() before writing them to the stream.
+#define MSGPACK_WRITE_BUFFER_SIZE (128)
+
 void common_hal_msgpack_pack(mp_obj_t obj, mp_obj_t stream_obj, mp_obj_t default_handler);
+// Returns the number of bytes written to buf.
+size_t common_hal_msgpack_pack_into(mp_obj_t obj, mp_obj_t buffer, size_t offset, mp_obj_t default_handler);
 mp_obj_t common_hal_msgpack_unpack(mp_obj_t stream_obj, mp_obj_t ext_hook, bool use_list);
 
 #endif
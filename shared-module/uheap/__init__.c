@@ -40,8 +40,8 @@
 #include "shared-bindings/uheap/__init__.h"
 
 #define VERIFY_PTR(ptr) ( \
-        (void *) ptr >= (void*)MP_STATE_MEM(gc_pool_start)     /* must be above start of pool */ \
-        && (void *) ptr < (void*)MP_STATE_MEM(gc_pool_end)        /* must be below end of pool */ \
+        (void *) ptr >= (void*)MP_STATE_MEM(area).gc_pool_start     /* must be above start of pool */ \
+        && (void *) ptr < (void*)MP_STATE_MEM(area).gc_pool_end        /* must be below end of pool */ \
     )
 
 static void indent(uint8_t levels) {
@@ -228,7 +228,14 @@ static uint32_t type_size(uint8_t indent_level, mp_obj_type_t *type) {
 static uint32_t instance_size(uint8_t indent_level, mp_obj_instance_t *instance) {
     uint32_t total_size = gc_nbytes(instance);
 
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    if (instance->shape == NULL) {
+        total_size += gc_nbytes(instance->u.members);
+        total_size += map_size(indent_level, instance->u.members);
+    }
+    #else
     total_size += map_size(indent_level, &instance->members);
+    #endif
 
     return total_size;
 }
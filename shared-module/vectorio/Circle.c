@@ -33,6 +33,44 @@ uint32_t common_hal_vectorio_circle_get_pixel(void *obj, int16_t x, int16_t y) {
 }
 
 
+// Largest x with x*x <= n.
+static int32_t isqrt(int32_t n) {
+    int32_t root = 0;
+    int32_t bit = 1 << 30;
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+
+// get_pixel covers exactly the points with x*x + y*y <= radius*radius, because x+y <= radius
+// implies it too.
+int common_hal_vectorio_circle_get_spans(void *obj, int16_t y, int16_t x, int16_t *spans, int max_spans) {
+    vectorio_circle_t *self = obj;
+    int32_t radius = self->radius;
+    if (abs(y) > radius) {
+        return 0;
+    }
+    int16_t half_width = isqrt(radius * radius - (int32_t)y * y);
+    if (half_width + 1 <= x) {
+        return 0;
+    }
+    spans[0] = -half_width;
+    spans[1] = half_width + 1;
+    return 1;
+}
+
+
 void common_hal_vectorio_circle_get_area(void *circle, displayio_area_t *out_area) {
     vectorio_circle_t *self = circle;
     out_area->x1 = -1 * self->radius - 1;
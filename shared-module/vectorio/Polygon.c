@@ -1,6 +1,7 @@
 
 #include "shared-module/vectorio/__init__.h"
 #include "shared-bindings/vectorio/Polygon.h"
+#include "shared-module/vectorio/VectorShape.h"
 #include "shared-module/displayio/area.h"
 
 #include "py/runtime.h"
@@ -27,12 +28,20 @@ static void _clobber_points_list(vectorio_polygon_t *self, mp_obj_t points_tuple
     }
 
     if ( self->len < 2*len ) {
+        // clear first so that a MemoryError below leaves an empty polygon
+        self->len = 0;
         if ( self->points_list != NULL ) {
             VECTORIO_POLYGON_DEBUG("free(%d), ", sizeof(self->points_list));
             gc_free( self->points_list );
+            self->points_list = NULL;
+        }
+        if ( self->crossings != NULL ) {
+            gc_free( self->crossings );
+            self->crossings = NULL;
         }
-        self->points_list = gc_alloc( 2 * len * sizeof(int), false, false );
+        self->points_list = m_malloc( 2 * len * sizeof(int), false );
         VECTORIO_POLYGON_DEBUG("alloc(%p, %d)", self->points_list, 2 * len * sizeof(int));
+        self->crossings = m_malloc( 2 * len * sizeof(int16_t), false );
     }
     self->len = 2*len;
 
@@ -44,14 +53,20 @@ static void _clobber_points_list(vectorio_polygon_t *self, mp_obj_t points_tuple
         if (tuple_len != 2) {
             mp_raise_ValueError_varg(translate("%q must be a tuple of length 2"), MP_QSTR_point);
         }
-        if (   !mp_obj_get_int_maybe(tuple_items[ 0 ], &self->points_list[2*i    ])
-            || !mp_obj_get_int_maybe(tuple_items[ 1 ], &self->points_list[2*i + 1])
+        mp_int_t x;
+        mp_int_t y;
+        if (   !mp_obj_get_int_maybe(tuple_items[ 0 ], &x)
+            || !mp_obj_get_int_maybe(tuple_items[ 1 ], &y)
         ) {
             self->len = 0;
             gc_free( self->points_list );
             self->points_list = NULL;
+            gc_free( self->crossings );
+            self->crossings = NULL;
             mp_raise_ValueError_varg(translate("unsupported %q type"), MP_QSTR_point);
         }
+        self->points_list[2*i    ] = x;
+        self->points_list[2*i + 1] = y;
     }
 }
 
@@ -60,6 +75,7 @@ static void _clobber_points_list(vectorio_polygon_t *self, mp_obj_t points_tuple
 void common_hal_vectorio_polygon_construct(vectorio_polygon_t *self, mp_obj_t points_list) {
     VECTORIO_POLYGON_DEBUG("%p polygon_construct: ", self);
     self->points_list = NULL;
+    self->crossings = NULL;
     self->len = 0;
     self->on_dirty.obj = NULL;
     _clobber_points_list( self, points_list );
@@ -159,3 +175,78 @@ uint32_t common_hal_vectorio_polygon_get_pixel(void *obj, int16_t x, int16_t y)
     }
     return winding_number == 0 ? 0 : 1;
 }
+
+
+// Rounds a / b towards positive infinity.
+__attribute__((always_inline)) static inline int ceil_div(int a, int b) {
+    int q = a / b;
+    if (a % b != 0 && (a > 0) == (b > 0)) {
+        ++q;
+    }
+    return q;
+}
+
+
+// Scanline version of get_pixel. Each edge that crosses row y winds every x left of the
+// crossing, exactly as line_side() decides it for get_pixel, so the covered ranges are found by
+// sorting the crossings and walking the winding number across them.
+int common_hal_vectorio_polygon_get_spans(void *obj, int16_t y, int16_t x, int16_t *spans, int max_spans) {
+    vectorio_polygon_t *self = obj;
+
+    if (self->len == 0) {
+        return 0;
+    }
+
+    // Crossings are kept sorted by x as they are found.
+    int16_t *crossings = self->crossings;
+    size_t crossing_count = 0;
+    int x1 = self->points_list[self->len - 2];
+    int y1 = self->points_list[self->len - 1];
+    for (size_t i = 0; i < self->len; i += 2) {
+        int x2 = self->points_list[i];
+        int y2 = self->points_list[i + 1];
+        int16_t wind = 0;
+        if (y1 <= y) {
+            if (y2 > y) {
+                wind = 1;
+            }
+        } else if (y2 <= y) {
+            wind = -1;
+        }
+        if (wind != 0) {
+            // line_side() is < 0 going up, or > 0 going down, for every x below this.
+            int crossing = x1 + ceil_div((y - y1) * (x2 - x1), y2 - y1);
+            crossing = MAX(INT16_MIN, MIN(INT16_MAX, crossing));
+            size_t j = crossing_count;
+            while (j > 0 && crossings[2 * (j - 1)] > crossing) {
+                crossings[2 * j] = crossings[2 * (j - 1)];
+                crossings[2 * j + 1] = crossings[2 * (j - 1) + 1];
+                --j;
+            }
+            crossings[2 * j] = crossing;
+            crossings[2 * j + 1] = wind;
+            ++crossing_count;
+        }
+        x1 = x2;
+        y1 = y2;
+    }
+
+    // Left of every crossing all of them count, which sums to zero for a closed polygon.
+    int winding_number = 0;
+    bool inside = false;
+    int count = 0;
+    for (size_t i = 0; i < crossing_count && count < max_spans; ++i) {
+        winding_number -= crossings[2 * i + 1];
+        if (i + 1 < crossing_count && crossings[2 * (i + 1)] == crossings[2 * i]) {
+            continue;
+        }
+        if (!inside && winding_number != 0) {
+            spans[2 * count] = crossings[2 * i];
+        } else if (inside && winding_number == 0 && crossings[2 * i] > x) {
+            spans[2 * count + 1] = crossings[2 * i];
+            ++count;
+        }
+        inside = winding_number != 0;
+    }
+    return count;
+}
@@ -11,6 +11,9 @@ typedef struct {
     // An int array[ x, y, ... ]
     int *points_list;
     size_t len;
+    // Scratch space for get_spans, an int16 array[ crossing x, winding, ... ] with room for
+    //   every edge.
+    int16_t *crossings;
     vectorio_event_t on_dirty;
 } vectorio_polygon_t;
 
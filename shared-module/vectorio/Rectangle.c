@@ -19,6 +19,18 @@ uint32_t common_hal_vectorio_rectangle_get_pixel(void *obj, int16_t x, int16_t y
 }
 
 
+int common_hal_vectorio_rectangle_get_spans(void *obj, int16_t y, int16_t x, int16_t *spans, int max_spans) {
+    vectorio_rectangle_t *self = obj;
+    if (y > self->height || y < 0 || self->width + 1 <= x) {
+        return 0;
+    }
+    // Matches get_pixel, which includes x == width.
+    spans[0] = 0;
+    spans[1] = self->width + 1;
+    return 1;
+}
+
+
 void common_hal_vectorio_rectangle_get_area(void *rectangle, displayio_area_t *out_area) {
     vectorio_rectangle_t *self = rectangle;
     out_area->x1 = -1;
@@ -201,9 +201,42 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
     displayio_input_pixel_t input_pixel;
     displayio_output_pixel_t output_pixel;
 
+    // Screen rows are shape rows unless transposed, so each row's coverage can be found once
+    //   as spans instead of testing the shape at every pixel.
+    bool use_spans = !self->absolute_transform->transpose_xy;
+    int16_t dx = self->absolute_transform->dx;
+    // Pixels outside of the shape can be skipped without shading when they're transparent.
+    bool outside_transparent = false;
+    if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type)) {
+        uint32_t color;
+        outside_transparent = !displayio_palette_get_color(self->pixel_shader, colorspace, 0, &color);
+    } else if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_colorconverter_type)) {
+        outside_transparent = ((displayio_colorconverter_t*) self->pixel_shader)->transparent_color == 0;
+    }
+    int16_t spans[2 * VECTORIO_MAX_SPANS];
+    int span_count = -1;
+    int span_index = 0;
+
     uint32_t mask_start_px = line_dirty_offset_px;
     for (input_pixel.y = overlap.y1; input_pixel.y < overlap.y2; ++input_pixel.y) {
         mask_start_px += column_dirty_offset_px;
+        int16_t span_row = 0;
+        if (use_spans) {
+            span_row = (input_pixel.y - self->absolute_transform->dy * self->y - self->absolute_transform->y) / self->absolute_transform->dy;
+            if (dx > 0) {
+                int16_t first_x = (overlap.x1 - dx * self->x - self->absolute_transform->x) / dx;
+                span_count = self->ishape.get_spans(self->ishape.shape, span_row, first_x, spans, VECTORIO_MAX_SPANS);
+                span_index = 0;
+            } else {
+                // Shape x goes down as screen x goes up when mirrored, so all of the row's spans
+                //   are needed up front.
+                span_count = self->ishape.get_spans(self->ishape.shape, span_row, INT16_MIN, spans, VECTORIO_MAX_SPANS);
+                if (span_count == VECTORIO_MAX_SPANS) {
+                    span_count = -1;
+                }
+                span_index = span_count - 1;
+            }
+        }
         for (input_pixel.x = overlap.x1; input_pixel.x < overlap.x2; ++input_pixel.x) {
             // Check the mask first to see if the pixel has already been set.
             uint32_t pixel_index = mask_start_px + (input_pixel.x - overlap.x1);
@@ -230,7 +263,39 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
 #ifdef VECTORIO_PERF
             uint64_t pre_pixel = common_hal_time_monotonic_ns();
 #endif
-            input_pixel.pixel = self->ishape.get_pixel(self->ishape.shape, pixel_to_get_x, pixel_to_get_y);
+            if (span_count >= 0) {
+                bool covered;
+                if (dx > 0) {
+                    while (span_index < span_count && pixel_to_get_x >= spans[2 * span_index + 1]) {
+                        ++span_index;
+                        if (span_index == VECTORIO_MAX_SPANS) {
+                            span_count = self->ishape.get_spans(self->ishape.shape, span_row, pixel_to_get_x, spans, VECTORIO_MAX_SPANS);
+                            span_index = 0;
+                        }
+                    }
+                    covered = span_index < span_count && pixel_to_get_x >= spans[2 * span_index];
+                } else {
+                    while (span_index >= 0 && pixel_to_get_x < spans[2 * span_index]) {
+                        --span_index;
+                    }
+                    covered = span_index >= 0 && pixel_to_get_x < spans[2 * span_index + 1];
+                }
+                if (!covered && outside_transparent) {
+                    full_coverage = false;
+                    if (dx == 1) {
+                        // Jump to the start of the next span.
+                        if (span_index < span_count) {
+                            input_pixel.x += spans[2 * span_index] - pixel_to_get_x - 1;
+                        } else {
+                            input_pixel.x = overlap.x2;
+                        }
+                    }
+                    continue;
+                }
+                input_pixel.pixel = covered ? 1 : 0;
+            } else {
+                input_pixel.pixel = self->ishape.get_pixel(self->ishape.shape, pixel_to_get_x, pixel_to_get_y);
+            }
 #ifdef VECTORIO_PERF
             uint64_t post_pixel = common_hal_time_monotonic_ns();
             pixel_time += post_pixel - pre_pixel;
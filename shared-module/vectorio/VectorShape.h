@@ -11,6 +11,14 @@
 
 typedef void get_area_function(mp_obj_t shape, displayio_area_t *out_area);
 typedef uint32_t get_pixel_function(mp_obj_t shape, int16_t x, int16_t y);
+// Writes the x ranges of row y where get_pixel returns 1 into spans, as start (inclusive) and
+//   end (exclusive) pairs in ascending order, and returns how many there are. Only ranges that
+//   end after x are written, and no more than max_spans of them, so a return of max_spans means
+//   there may be more to the right.
+typedef int get_spans_function(mp_obj_t shape, int16_t y, int16_t x, int16_t *spans, int max_spans);
+
+// The most spans a VectorShape fetches at once.
+#define VECTORIO_MAX_SPANS (16)
 
 // This struct binds a shape's common Shape support functions (its vector shape interface)
 //   to its instance pointer.  We only check at construction time what the type of the
@@ -22,6 +30,7 @@ typedef struct {
     mp_obj_t shape;
     get_area_function *get_area;
     get_pixel_function *get_pixel;
+    get_spans_function *get_spans;
 } vectorio_ishape_t;
 
 typedef struct {
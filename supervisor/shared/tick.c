@@ -27,6 +27,7 @@
 #include "supervisor/shared/tick.h"
 
 #include "lib/utils/interrupt_char.h"
+#include "py/gc.h"
 #include "py/mpstate.h"
 #include "py/runtime.h"
 #include "supervisor/linker.h"
@@ -53,6 +54,10 @@
 #include "shared-module/gamepadshift/__init__.h"
 #endif
 
+#if CIRCUITPY_IOT
+#include "shared-module/iot/__init__.h"
+#endif
+
 #if CIRCUITPY_NETWORK
 #include "shared-module/network/__init__.h"
 #endif
@@ -84,8 +89,18 @@ void supervisor_background_tasks(void *unused) {
     #if CIRCUITPY_NETWORK
     network_module_background();
     #endif
+    #if CIRCUITPY_IOT
+    iot_dupterm_background();
+    #endif
     filesystem_background();
 
+    #if MICROPY_GC_INCREMENTAL
+    gc_sweep_step();
+    #endif
+    #if MICROPY_GC_DEFER_FINALISERS
+    gc_run_finalisers(MICROPY_GC_FINALISER_BATCH);
+    #endif
+
     #if CIRCUITPY_BLEIO
     supervisor_bluetooth_background();
     bleio_background();
@@ -0,0 +1,70 @@
+# test that changes to a class are seen by attribute lookups on instances
+# after those lookups have already been done
+
+class A:
+    def f(self):
+        return "A.f"
+    x = 1
+
+class B(A):
+    pass
+
+a = A()
+b = B()
+for i in range(2):
+    print(a.f(), b.f(), a.x, b.x)
+
+# replace a method and an attribute in the base class
+A.f = lambda self: "new A.f"
+A.x = 2
+for i in range(2):
+    print(a.f(), b.f(), a.x, b.x)
+
+# shadow them in the derived class
+B.f = lambda self: "B.f"
+B.x = 3
+for i in range(2):
+    print(a.f(), b.f(), a.x, b.x)
+
+# and remove them again
+del B.f
+del B.x
+for i in range(2):
+    print(a.f(), b.f(), a.x, b.x)
+
+# an instance member shadows the class
+b.x = 4
+print(b.x, B.x)
+del b.x
+print(b.x)
+
+# removing an attribute from the class makes it unavailable
+del A.x
+try:
+    a.x
+except AttributeError:
+    print("AttributeError")
+
+# classmethod and staticmethod found through an instance
+class C(B):
+    @classmethod
+    def c(cls):
+        return cls.__name__
+    @staticmethod
+    def s():
+        return "s"
+
+class D(C):
+    pass
+
+for i in range(2):
+    print(C().c(), D().c(), D().s())
+
+# many classes created and dropped, each with its own version of a method
+def make(n):
+    class E:
+        def f(self):
+            return n
+    return E()
+
+print([make(i).f() for i in range(20)])
@@ -0,0 +1,81 @@
+# test instance members stored in shapes shared between instances
+
+
+class A:
+    pass
+
+
+# same attributes set in different orders
+a1 = A()
+a1.x = 1
+a1.y = 2
+a2 = A()
+a2.y = 3
+a2.x = 4
+print(a1.x, a1.y, a2.x, a2.y)
+print(sorted(a1.__dict__.items()), sorted(a2.__dict__.items()))
+
+# overwrite existing attribute
+a1.x = 10
+print(a1.x, a2.x)
+
+# delete an attribute, then add it back
+del a1.x
+print(hasattr(a1, "x"), a1.y)
+a1.x = 5
+print(a1.x, a1.y)
+try:
+    del a2.z
+except AttributeError:
+    print("AttributeError")
+
+# many attributes on one instance
+a3 = A()
+for i in range(40):
+    setattr(a3, "attr%d" % i, i)
+print(sum(getattr(a3, "attr%d" % i) for i in range(40)))
+print(len(a3.__dict__))
+
+# new instances created after the class learnt its size
+for _ in range(3):
+    a = A()
+    a.x = 1
+    a.y = 2
+    a.z = 3
+    print(a.x + a.y + a.z)
+
+# attributes set in __init__, accessed from a loop
+class B:
+    def __init__(self, n):
+        self.n = n
+        self.sq = n * n
+
+    def total(self):
+        return self.n + self.sq
+
+
+print(sum(B(i).total() for i in range(10)))
+
+# many distinct attribute orders on one class
+class C:
+    pass
+
+
+cs = []
+for i in range(50):
+    c = C()
+    setattr(c, "a%d" % (i % 7), i)
+    setattr(c, "b%d" % (i % 5), i)
+    cs.append(c)
+print(sum(len(c.__dict__) for c in cs))
+print(cs[13].a6, cs[13].b3)
+
+# subclass of a native type keeps members in a map
+class L(list):
+    pass
+
+
+l = L()
+l.x = 1
+l.append(2)
+print(l, l.x)
@@ -0,0 +1,35 @@
+# test operations on ints big enough to use the subquadratic algorithms
+
+_seed = [1]
+def rnd(bits):
+    r = 0
+    while bits > 0:
+        _seed[0] = (_seed[0] * 1103515245 + 12345) & 0x7FFFFFFF
+        n = min(bits, 16)
+        r = r << n | _seed[0] >> (31 - n)
+        bits -= n
+    return r
+
+# multiply and square, balanced and lopsided, checked against each other
+for bits in (500, 1000, 2000, 5000, 12000):
+    a = rnd(bits) | 1 << (bits - 1)
+    b = rnd(bits // 3 + 7)
+    c = rnd(bits) | 1
+    print(bits, (a * c) % 1000000007, (a * b) % 998244353, (a * a) % 1000000009)
+    print((a + b) * (a - b) == a * a - b * b, (a * c) * b == a * (c * b), -a * a == a * -a)
+    print((a * a) >> (2 * bits - 40), (a * b) & 0xFFFFFFFF)
+
+# int to and from string, including runs of zeros and powers of the base
+for x in (rnd(4000), 10 ** 1000, 10 ** 1000 - 1, 7 ** 1500, 3 ** 3000 * 10 ** 200 + 1, 2 ** 8000):
+    s = str(x)
+    print(len(s), s[:20], s[-20:], s[len(s) // 2 - 10:len(s) // 2 + 10], int(s) == x, int("-" + s) == -x)
+    print(hex(x)[-10:], int(hex(x), 16) == x, int(oct(x), 8) == x, int(bin(x), 2) == x)
+print(int("0" * 1000 + "1" + "0" * 1500 + "23") % 1000000007)
+print("{:,}".format(10 ** 1200 + 1)[-20:], "{:,}".format(-(10 ** 999))[:10])
+
+# pow with a modulus, odd and even, positive and negative
+m = rnd(1000) | 1 << 999 | 1
+e = rnd(1000)
+for a in (3, -3, rnd(1500), m - 1, m, m + 1):
+    print(pow(a, e, m) % 1000000007, pow(a, e, m + 1) % 1000000007, pow(a, e, -m) % 1000000007)
+print(pow(2, 10 ** 5, 2 ** 1279 - 1) % 1000000007, pow(5, 1, m) == 5, pow(7, 0, m))
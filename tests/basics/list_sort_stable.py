@@ -0,0 +1,63 @@
+# test that list.sort and sorted are stable, and lists of various shapes
+
+_seed = [1]
+def rnd(n):
+    _seed[0] = (_seed[0] * 1103515245 + 12345) & 0x7FFFFFFF
+    return (_seed[0] >> 8) % n
+
+# equal keys keep their order, also when reversed
+l = [(rnd(10), i) for i in range(500)]
+s = sorted(l, key=lambda x: x[0])
+print(s == [x for k in range(10) for x in l if x[0] == k])
+s = sorted(l, key=lambda x: x[0], reverse=True)
+print(s == [x for k in range(9, -1, -1) for x in l if x[0] == k])
+
+# the key function is called once per item
+n = [0]
+def key(x):
+    n[0] += 1
+    return -x
+l = [rnd(1000) for i in range(300)]
+l.sort(key=key)
+print(n[0], l == sorted(l, reverse=True))
+
+# runs, descending runs, and few distinct values
+for l in (
+    list(range(1000)),
+    list(range(1000, 0, -1)),
+    list(range(500)) + list(range(500)),
+    [rnd(1000) for i in range(1000)],
+    [rnd(3) for i in range(1000)],
+    [i + rnd(5) for i in range(1000)],
+):
+    s = sorted(l)
+    print(len(s), all(s[i] <= s[i + 1] for i in range(len(s) - 1)), sum(s) == sum(l))
+
+# an exception from a comparison leaves all the items in the list
+class K:
+    n = 0
+    def __init__(self, v):
+        self.v = v
+    def __lt__(self, o):
+        K.n += 1
+        if K.n == 700:
+            raise ValueError
+        return self.v < o.v
+l = [K(rnd(1000)) for i in range(200)]
+ids = sorted(id(x) for x in l)
+try:
+    l.sort()
+except ValueError:
+    print("ValueError")
+print(sorted(id(x) for x in l) == ids)
+
+# changing the list from a key function is detected
+def key(x):
+    l.append(x)
+    return -x
+l = list(range(10))
+try:
+    l.sort(key=key)
+except ValueError:
+    print("ValueError")
+print(l)
@@ -0,0 +1,141 @@
+# test sequences of opcodes that the bytecode emitter may fuse together
+
+
+def load_pair(a, b):
+    return (a, b), [b, a]
+
+
+print(load_pair(1, 2))
+
+
+def binary_op_pair(a, b):
+    return a + b, a - b, a * b, a // b, a % b, a < b, a is b, b in (a, b)
+
+
+print(binary_op_pair(7, 3))
+print(binary_op_pair(7.5, 2.5)[:3])
+
+
+class C:
+    z = 3
+
+    def __init__(self):
+        self.x = 1
+        self.y = 2
+
+
+def attr(a, b):
+    return a.x, b.z, a.y + b.z
+
+
+print(attr(C(), C))
+
+
+def attr_pair(a, b):
+    # first local of a pair followed by an attribute of the second
+    return a, b.x, b.y + a
+
+
+print(attr_pair(10, C()))
+
+
+def compare_jump(a, b):
+    out = []
+    if a < b:
+        out.append("lt")
+    if a > b:
+        out.append("gt")
+    if a == b:
+        out.append("eq")
+    if a != b:
+        out.append("ne")
+    if a <= b:
+        out.append("le")
+    if a >= b:
+        out.append("ge")
+    if a is b:
+        out.append("is")
+    if a is not b:
+        out.append("is not")
+    return out
+
+
+print(compare_jump(1, 2))
+print(compare_jump(2, 2))
+print(compare_jump(-(2 ** 40), 2 ** 40))
+print(compare_jump("a", "b"))
+print(compare_jump(1.5, 1))
+
+
+def in_jump(a, b):
+    if a in b:
+        return "in"
+    if a not in b:
+        return "not in"
+
+
+print(in_jump(1, [1, 2]), in_jump(3, [1, 2]))
+
+
+def while_loop(n):
+    i = 0
+    total = 0
+    while i < n:
+        total += i
+        i += 1
+    return total
+
+
+print(while_loop(10))
+
+
+# an exception raised by the comparison
+def bad_compare(a, b):
+    if a < b:
+        return True
+    return False
+
+
+try:
+    bad_compare(1, "a")
+except TypeError:
+    print("TypeError")
+
+
+# unbound locals in fused loads
+def unbound_pair():
+    a = 1
+    if a == 2:
+        b = 2
+    return a, b
+
+
+try:
+    unbound_pair()
+except NameError:
+    print("NameError")
+
+
+def unbound_binary():
+    if False:
+        a = 1
+    b = 2
+    return a + b
+
+
+try:
+    unbound_binary()
+except NameError:
+    print("NameError")
+
+
+def unbound_attr():
+    if False:
+        a = 1
+    return a.real
+
+
+try:
+    unbound_attr()
+except NameError:
+    print("NameError")
@@ -0,0 +1,132 @@
+# Report underruns and CPU time per second of audio while WaveFile plays PCM
+# and IMA-ADPCM files in real time from a FAT RAM disk with slow reads.
+# Run directly, eg: micropython_audio audiocore_wavefile.py
+# (this is not picked up by run-bench-tests)
+
+import array
+import audiocore
+import audiosink
+import math
+import uos
+import ustruct
+import utime
+
+SAMPLE_RATE = 22050
+SECONDS = 2
+OUTPUT = "audiocore_wavefile.raw"
+
+
+class SlowBlockDevice:
+    # A RAM disk whose reads each take `latency` microseconds, like an SD card.
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * 512)
+        self.latency = 0
+
+    def readblocks(self, n, buf):
+        if self.latency:
+            utime.sleep_us(self.latency)
+        buf[:] = self.data[n * 512 : n * 512 + len(buf)]
+
+    def writeblocks(self, n, buf):
+        self.data[n * 512 : n * 512 + len(buf)] = buf
+
+    def ioctl(self, op, arg):
+        if op == 4:  # block count
+            return len(self.data) // 512
+        if op == 5:  # block size
+            return 512
+
+
+STEPS = (
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60,
+    66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371,
+    408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707,
+    1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132,
+    7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+    27086, 29794, 32767,
+)
+INDEX_CHANGE = (-1, -1, -1, -1, 2, 4, 6, 8)
+
+
+def adpcm_encode(samples, block_align):
+    # Mono IMA-ADPCM: each block is the first sample and step index, then 4 bit codes.
+    samples_per_block = (block_align - 4) * 2 + 1
+    data = bytearray()
+    index = 0
+    for start in range(0, len(samples) - samples_per_block + 1, samples_per_block):
+        predictor = samples[start]
+        data += ustruct.pack("<hBB", predictor, index, 0)
+        for i in range(start + 1, start + samples_per_block, 2):
+            byte = 0
+            for shift in (0, 4):
+                step = STEPS[index]
+                diff = samples[i + shift // 4] - predictor
+                code = 8 if diff < 0 else 0
+                diff = abs(diff)
+                delta = step >> 3
+                if diff >= step:
+                    code |= 4
+                    diff -= step
+                    delta += step
+                if diff >= step >> 1:
+                    code |= 2
+                    diff -= step >> 1
+                    delta += step >> 1
+                if diff >= step >> 2:
+                    code |= 1
+                    delta += step >> 2
+                predictor += -delta if code & 8 else delta
+                predictor = max(-32768, min(32767, predictor))
+                index = max(0, min(88, index + INDEX_CHANGE[code & 7]))
+                byte |= code << shift
+            data.append(byte)
+    return data, samples_per_block
+
+
+def write_wave(name, samples, adpcm):
+    if adpcm:
+        data, samples_per_block = adpcm_encode(samples, 256)
+        fmt = ustruct.pack(
+            "<HHIIHHHH", 0x11, 1, SAMPLE_RATE, SAMPLE_RATE * 256 // samples_per_block, 256, 4, 2,
+            samples_per_block,
+        )
+    else:
+        data = samples
+        fmt = ustruct.pack("<HHIIHH", 1, 1, SAMPLE_RATE, SAMPLE_RATE * 2, 2, 16)
+    with open(name, "wb") as f:
+        f.write(b"RIFF")
+        f.write(ustruct.pack("<I", 4 + 8 + len(fmt) + 8 + len(data)))
+        f.write(b"WAVEfmt ")
+        f.write(ustruct.pack("<I", len(fmt)))
+        f.write(fmt)
+        f.write(b"data")
+        f.write(ustruct.pack("<I", len(data)))
+        f.write(data)
+
+
+bdev = SlowBlockDevice(320)
+uos.VfsFat.mkfs(bdev)
+uos.mount(uos.VfsFat(bdev), "/ram")
+
+samples = array.array("h", [0]) * (SAMPLE_RATE * SECONDS)
+for i in range(len(samples)):
+    samples[i] = int(8000 * math.sin(i / 8) + 4000 * math.sin(i / 3))
+write_wave("/ram/pcm.wav", samples, False)
+write_wave("/ram/adpcm.wav", samples, True)
+
+for name in ("pcm", "adpcm"):
+    for latency in (0, 4000, 8000):
+        bdev.latency = latency
+        try:
+            wave = audiocore.WaveFile(open("/ram/%s.wav" % name, "rb"))
+        except ValueError:
+            print("%-5s unsupported" % name)
+            break
+        with open(OUTPUT, "wb") as f:
+            frames, underruns, cpu_us = audiosink.play(wave, f, SAMPLE_RATE * SECONDS)
+        wave.deinit()
+        uos.remove(OUTPUT)
+        print(
+            "%-5s %4d us/read %3d underruns %5.1f ms CPU per second"
+            % (name, latency, underruns, cpu_us / 1000 / (frames / SAMPLE_RATE))
+        )
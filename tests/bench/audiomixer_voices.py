@@ -0,0 +1,55 @@
+# Report how much faster than realtime audiomixer mixes N looping voices into a
+# file, with every voice at the mixer's sample rate and with half of them
+# resampled from other rates.
+# Run directly, eg: micropython_audio audiomixer_voices.py
+# (this is not picked up by run-bench-tests)
+
+import array
+import audiocore
+import audiomixer
+import audiosink
+import math
+import time
+import uos
+
+SAMPLE_RATE = 22050
+SECONDS = 10
+OUTPUT = "audiomixer_voices.raw"
+
+
+def tone(frequency, sample_rate):
+    length = sample_rate // frequency
+    samples = array.array("h", [0] * length)
+    for i in range(length):
+        samples[i] = int(math.sin(2 * math.pi * i / length) * 8000)
+    return audiocore.RawSample(samples, sample_rate=sample_rate)
+
+
+def mix(voices, resampled):
+    mixer = audiomixer.Mixer(
+        voice_count=voices,
+        buffer_size=1024,
+        channel_count=1,
+        bits_per_sample=16,
+        samples_signed=True,
+        sample_rate=SAMPLE_RATE,
+    )
+    for v in range(voices):
+        rate = SAMPLE_RATE
+        if resampled and v % 2:
+            rate = (16000, 44100)[v // 2 % 2]
+        mixer.voice[v].level = 1 / voices
+        mixer.voice[v].play(tone(220 + 110 * v, rate), loop=True)
+    with open(OUTPUT, "wb") as f:
+        t = time.ticks_us()
+        audiosink.write(mixer, f, SAMPLE_RATE * SECONDS)
+        dt = time.ticks_diff(time.ticks_us(), t)
+    uos.remove(OUTPUT)
+    name = "%d voices%s" % (voices, " resampled" if resampled else "")
+    print("%-22s %6.1fx realtime" % (name, SECONDS * 1000000 / dt))
+
+
+for voices in (1, 2, 4, 8):
+    mix(voices, False)
+for voices in (2, 4, 8):
+    mix(voices, True)
@@ -0,0 +1,12 @@
+import bench
+
+
+def test(num):
+    i = 0
+    n = 0
+    while i < num:
+        if i == n:
+            n += 2
+        i += 1
+
+bench.run(test)
@@ -0,0 +1,13 @@
+import bench
+
+
+def test(num):
+    a = 1
+    b = 2
+    for i in range(num // 4):
+        c = a + b
+        c = a - b
+        c = a * b
+        c = a & b
+
+bench.run(test)
@@ -0,0 +1,15 @@
+import bench
+
+class Foo:
+
+    def __init__(self):
+        self.x = 1
+        self.y = 2
+
+def test(num):
+    o = Foo()
+    for i in range(num // 2):
+        o.x
+        o.y
+
+bench.run(test)
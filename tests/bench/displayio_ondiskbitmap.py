@@ -0,0 +1,80 @@
+# Report how long it takes to draw a full-screen BMP from a FAT filesystem.
+# Run directly, eg: micropython_displayio displayio_ondiskbitmap.py
+# (this is not picked up by run-bench-tests)
+
+import displayio
+import ustruct as struct
+import time
+import uos
+
+WIDTH = 320
+HEIGHT = 240
+
+
+class RAMBlockDevice:
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        start = n * self.SEC_SIZE
+        buf[:] = self.data[start : start + len(buf)]
+
+    def writeblocks(self, n, buf):
+        start = n * self.SEC_SIZE
+        self.data[start : start + len(buf)] = buf
+
+    def ioctl(self, op, arg):
+        if op == 4:  # BP_IOCTL_SEC_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # BP_IOCTL_SEC_SIZE
+            return self.SEC_SIZE
+
+
+def write_bmp(f, bits_per_pixel):
+    stride = (WIDTH * bits_per_pixel // 8 + 3) & ~3
+    colors = 1 << bits_per_pixel if bits_per_pixel <= 8 else 0
+    data_offset = 14 + 40 + colors * 4
+    f.write(b"BM")
+    f.write(struct.pack("<IHHI", data_offset + stride * HEIGHT, 0, 0, data_offset))
+    f.write(
+        struct.pack(
+            "<IiiHHIIiiII", 40, WIDTH, HEIGHT, 1, bits_per_pixel, 0, stride * HEIGHT, 0, 0, colors, 0
+        )
+    )
+    # The header is 138 bytes long in the newest format, OnDiskBitmap reads that much.
+    for i in range(colors):
+        f.write(struct.pack("<I", i * 0x010203 & 0xFFFFFF))
+    row = bytearray(stride)
+    for y in range(HEIGHT):
+        for i in range(stride):
+            row[i] = (i + y) & 0xFF
+        f.write(row)
+    if data_offset + stride * HEIGHT < 138:
+        f.write(bytes(138))
+
+
+def render(vfs, name):
+    with vfs.open(name, "rb") as f:
+        bitmap = displayio.OnDiskBitmap(f)
+        display = displayio.MemoryDisplay(WIDTH, HEIGHT)
+        group = displayio.Group()
+        group.append(displayio.TileGrid(bitmap, pixel_shader=displayio.ColorConverter()))
+        display.show(group)
+        t = time.ticks_us()
+        display.refresh()
+        dt = time.ticks_diff(time.ticks_us(), t)
+        return dt, bytes(display)
+
+
+bdev = RAMBlockDevice(1024)
+uos.VfsFat.mkfs(bdev)
+vfs = uos.VfsFat(bdev)
+
+for bits_per_pixel in (8, 16, 24):
+    name = "image%d.bmp" % bits_per_pixel
+    with vfs.open(name, "wb") as f:
+        write_bmp(f, bits_per_pixel)
+    dt, pixels = render(vfs, name)
+    print("%2d bpp %6d us %5.1f fps" % (bits_per_pixel, dt, 1000000 / dt))
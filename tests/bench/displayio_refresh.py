@@ -0,0 +1,65 @@
+# Report displayio refresh rates with and without tiled refresh.
+# Run directly, eg: micropython_displayio displayio_refresh.py
+# (this is not picked up by run-bench-tests)
+
+import displayio
+import time
+
+WIDTH = 320
+HEIGHT = 240
+FRAMES = 200
+
+
+def solid(width, height, colors):
+    bitmap = displayio.Bitmap(width, height, len(colors))
+    for y in range(height):
+        for x in range(width):
+            bitmap[x, y] = (x // 8 + y // 8) % len(colors)
+    palette = displayio.Palette(len(colors))
+    for i, c in enumerate(colors):
+        palette[i] = c
+    return bitmap, palette
+
+
+def scene():
+    root = displayio.Group(max_size=16)
+    bitmap, palette = solid(WIDTH, HEIGHT, (0x102030, 0x203040))
+    root.append(displayio.TileGrid(bitmap, pixel_shader=palette))
+    # Panels with transparent holes, so lower layers show through.
+    bitmap, palette = solid(96, 64, (0x808080, 0xFF0000, 0x00FF00))
+    palette.make_transparent(0)
+    for i in range(8):
+        root.append(
+            displayio.TileGrid(bitmap, pixel_shader=palette, x=(i % 4) * 80, y=(i // 4) * 120)
+        )
+    # A label scrolling over everything else, with a shadow and an outline
+    # whose dirty areas mostly overlap it.
+    bitmap, palette = solid(120, 16, (0xFFFFFF, 0x000000))
+    palette.make_transparent(1)
+    labels = []
+    for i in range(3):
+        label = displayio.TileGrid(bitmap, pixel_shader=palette, y=100 + i)
+        root.append(label)
+        labels.append(label)
+    return root, labels
+
+
+def run(tile_size):
+    display = displayio.MemoryDisplay(WIDTH, HEIGHT, tile_size=tile_size)
+    root, labels = scene()
+    display.show(root)
+    display.refresh()
+    t = time.ticks_us()
+    for i in range(FRAMES):
+        for j, label in enumerate(labels):
+            label.x = (i + j) % (WIDTH - 120)
+        display.refresh()
+    dt = time.ticks_diff(time.ticks_us(), t)
+    print("tile_size=%-3d %d fps" % (tile_size, FRAMES * 1000000 // dt))
+    return bytes(display)
+
+
+reference = run(0)
+for tile_size in (8, 16, 32):
+    if run(tile_size) != reference:
+        print("tile_size=%d framebuffer mismatch" % tile_size)
@@ -0,0 +1,104 @@
+# Report full-screen TileGrid render rates for common bitmap and shader types.
+# Run directly, eg: micropython_displayio displayio_tilegrid.py
+# (this is not picked up by run-bench-tests)
+
+import displayio
+import time
+
+WIDTH = 320
+HEIGHT = 240
+FRAMES = 50
+
+
+def pattern(bitmap, count):
+    for y in range(bitmap.height):
+        for x in range(bitmap.width):
+            bitmap[x, y] = (x * 7 + y * 3) % count
+
+
+def palette(count, transparent=None):
+    p = displayio.Palette(count)
+    for i in range(count):
+        p[i] = (i * 0x010305) & 0xFFFFFF
+    if transparent is not None:
+        p.make_transparent(transparent)
+    return p
+
+
+def background():
+    bitmap = displayio.Bitmap(WIDTH, HEIGHT, 256)
+    pattern(bitmap, 256)
+    return displayio.TileGrid(bitmap, pixel_shader=palette(256))
+
+
+def sprite_sheet():
+    # 16x16 tiles from a 4 bit sheet, covering the screen.
+    bitmap = displayio.Bitmap(128, 64, 16)
+    pattern(bitmap, 16)
+    return displayio.TileGrid(
+        bitmap,
+        pixel_shader=palette(16),
+        width=WIDTH // 16,
+        height=HEIGHT // 16,
+        tile_width=16,
+        tile_height=16,
+    )
+
+
+def sprites_over_background():
+    group = displayio.Group(max_size=2)
+    group.append(background())
+    bitmap = displayio.Bitmap(128, 64, 16)
+    pattern(bitmap, 16)
+    sprites = displayio.TileGrid(
+        bitmap,
+        pixel_shader=palette(16, transparent=0),
+        width=WIDTH // 16,
+        height=HEIGHT // 16,
+        tile_width=16,
+        tile_height=16,
+    )
+    for i in range((WIDTH // 16) * (HEIGHT // 16)):
+        sprites[i] = i % 32
+    group.append(sprites)
+    return group
+
+
+def true_color():
+    bitmap = displayio.Bitmap(WIDTH, HEIGHT, 65536)
+    pattern(bitmap, 65536)
+    return displayio.TileGrid(bitmap, pixel_shader=displayio.ColorConverter())
+
+
+def flipped():
+    tilegrid = background()
+    tilegrid.flip_x = True
+    return tilegrid
+
+
+def run(name, layer):
+    display = displayio.MemoryDisplay(WIDTH, HEIGHT)
+    if isinstance(layer, displayio.Group):
+        group = layer
+    else:
+        group = displayio.Group()
+        group.append(layer)
+    display.show(group)
+    t = time.ticks_us()
+    for i in range(FRAMES):
+        display.show(displayio.Group())
+        display.show(group)
+        display.refresh()
+    dt = time.ticks_diff(time.ticks_us(), t)
+    print("%-26s %5.1f fps" % (name, FRAMES * 1000000 / dt))
+    return bytes(display)
+
+
+for name, make in (
+    ("8 bit palette", background),
+    ("4 bit sprite sheet", sprite_sheet),
+    ("sprites over background", sprites_over_background),
+    ("16 bit ColorConverter", true_color),
+    ("8 bit palette, flip_x", flipped),
+):
+    run(name, make())
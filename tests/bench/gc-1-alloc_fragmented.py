@@ -0,0 +1,13 @@
+import bench
+
+def test(num):
+    # fragment the heap: keep every other small object alive
+    keep = []
+    for i in range(2000):
+        b = bytearray(16 + (i % 5) * 16)
+        if i % 2:
+            keep.append(b)
+    for i in iter(range(num // 200)):
+        bytearray(64 + (i % 8) * 32)
+
+bench.run(test)
@@ -0,0 +1,45 @@
+# Report GC pause times when many objects with a finaliser become garbage,
+# with finalisers run by the sweep (budget=0) or queued and run in batches.
+# Run directly, eg: micropython gc_finaliser.py
+# (this is not picked up by run-bench-tests)
+
+import gc
+
+N_OBJ = 5000
+N_ROUND = 10
+
+n_del = 0
+
+
+class Res:
+    def __del__(self):
+        global n_del
+        n_del += 1
+
+
+Res()
+gc.collect()
+if not n_del or not hasattr(gc, "pause_stats"):
+    print("SKIP")
+    raise SystemExit
+
+
+def churn():
+    for r in range(N_ROUND):
+        objs = [Res() for i in range(N_OBJ)]
+        objs = None
+        for i in range(N_OBJ):
+            bytearray(64)
+
+
+for budget in (0, 1000, 200):
+    gc.incremental(budget)
+    gc.collect()
+    n_del = 0
+    gc.pause_stats(True)
+    churn()
+    count, total, longest, recent = gc.pause_stats(True)
+    print(
+        "budget=%-5d pauses=%d mean=%dus max=%dus finalised=%d"
+        % (budget, count, total // max(count, 1), longest, n_del)
+    )
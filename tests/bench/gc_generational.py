@@ -0,0 +1,61 @@
+# Report how long major and minor collections take with a large amount of
+# long-lived data on the heap, and the GC pauses of a float-heavy workload
+# with generational collection enabled and disabled.
+# Run directly, eg: micropython gc_generational.py
+# (this is not picked up by run-bench-tests)
+
+import gc
+import utime
+
+N_STATE = 5000
+N_WORK = 300000
+REPEAT = 10
+
+
+class Point:
+    def __init__(self, x, y):
+        self.x = x
+        self.y = y
+
+
+def make_state():
+    return {i: (Point(i, -i), "item%d" % i, [i]) for i in range(N_STATE)}
+
+
+def time_collect(*args):
+    t = 0
+    for i in range(REPEAT):
+        t0 = utime.ticks_us()
+        gc.collect(*args)
+        t += utime.ticks_diff(utime.ticks_us(), t0)
+    return t // REPEAT
+
+
+def work():
+    x = 0.5
+    for i in range(N_WORK):
+        x = x * 1.0000001 + 0.25
+    return x
+
+
+def run_work(n_minor):
+    gc.generational(n_minor)
+    gc.collect()
+    gc.pause_stats(True)
+    t0 = utime.ticks_us()
+    work()
+    t = utime.ticks_diff(utime.ticks_us(), t0)
+    count, total, pause_max, recent = gc.pause_stats()
+    print("work, generational(%d): %6d us, %3d pauses, total %6d us, max %5d us" % (
+        n_minor, t, count, total, pause_max))
+
+
+state = make_state()
+# survive enough collections to become old
+for i in range(4):
+    gc.collect()
+print("major collection: %6d us" % time_collect())
+print("minor collection: %6d us" % time_collect(0))
+n_minor = gc.generational()
+run_work(0)
+run_work(n_minor)
@@ -0,0 +1,38 @@
+# Report gc_alloc latency percentiles on a fragmented heap.
+# Run directly, eg: micropython gc_latency.py
+# (this is not picked up by run-bench-tests)
+
+import gc
+import time
+
+N_KEEP = 4000
+N_ALLOC = 5000
+
+def fragment():
+    keep = []
+    for i in range(N_KEEP):
+        b = bytearray(16 + (i % 7) * 16)
+        if i % 3:
+            keep.append(b)
+    return keep
+
+def measure(size):
+    lat = []
+    ticks_us = time.ticks_us
+    ticks_diff = time.ticks_diff
+    for i in range(N_ALLOC):
+        t = ticks_us()
+        bytearray(size)
+        lat.append(ticks_diff(ticks_us(), t))
+    lat.sort()
+    return lat
+
+def report(size, lat):
+    n = len(lat)
+    print("size %4d: p50 %dus p90 %dus p99 %dus max %dus" % (
+        size, lat[n // 2], lat[n * 9 // 10], lat[n * 99 // 100], lat[-1]))
+
+gc.collect()
+keep = fragment()
+for size in (16, 64, 256, 1024):
+    report(size, measure(size))
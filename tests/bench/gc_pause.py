@@ -0,0 +1,32 @@
+# Report GC pause times with and without incremental sweeping.
+# Run directly, eg: micropython gc_pause.py
+# (this is not picked up by run-bench-tests)
+
+import gc
+
+N_LIVE = 20000
+N_CHURN = 200000
+
+
+def churn():
+    live = [bytearray(8) for i in range(N_LIVE)]
+    for i in range(N_CHURN):
+        bytearray(32)
+    return live
+
+
+def report(name):
+    count, total, longest, recent = gc.pause_stats(True)
+    recent.sort()
+    print(
+        "%-12s pauses=%d mean=%dus p50=%dus max=%dus"
+        % (name, count, total // max(count, 1), recent[len(recent) // 2], longest)
+    )
+
+
+for budget in (0, 2000, 500, 100):
+    gc.incremental(budget)
+    gc.collect()
+    gc.pause_stats(True)
+    churn()
+    report("budget=%d" % budget)
@@ -0,0 +1,93 @@
+# Report allocations/sec for float-heavy workloads that churn small objects,
+# keeping a window of the most recent results alive, and how fragmented the
+# heap is afterwards (free memory that isn't part of the largest free block).
+# Run directly, eg: micropython gc_slab.py
+# (this is not picked up by run-bench-tests)
+
+import gc
+import utime
+
+N = 1000000
+K = 256
+
+
+def float_arith(n, keep):
+    # 2 floats per iteration
+    x = 1.5
+    for i in range(n):
+        x = x * 1.0000001 + 0.25
+        if i % 64 == 0:
+            keep[i // 64 % K] = x
+    return 2
+
+
+def float_tuples(n, keep):
+    # 2 floats and a tuple per iteration
+    x = 0.5
+    for i in range(n):
+        t = (x * 2.0, x + 1.0)
+        if i % 64 == 0:
+            keep[i // 64 % K] = t
+    return 3
+
+
+def float_lists(n, keep):
+    # a list, its item array and 8 floats every 8 iterations
+    for i in range(n // 8):
+        l = [j * 0.5 for j in range(8)]
+        if i % 8 == 0:
+            keep[i // 8 % K] = l
+    return 10 / 8
+
+
+class Vec:
+    def __init__(self, x, y):
+        self.x = x
+        self.y = y
+
+    def add(self, o):
+        return Vec(self.x + o.x, self.y + o.y)
+
+
+def vectors(n, keep):
+    # a bound method, an instance and its attributes, and 2 floats per iteration
+    v = Vec(0.0, 0.0)
+    d = Vec(0.5, 0.25)
+    for i in range(n):
+        v = v.add(d)
+        if i % 64 == 0:
+            keep[i // 64 % K] = v
+    return 5
+
+
+def largest_block():
+    lo = 0
+    hi = gc.mem_free()
+    while lo < hi:
+        mid = (lo + hi + 1) // 2
+        try:
+            b = bytearray(mid)
+            b = None
+            lo = mid
+        except MemoryError:
+            hi = mid - 1
+    return lo
+
+
+def run(name, f):
+    keep = [None] * K
+    gc.collect()
+    t = utime.ticks_us()
+    per = f(N, keep)
+    dt = utime.ticks_diff(utime.ticks_us(), t)
+    gc.collect()
+    free = gc.mem_free()
+    big = largest_block()
+    print("%-12s %8d allocs/s  free %7d  largest %7d  fragmentation %2d%%" % (
+        name, int(N * per * 1000000 / dt), free, big, 100 - big * 100 // free))
+
+
+run("float arith", float_arith)
+run("float tuples", float_tuples)
+run("float lists", float_lists)
+run("vectors", vectors)
@@ -0,0 +1,70 @@
+# Report where objects are placed with two heap areas, a small fast one and a
+# large slow one (like internal RAM and PSRAM), with placement by size and
+# without it, and the access time that placement gives if the large area is
+# SLOW times slower: small objects read HOT_READS times each, buffers read once.
+# Run directly, eg: micropython -X heapsize=256K -X largeheap=2M gc_split_heap.py
+# (this is not picked up by run-bench-tests)
+
+import gc
+import utime
+
+N_BUF = 48
+BUF = 4096
+N_HOT = 2000
+HOT_READS = 100
+SLOW = 4
+
+
+def area_of(areas, addr):
+    for i, (start, total, free) in enumerate(areas):
+        if start <= addr < start + total:
+            return i
+    return -1
+
+
+def mem_free():
+    return [free for start, total, free in gc.mem_areas()]
+
+
+def run(threshold):
+    gc.large_threshold(threshold)
+    gc.collect()
+    areas = gc.mem_areas()
+    if len(areas) < 2:
+        print("needs a large heap area, eg -X largeheap=2M")
+        raise SystemExit
+
+    # buffers, as for bitmaps or audio; their data isn't visible to id(), so
+    # count the bytes each area lost
+    free0 = mem_free()
+    t0 = utime.ticks_us()
+    bufs = [bytearray(BUF) for i in range(N_BUF)]
+    t_bufs = utime.ticks_diff(utime.ticks_us(), t0)
+    free1 = mem_free()
+    buf_slow = min(1, (free0[1] - free1[1]) / (N_BUF * BUF))
+
+    # small objects that are used all the time
+    t0 = utime.ticks_us()
+    hot = [(i * 0.5, [i]) for i in range(N_HOT)]
+    t_hot = utime.ticks_diff(utime.ticks_us(), t0)
+    n_fast = 0
+    n = 0
+    for t in hot:
+        for o in (t, t[0], t[1]):
+            n += 1
+            if area_of(areas, id(o)) == 0:
+                n_fast += 1
+
+    hot_reads = n * HOT_READS
+    buf_reads = N_BUF * BUF // 4
+    cost = (hot_reads * (n_fast + SLOW * (n - n_fast)) / n
+        + buf_reads * (1 - buf_slow + SLOW * buf_slow))
+    print("large_threshold %4d: small objects in fast area %3d%%, buffer bytes in large area %3d%%, "
+        "alloc %5d us, relative access time %.2f" % (
+        threshold, n_fast * 100 // n, int(buf_slow * 100), t_bufs + t_hot, cost / (hot_reads + buf_reads)))
+    bufs = None
+    hot = None
+
+
+run(0)
+run(1024)
@@ -0,0 +1,41 @@
+# Report heap used per instance and the time taken to access its attributes.
+# Run directly, eg: micropython instance_shapes.py
+# (this is not picked up by run-bench-tests)
+
+import gc
+import time
+
+N = 1000
+ITERS = 2000
+
+
+class Point:
+    def __init__(self, x, y, z):
+        self.x = x
+        self.y = y
+        self.z = z
+
+
+def make(points):
+    for i in range(N):
+        points[i] = Point(i, i + 1, i + 2)
+
+
+def access(points):
+    t = 0
+    for _ in range(ITERS):
+        for p in points:
+            t += p.x + p.y + p.z
+            p.x = p.z
+    return t
+
+
+points = [None] * N
+gc.collect()
+before = gc.mem_alloc()
+make(points)
+gc.collect()
+print("bytes/instance=%d" % ((gc.mem_alloc() - before) // N))
+t0 = time.ticks_us()
+access(points)
+print("access=%dms" % (time.ticks_diff(time.ticks_us(), t0) // 1000))
@@ -0,0 +1,51 @@
+# Report the throughput of big int multiply, square, pow(a, b, m) and
+# conversion to and from decimal strings at a few operand sizes.
+# Run directly, eg: micropython -X heapsize=16M int_big.py
+# (this is not picked up by run-bench-tests)
+
+import utime
+
+_seed = [1]
+
+
+def rand(bits):
+    r = 0
+    while bits > 0:
+        _seed[0] = (_seed[0] * 1103515245 + 12345) & 0x7FFFFFFF
+        n = min(bits, 16)
+        r = r << n | _seed[0] >> (31 - n)
+        bits -= n
+    return r
+
+
+def bench(what, bits, f, *args):
+    n = 0
+    t0 = utime.ticks_us()
+    while True:
+        f(*args)
+        n += 1
+        t = utime.ticks_diff(utime.ticks_us(), t0)
+        if t > 200000:
+            break
+    print("%-6s %6d bits %10.1f ops/s" % (what, bits, n * 1000000 / t))
+
+
+def mul(a, b):
+    return a * b
+
+
+def sqr(a):
+    return a * a
+
+
+for bits in (256, 1024, 4096, 16384):
+    a = rand(bits) | 1 << (bits - 1)
+    b = rand(bits) | 1 << (bits - 1)
+    m = rand(bits) | 1 << (bits - 1) | 1
+    s = str(a)
+    bench("mul", bits, mul, a, b)
+    bench("sqr", bits, sqr, a)
+    if bits <= 4096:
+        bench("pow3", bits, pow, a, b, m)
+    bench("str", bits, str, a)
+    bench("int", bits, int, s)
@@ -0,0 +1,51 @@
+# Report the time taken to print lines while iot.dupterm copies the console to
+# a socket, written straight through or buffered with either overflow policy.
+# Run directly, eg: micropython_iot iot_dupterm.py | tail -4
+# (this is not picked up by run-bench-tests)
+
+import iot
+import usocket
+import utime
+
+LINES = 2000
+
+
+class Terminal:
+    # sends what it gets to a socket, like a telnet connection would
+    def __init__(self):
+        self.tx, self.rx = usocket.socketpair()
+        self.writes = 0
+
+    def write(self, data):
+        self.writes += 1
+        n = self.tx.send(data)
+        self.rx.recv(4096)
+        return n
+
+    def close(self):
+        self.tx.close()
+        self.rx.close()
+
+
+def run(what, **kwargs):
+    terminal = Terminal()
+    iot.dupterm(terminal, **kwargs)
+    t0 = utime.ticks_us()
+    for i in range(LINES):
+        print("sensor", i, "reading", i * 7 % 1000)
+    iot.dupterm_flush()
+    us = utime.ticks_diff(utime.ticks_us(), t0)
+    dropped = iot.dupterm_stats()[1]
+    iot.dupterm(None)
+    terminal.close()
+    return "%-24s %7d us %6d writes %6d bytes dropped" % (what, us, terminal.writes, dropped)
+
+
+results = [
+    run("unbuffered"),
+    run("buffer 1024, block", buffer_size=1024, block=True),
+    run("buffer 1024, drop", buffer_size=1024),
+    run("buffer 16384, drop", buffer_size=16384),
+]
+for r in results:
+    print(r)
@@ -0,0 +1,132 @@
+# Report CPU use and wakeup latency of sensor timers and sockets served by
+# iot.EventLoop, compared with a Python loop polling a TimeQueue and uselect.
+# Run directly, eg: micropython_iot iot_eventloop.py
+# (this is not picked up by run-bench-tests)
+
+import iot
+import uselect
+import usocket
+import utime
+
+SECONDS = 2
+SENSORS = 20
+SENSOR_PERIOD = 0.05
+SOCKETS = 8
+MESSAGE_PERIOD = 0.02
+
+
+def cpu_ms():
+    # utime + stime of this process, in clock ticks of 10 ms
+    with open("/proc/self/stat") as f:
+        fields = f.read().split(")")[-1].split()
+    return (int(fields[11]) + int(fields[12])) * 10
+
+
+class Stats:
+    def __init__(self):
+        self.n = 0
+        self.total = 0
+        self.max = 0
+
+    def add(self, us):
+        self.n += 1
+        self.total += us
+        self.max = max(self.max, us)
+
+    def __str__(self):
+        return "%5d us mean %6d us max" % (self.total // max(self.n, 1), self.max)
+
+
+def message():
+    return b"%010d" % (utime.ticks_us() & 0x3FFFFFFF)
+
+
+def delivered(data, stats):
+    sent = int(data[-10:])
+    stats.add(utime.ticks_diff(utime.ticks_us() & 0x3FFFFFFF, sent))
+
+
+def event_loop(timers, sockets):
+    loop = iot.EventLoop(SENSORS + 2 * SOCKETS)
+    end = utime.ticks_add(utime.ticks_ms(), SECONDS * 1000)
+
+    def sensor(period):
+        due = utime.ticks_us()
+        while utime.ticks_diff(end, utime.ticks_ms()) > 0:
+            timers.add(max(0, utime.ticks_diff(utime.ticks_us(), due)))
+            due = utime.ticks_add(due, int(period * 1000000))
+            yield max(0, utime.ticks_diff(due, utime.ticks_us())) / 1000000
+
+    def producer(sock):
+        while utime.ticks_diff(end, utime.ticks_ms()) > 0:
+            sock.send(message())
+            yield MESSAGE_PERIOD
+        sock.close()
+
+    def consumer(sock):
+        while True:
+            yield loop.readable(sock)
+            data = sock.recv(10)
+            if not data:
+                sock.close()
+                return
+            delivered(data, sockets)
+
+    for i in range(SENSORS):
+        loop.create_task(sensor(SENSOR_PERIOD))
+    for i in range(SOCKETS):
+        a, b = usocket.socketpair()
+        loop.create_task(producer(a))
+        loop.create_task(consumer(b))
+    loop.run()
+
+
+def busy_loop(timers, sockets):
+    queue = iot.TimeQueue(SENSORS + SOCKETS)
+    poll = uselect.poll()
+    end = utime.ticks_add(utime.ticks_ms(), SECONDS * 1000)
+
+    def sensor(period):
+        due = [utime.ticks_us()]
+
+        def run():
+            timers.add(max(0, utime.ticks_diff(utime.ticks_us(), due[0])))
+            due[0] = utime.ticks_add(due[0], int(period * 1000000))
+            queue.after(max(0, utime.ticks_diff(due[0], utime.ticks_us())) / 1000000, run)
+
+        return run
+
+    def producer(sock):
+        def run():
+            sock.send(message())
+            queue.after(MESSAGE_PERIOD, run)
+
+        return run
+
+    for i in range(SENSORS):
+        queue.after(0, sensor(SENSOR_PERIOD))
+    pairs = []
+    for i in range(SOCKETS):
+        a, b = usocket.socketpair()
+        pairs.append((a, b))
+        queue.after(0, producer(a))
+        poll.register(b, uselect.POLLIN)
+    while utime.ticks_diff(end, utime.ticks_ms()) > 0:
+        while queue and queue.peek_time <= 0:
+            queue.pop()()
+        for sock, event in poll.poll(0):
+            delivered(sock.recv(10), sockets)
+    for a, b in pairs:
+        a.close()
+        b.close()
+
+
+for name, run in (("python busy loop", busy_loop), ("iot.EventLoop", event_loop)):
+    timers = Stats()
+    sockets = Stats()
+    cpu = cpu_ms()
+    run(timers, sockets)
+    cpu = cpu_ms() - cpu
+    print("%s: %3d%% cpu" % (name, cpu * 100 // (SECONDS * 1000)))
+    print("  %4d sensor readings, late by %s" % (timers.n, timers))
+    print("  %4d socket messages, delivered in %s" % (sockets.n, sockets))
@@ -0,0 +1,68 @@
+# Report the cost of scheduling, rescheduling, cancelling and popping 10k
+# iot.TimeQueue timers, compared with cancelling by draining and rebuilding.
+# Run directly, eg: micropython_iot iot_timequeue.py
+# (this is not picked up by run-bench-tests)
+
+import iot
+import utime
+
+TIMERS = 10000
+REBUILDS = 20
+
+_seed = [1]
+
+
+def rand(n):
+    _seed[0] = (_seed[0] * 1103515245 + 12345) & 0x7FFFFFFF
+    return (_seed[0] >> 8) % n
+
+
+def delay():
+    # far enough out that nothing comes due while the benchmark runs
+    return 1000 + rand(100000) / 1000
+
+
+def report(what, n, t0):
+    us = utime.ticks_diff(utime.ticks_us(), t0)
+    print("%-28s %6d ops %8d us %7.2f us/op" % (what, n, us, us / n))
+
+
+q = iot.TimeQueue(TIMERS)
+handles = []
+t0 = utime.ticks_us()
+for i in range(TIMERS):
+    handles.append(q.after(delay(), i))
+report("after", TIMERS, t0)
+
+t0 = utime.ticks_us()
+for h in handles:
+    q.reschedule(h, delay())
+report("reschedule", TIMERS, t0)
+
+t0 = utime.ticks_us()
+for h in handles[::2]:
+    q.cancel(h)
+report("cancel", TIMERS // 2, t0)
+
+t0 = utime.ticks_us()
+n = 0
+while q:
+    q.pop()
+    n += 1
+report("pop", n, t0)
+
+# without handles, cancelling one timer means draining the queue and putting
+# back everything else
+for i in range(TIMERS):
+    q.after(delay(), i)
+t0 = utime.ticks_us()
+for r in range(REBUILDS):
+    keep = []
+    while q:
+        t = q.peek_time
+        item = q.pop()
+        if item != r:
+            keep.append((t, item))
+    for t, item in keep:
+        q.after(t, item)
+report("cancel by drain and rebuild", REBUILDS, t0)
@@ -0,0 +1,51 @@
+# Report how long list.sort takes on 10k items that are random, already sorted,
+# reversed, nearly sorted and made of a few sorted runs, and with a key function.
+# Run directly, eg: micropython list_sort.py
+# (this is not picked up by run-bench-tests)
+
+import utime
+
+N = 10000
+REPEAT = 5
+
+_seed = [1]
+
+
+def rand(n):
+    _seed[0] = (_seed[0] * 1103515245 + 12345) & 0x7FFFFFFF
+    return (_seed[0] >> 8) % n
+
+
+def nearly_sorted():
+    l = list(range(N))
+    for i in range(N // 100):
+        a = rand(N)
+        b = rand(N)
+        l[a], l[b] = l[b], l[a]
+    return l
+
+
+def runs():
+    l = []
+    for i in range(8):
+        l.extend(range(i, N, 8))
+    return l
+
+
+def bench(what, make, **kw):
+    t = 0
+    for i in range(REPEAT):
+        l = make()
+        t0 = utime.ticks_us()
+        l.sort(**kw)
+        t += utime.ticks_diff(utime.ticks_us(), t0)
+    print("%-16s %8d us" % (what, t // REPEAT))
+
+
+bench("random", lambda: [rand(N) for i in range(N)])
+bench("sorted", lambda: list(range(N)))
+bench("reversed", lambda: list(range(N, 0, -1)))
+bench("nearly sorted", nearly_sorted)
+bench("8 runs", runs)
+bench("random floats", lambda: [rand(N) / 7 for i in range(N)])
+bench("random, key", lambda: [rand(N) for i in range(N)], key=lambda x: -x)
@@ -0,0 +1,45 @@
+# Report msgpack pack throughput for a 1000-field dict, to a stream and
+# into a preallocated bytearray.
+# Run directly, eg: micropython msgpack_pack.py
+# (this is not picked up by run-bench-tests)
+
+import time
+
+try:
+    from uio import BytesIO
+except ImportError:
+    from io import BytesIO
+import msgpack
+
+N = 1000
+ITERS = 1000
+
+d = {}
+for i in range(N):
+    d["field%d" % i] = i * 37 if i % 3 else "v%d" % i
+
+
+def pack_stream():
+    for _ in range(ITERS):
+        b = BytesIO()
+        msgpack.pack(d, b)
+    return len(b.getvalue())
+
+
+def pack_into(buf):
+    for _ in range(ITERS):
+        n = msgpack.pack_into(d, buf)
+    return n
+
+
+def report(name, f, *args):
+    t0 = time.ticks_us()
+    n = f(*args)
+    dt = time.ticks_diff(time.ticks_us(), t0)
+    print("%-10s %dms %dkB/s" % (name, dt // 1000, n * ITERS * 1000 // max(dt, 1)))
+    return n
+
+
+n = report("stream", pack_stream)
+if hasattr(msgpack, "pack_into"):
+    report("pack_into", pack_into, bytearray(n))
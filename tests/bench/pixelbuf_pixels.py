@@ -0,0 +1,59 @@
+# Report how many pixels per second _pixelbuf sets from tuples, ints, packed
+# bytes and fill(), at full brightness, dimmed and gamma corrected.
+# Run directly, eg: micropython_pixelbuf pixelbuf_pixels.py
+# (this is not picked up by run-bench-tests)
+
+import _pixelbuf
+import time
+
+PIXELS = 1024
+ROUNDS = 100
+
+
+class Strip(_pixelbuf.PixelBuf):
+    def _transmit(self, buffer):
+        pass
+
+
+def frame(n, bpp):
+    data = bytearray(n * bpp)
+    for i in range(len(data)):
+        data[i] = (i * 7) & 0xFF
+    return data
+
+
+def assign(values):
+    def update(strip):
+        strip[:] = values
+
+    return update
+
+
+def bench(name, strip, update):
+    t = time.ticks_us()
+    for _ in range(ROUNDS):
+        update(strip)
+    dt = time.ticks_diff(time.ticks_us(), t)
+    print("%-28s %10d pixels/s" % (name, PIXELS * ROUNDS * 1000000 // dt))
+
+
+def run(byteorder, brightness, gamma):
+    strip = Strip(PIXELS, byteorder=byteorder, brightness=brightness)
+    strip.gamma = gamma
+    bpp = len(byteorder)
+    data = frame(PIXELS, bpp)
+    tuples = [tuple(data[i : i + bpp]) for i in range(0, len(data), bpp)]
+    ints = [data[i] << 16 | data[i + 1] << 8 | data[i + 2] for i in range(0, len(data), bpp)]
+    rgb = "RGBW" if bpp == 4 else "RGB"
+    print("%s brightness %.1f gamma %.1f" % (byteorder, brightness, gamma))
+    bench("  tuple slice", strip, assign(tuples))
+    bench("  int slice", strip, assign(ints))
+    bench("  bytearray slice", strip, assign(data))
+    bench("  load " + rgb, strip, lambda s: s.load(data, byteorder=rgb))
+    bench("  load " + byteorder, strip, lambda s: s.load(data, byteorder=byteorder))
+    bench("  fill", strip, lambda s: s.fill(0x102030))
+
+
+for byteorder in ("GRB", "GRBW"):
+    for brightness, gamma in ((1.0, 1.0), (0.5, 1.0), (0.5, 2.6)):
+        run(byteorder, brightness, gamma)
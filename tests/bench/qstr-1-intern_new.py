@@ -0,0 +1,8 @@
+import bench
+
+def test(num):
+    o = bench
+    for i in iter(range(num // 1000)):
+        getattr(o, "qstr_new_%d" % i, None)
+
+bench.run(test)
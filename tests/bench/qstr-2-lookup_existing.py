@@ -0,0 +1,12 @@
+import bench
+
+def test(num):
+    o = bench
+    names = ["qstr_existing_%d" % i for i in range(num // 4000)]
+    for n in names:
+        getattr(o, n, None)
+    for i in iter(range(4)):
+        for n in names:
+            getattr(o, n, None)
+
+bench.run(test)
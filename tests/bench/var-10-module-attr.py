@@ -0,0 +1,10 @@
+import bench
+import sys
+
+def test(num):
+    i = 0
+    while i < num:
+        sys.print_exception
+        i += 1
+
+bench.run(test)
@@ -0,0 +1,10 @@
+import bench
+
+def test(num):
+    s = "a"
+    i = 0
+    while i < num:
+        s.islower()
+        i += 1
+
+bench.run(test)
@@ -0,0 +1,44 @@
+# Report how long vectorio takes to draw polygons of increasing vertex count,
+# and a circle and a rectangle of similar size.
+# Run directly, eg: micropython_displayio vectorio_shapes.py
+# (this is not picked up by run-bench-tests)
+
+import displayio
+import math
+import time
+import vectorio
+
+WIDTH = 320
+HEIGHT = 240
+RADIUS = 100
+
+
+def star(vertices):
+    # Alternate between an outer and inner radius so the polygon is concave.
+    points = []
+    for i in range(vertices):
+        r = RADIUS if i % 2 == 0 else RADIUS * 2 // 3
+        a = 2 * math.pi * i / vertices
+        points.append((int(r * math.cos(a)), int(r * math.sin(a))))
+    return vectorio.Polygon(points=points)
+
+
+def render(name, shape, x, y):
+    palette = displayio.Palette(2)
+    palette[0] = 0x000000
+    palette[1] = 0xFF8000
+    palette.make_transparent(0)
+    display = displayio.MemoryDisplay(WIDTH, HEIGHT)
+    group = displayio.Group()
+    group.append(vectorio.VectorShape(shape=shape, pixel_shader=palette, x=x, y=y))
+    display.show(group)
+    t = time.ticks_us()
+    display.refresh()
+    dt = time.ticks_diff(time.ticks_us(), t)
+    print("%-16s %7d us" % (name, dt))
+
+
+for vertices in (4, 16, 64, 256, 1024):
+    render("polygon %d" % vertices, star(vertices), WIDTH // 2, HEIGHT // 2)
+render("circle", vectorio.Circle(radius=RADIUS), WIDTH // 2, HEIGHT // 2)
+render("rectangle", vectorio.Rectangle(width=2 * RADIUS, height=2 * RADIUS), 60, 20)
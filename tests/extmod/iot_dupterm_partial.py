@@ -0,0 +1,70 @@
+# test iot.dupterm buffering with a terminal that takes only part of each write
+
+try:
+    import iot
+
+    iot.dupterm
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+import utime
+
+
+class Terminal:
+    def __init__(self, limit, busy=0):
+        self.limit = limit
+        # number of writes answered with None, like a non-blocking stream
+        self.busy = busy
+        self.out = bytearray()
+        self.longest = 0
+
+    def write(self, data):
+        self.longest = max(self.longest, len(data))
+        if self.busy > 0:
+            self.busy -= 1
+            return None
+        n = min(len(data), self.limit)
+        self.out.extend(data[:n])
+        return n
+
+
+# explicit flushes write as much as the terminal takes and keep the rest
+t = Terminal(5)
+iot.dupterm(t, buffer_size=64)
+print("hello world")
+iot.dupterm_flush()
+stats = iot.dupterm_stats()
+first = len(t.out)
+for i in range(10):
+    iot.dupterm_flush()
+iot.dupterm(None)
+print(first < 12, first + stats[0], stats[1], bytes(t.out))
+
+# writes returning None don't lose output
+t = Terminal(100, busy=2)
+iot.dupterm(t, buffer_size=64)
+print("busy")
+for i in range(4):
+    iot.dupterm_flush()
+iot.dupterm(None)
+print(bytes(t.out))
+
+# background flushes carry on with what is left
+t = Terminal(3)
+iot.dupterm(t, buffer_size=64)
+print("background")
+for i in range(20):
+    utime.sleep_ms(15)
+    if not iot.dupterm_stats()[0]:
+        break
+iot.dupterm(None)
+print(bytes(t.out), t.longest <= 64)
+
+# a blocking write gives up on a terminal that takes nothing, counting what it drops
+t = Terminal(0)
+iot.dupterm(t, buffer_size=8, block=True)
+print("0123456789abcdef")
+stats = iot.dupterm_stats()
+iot.dupterm(None)
+print(stats[0], stats[0] + stats[1], len(t.out))
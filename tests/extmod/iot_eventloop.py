@@ -0,0 +1,70 @@
+# test iot.EventLoop waiting for streams, with a socketpair
+
+try:
+    import iot
+    import usocket
+
+    usocket.socketpair
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+loop = iot.EventLoop()
+a, b = usocket.socketpair()
+log = []
+
+
+def reader(sock, n):
+    for i in range(n):
+        yield loop.readable(sock)
+        log.append(sock.recv(16))
+
+
+def writer(sock):
+    for msg in (b"one", b"two", b"three"):
+        yield 0.01
+        yield loop.writable(sock)
+        sock.send(msg)
+
+
+loop.create_task(reader(b, 3))
+loop.create_task(writer(a))
+loop.run()
+print(log)
+
+# a task waiting to read wakes up when the other end is closed
+log = []
+loop.create_task(reader(b, 1))
+loop.call_later(0.01, a.close)
+loop.run()
+print(log)
+b.close()
+
+# only one task can wait to read a stream
+a, b = usocket.socketpair()
+
+
+def waiter(sock):
+    yield loop.readable(sock)
+    print("woke", sock.recv(16))
+
+
+def second(sock):
+    try:
+        yield loop.readable(sock)
+    except OSError:
+        print("OSError")
+
+
+loop.create_task(waiter(b))
+loop.create_task(second(b))
+loop.call_later(0.01, lambda: a.send(b"x"))
+loop.run()
+
+# objects that aren't streams are rejected
+try:
+    loop.readable(1)
+except OSError:
+    print("OSError")
+a.close()
+b.close()
@@ -0,0 +1,53 @@
+# test cancel and reschedule of iot.TimeQueue entries
+
+try:
+    from iot import TimeQueue
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def drain(q):
+    out = []
+    while q:
+        out.append(q.pop())
+    return out
+
+
+def fill(q, delays):
+    return {name: q.after(delay, name) for name, delay in delays}
+
+
+DELAYS = (("d", 4), ("b", 2), ("f", 6), ("a", 1), ("g", 7), ("c", 3), ("e", 5))
+
+# cancel the head, an entry in the middle and the last one
+q = TimeQueue(8)
+h = fill(q, DELAYS)
+print(q.cancel(h["a"]), q.cancel(h["d"]), q.cancel(h["g"]))
+print(len(q), drain(q))
+
+# cancelling twice, or after the entry was popped, does nothing
+q = TimeQueue(8)
+h = fill(q, DELAYS)
+print(q.cancel(h["c"]), q.cancel(h["c"]))
+print(q.pop(), q.cancel(h["a"]), q.reschedule(h["a"], 1))
+print(len(q), drain(q))
+
+# reschedule earlier and later; the handle stays valid
+q = TimeQueue(8)
+h = fill(q, DELAYS)
+print(q.reschedule(h["g"], 0.5), q.reschedule(h["a"], 10), q.reschedule(h["d"], 2.5))
+print(q.reschedule(h["g"], 6.5), q.cancel(h["d"]))
+print(drain(q))
+
+# a handle is rejected once its slot is reused
+q = TimeQueue(1)
+old = q.after(1, "old")
+print(q.cancel(old))
+new = q.after(1, "new")
+print(old != new, q.cancel(old), q.reschedule(old, 5), len(q))
+print(q.pop())
+popped = q.after(1, "popped")
+q.pop()
+new = q.after(1, "new")
+print(q.cancel(popped), q.cancel(new), len(q))
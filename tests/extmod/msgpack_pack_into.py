@@ -0,0 +1,90 @@
+# test msgpack.pack_into and buffered msgpack.pack
+
+try:
+    try:
+        from uio import BytesIO
+    except ImportError:
+        from io import BytesIO
+    import msgpack
+
+    msgpack.pack_into
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+try:
+    import array
+except ImportError:
+    array = None
+
+
+def packb(obj):
+    b = BytesIO()
+    msgpack.pack(obj, b)
+    return b.getvalue()
+
+
+def unpackb(data):
+    return msgpack.unpack(BytesIO(data))
+
+
+# larger than the write buffer of pack, with small and big pieces
+d = {"k%d" % i: [i, "v" * (i % 50), b"b" * (i * 7)] for i in range(40)}
+data = packb(d)
+print(len(data), unpackb(data) == d)
+
+# same bytes from pack_into
+buf = bytearray(len(data))
+print(msgpack.pack_into(d, buf), bytes(buf) == data)
+
+# chained at offsets, negative offset counts from the end
+buf = bytearray(16)
+end = msgpack.pack_into(1, buf)
+end = msgpack.pack_into("ab", buf, end)
+end = msgpack.pack_into([None, True], buf, end)
+print(end, buf[:end])
+print(msgpack.pack_into(b"xy", buf, -4), buf[-4:])
+
+# does not fit
+try:
+    msgpack.pack_into(list(range(20)), bytearray(10))
+except ValueError:
+    print("ValueError")
+try:
+    msgpack.pack_into(1, bytearray(10), 11)
+except ValueError:
+    print("ValueError")
+
+# buffers are packed as bin
+mv = memoryview(b"0123456789")[2:5]
+print(packb(mv))
+if array:
+    a = array.array("H", [1, 2, 0x300])
+    n = msgpack.pack_into(a, buf)
+    print(buf[:n] == packb(bytes(a)), len(unpackb(buf[:n])))
+else:
+    print(True, 6)
+
+# default may resize the buffer being packed into
+class X:
+    pass
+
+
+def grow(o):
+    buf.extend(bytes(1000))
+    return 2
+
+
+def shrink(o):
+    buf[:] = b""
+    return 2
+
+
+buf = bytearray(8)
+n = msgpack.pack_into([1, X(), "abc"], buf, default=grow)
+print(n, len(buf), buf[:n] == packb([1, 2, "abc"]))
+buf = bytearray(8)
+try:
+    msgpack.pack_into([1, X()], buf, default=shrink)
+except ValueError:
+    print("ValueError")
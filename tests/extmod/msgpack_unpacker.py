@@ -0,0 +1,128 @@
+# test msgpack.Unpacker fed in pieces
+
+try:
+    try:
+        from uio import BytesIO
+    except ImportError:
+        from io import BytesIO
+    import msgpack
+
+    msgpack.Unpacker
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+def packb(obj):
+    b = BytesIO()
+    msgpack.pack(obj, b)
+    return b.getvalue()
+
+
+objs = [
+    1,
+    -200,
+    70000,
+    None,
+    True,
+    -0x12345678,
+    "abc",
+    "x" * 40,
+    b"\x01\x02",
+    b"y" * 300,
+    [1, [2, 3], {"a": 4}],
+    {"k%d" % i: i for i in range(20)},
+    list(range(20)),
+    msgpack.ExtType(5, b"ext"),
+]
+data = b"".join(packb(o) for o in objs)
+
+# whole buffer at once
+u = msgpack.Unpacker()
+u.feed(data)
+out = list(u)
+print(len(out), out[:9], out[9] == objs[9], out[10])
+print(out[11] == objs[11], out[12] == objs[12])
+print(out[13].code, out[13].data)
+
+# one byte at a time, objects come out as soon as they are complete
+u = msgpack.Unpacker()
+out = []
+for i in range(len(data)):
+    u.feed(data[i : i + 1])
+    for o in u:
+        out.append(o)
+print(len(out), out[:11] == objs[:11])
+
+# odd sized pieces through a reused bytearray
+u = msgpack.Unpacker(use_list=False)
+buf = bytearray(7)
+out = []
+for i in range(0, len(data), 7):
+    n = len(data[i : i + 7])
+    buf[:n] = data[i : i + 7]
+    u.feed(memoryview(buf)[:n])
+    out.extend(u)
+    buf[:] = b"\xff" * 7
+print(len(out), out[10])
+
+# nothing complete yet
+u = msgpack.Unpacker()
+print(list(u))
+u.feed(packb([1, 2, 3])[:2])
+print(list(u), u.unpack_into([]))
+
+# bin as memoryview of the fed bytes
+u = msgpack.Unpacker(use_memoryview=True)
+u.feed(packb(b"abc") + packb([b"de", b"f"]))
+v = next(u)
+print(type(v) is memoryview, bytes(v))
+print([bytes(x) for x in next(u)])
+
+# views into our own buffer survive further feeds
+u = msgpack.Unpacker(use_memoryview=True)
+p = packb(b"hello") + packb(b"world")
+u.feed(p[:3])
+u.feed(p[3:9])
+v = next(u)
+u.feed(p[9:])
+print(bytes(v), bytes(next(u)))
+
+# unpack into preallocated objects
+u = msgpack.Unpacker()
+u.feed(packb([4, 5, 6]) + packb([7]) + packb(b"xyz") + packb(1))
+lst = [0] * 5
+print(u.unpack_into(lst) is lst, lst)
+print(u.unpack_into(lst), lst)
+ba = bytearray(4)
+print(u.unpack_into(ba), ba)
+try:
+    u.unpack_into(ba)
+except TypeError:
+    print("TypeError")
+print(next(u))
+u.feed(packb(b"too long"))
+try:
+    u.unpack_into(ba)
+except ValueError:
+    print("ValueError")
+
+# a bad object is skipped rather than blocking the stream
+u = msgpack.Unpacker()
+u.feed(b"\xcf" + bytes(8) + packb(2))
+try:
+    next(u)
+except NotImplementedError:
+    print("NotImplementedError")
+print(next(u))
+
+# a fed bytearray may be changed or resized once feed() returns
+u = msgpack.Unpacker()
+ba = bytearray(packb(1) + packb("hello world"))
+u.feed(ba)
+print(next(u))
+ba[:] = b"\xc0" * len(ba)
+ba.extend(bytes(1000))
+print(next(u))
+u.feed(ba[:1])
+print(next(u))
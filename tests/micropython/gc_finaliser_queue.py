@@ -0,0 +1,64 @@
+# test that more objects with a finaliser than fit in the GC's finaliser queue
+# are each finalised exactly once, while what they refer to is still intact
+
+import gc
+
+try:
+    from iot import FinaliserProxy
+
+    gc.incremental
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# more than MICROPY_GC_FINALISER_QUEUE_LEN
+N = 200
+STRS = [str(i) for i in range(N)]
+
+
+class Res:
+    def __init__(self, i):
+        self.i = i
+        self.data = [i, STRS[i], bytearray(i % 7)]
+
+    def cleanup(self):
+        # the heap is locked in a finaliser, so don't allocate
+        d = self.data
+        if d[0] != self.i or d[1] != STRS[self.i] or len(d[2]) != self.i % 7:
+            bad[self.i] = 1
+        counts[self.i] += 1
+
+
+class CycleRes(Res):
+    # refers to its own proxy, like the FinaliserProxy example
+    def __init__(self, i):
+        super().__init__(i)
+        self.proxy = FinaliserProxy(self.cleanup)
+
+
+def make(cycle):
+    if cycle:
+        objs = [CycleRes(i) for i in range(N)]
+    else:
+        objs = [FinaliserProxy(Res(i).cleanup) for i in range(N)]
+    objs = None
+
+
+# With budget 0 the sweep calls every finaliser. Otherwise as many as fit are
+# queued and run in batches when allocations need memory, and by gc.collect().
+# The sweep calls the rest, except those that their own finaliser keeps alive
+# through a cycle, which wait for a later collection.
+for cycle in (False, True):
+    for budget in (0, 1, 100):
+        gc.incremental(budget)
+        counts = bytearray(N)
+        bad = bytearray(N)
+        make(cycle)
+        for i in range(2000):
+            garbage = bytearray(100)
+        for i in range(N):
+            gc.collect()
+            if min(counts) > 0:
+                break
+        print(cycle, budget, min(counts), max(counts), sum(bad))
+gc.incremental(0)
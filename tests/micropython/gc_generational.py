@@ -0,0 +1,81 @@
+# test generational collection by the GC
+
+import gc
+
+try:
+    gc.generational
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+print(gc.generational())
+
+# containers that survive enough collections to become old
+old_list = [None] * 100
+old_dict = {}
+
+
+class Old:
+    pass
+
+
+old_obj = Old()
+for i in range(4):
+    gc.collect()
+
+# young objects only referenced from old ones must survive minor collections
+for i in range(100):
+    old_list[i] = [i, str(i)]
+    old_dict[i] = (i, [i] * 3)
+    setattr(old_obj, "a%d" % i, bytearray(i))
+    if i % 10 == 0:
+        gc.collect(0)
+for i in range(10):
+    garbage = [bytearray(100) for j in range(100)]
+    gc.collect(0)
+ok = True
+for i in range(100):
+    if old_list[i] != [i, str(i)] or old_dict[i] != (i, [i] * 3):
+        ok = False
+    if len(getattr(old_obj, "a%d" % i)) != i:
+        ok = False
+print(ok)
+
+# churn through garbage with automatic (mostly minor) collections
+live = []
+for i in range(500):
+    live.append([i, str(i)])
+    for j in range(20):
+        garbage = bytearray(120 + j)
+print(all(x == [i, str(i)] for i, x in enumerate(live)))
+
+# old objects that have died are only freed by a major collection
+gc.collect()
+old_list = None
+gc.collect(0)
+before = gc.mem_free()
+gc.collect()
+print(gc.mem_free() > before + 2000)
+
+# objects allocated while an automatic collection's sweep is still pending
+# have survived no collection, so one more doesn't make them old
+budget = gc.incremental()
+gc.collect()
+gc.incremental(1)
+gc.threshold(2000)
+garbage = [bytearray(100) for i in range(40)]
+gc.threshold(-1)
+young = [bytearray(200) for i in range(50)]
+gc.collect(0)
+young = None
+before = gc.mem_free()
+gc.collect(0)
+print(gc.mem_free() > before + 8000)
+gc.incremental(budget)
+
+# only major collections
+gc.generational(0)
+print(gc.generational())
+gc.collect(0)
+print(all(x == [i, str(i)] for i, x in enumerate(live)))
+gc.generational(8)
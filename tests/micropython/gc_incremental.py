@@ -0,0 +1,61 @@
+# test incremental sweeping by the GC
+
+import gc
+
+try:
+    gc.incremental
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+# the smallest budget makes each sweep step do as little as possible
+gc.incremental(1)
+print(gc.incremental())
+
+# churn through garbage so that automatic collections happen while live data
+# is being built, and check that no live data is lost
+live = []
+for i in range(500):
+    live.append([i, str(i), bytearray(i % 20)])
+    for j in range(20):
+        garbage = bytearray(120 + j)
+ok = True
+for i, x in enumerate(live):
+    if x[0] != i or x[1] != str(i) or len(x[2]) != i % 20:
+        ok = False
+print(ok)
+
+# live data that grows in place by reallocation
+l = []
+for i in range(1000):
+    l.append(i)
+    garbage = [i] * 10
+print(sum(l) == sum(range(1000)))
+
+# a dict growing in place next to dead objects that the sweep hasn't freed yet
+d = {}
+for i in range(1500):
+    d[i] = i
+    if i % 3:
+        del d[list(d)[0]]
+    garbage = [k for k in d if d[k] == 5]
+print(len(d) == 500 and all(d[k] == k for k in d))
+
+count, total, longest, recent = gc.pause_stats()
+print(count > 0, total >= longest, len(recent) <= count)
+
+# an explicit collection sweeps the whole heap
+gc.collect()
+before = gc.mem_free()
+gc.collect()
+print(gc.mem_free() == before)
+
+# reset the statistics
+gc.pause_stats(True)
+print(gc.pause_stats()[0])
+
+# turn incremental sweeping off
+gc.incremental(0)
+print(gc.incremental())
+gc.collect()
+print(gc.pause_stats()[0])
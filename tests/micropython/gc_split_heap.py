@@ -0,0 +1,65 @@
+# test placement of objects across the heap areas
+
+import gc
+
+try:
+    gc.mem_areas
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+if len(gc.mem_areas()) < 2:
+    print("SKIP")
+    raise SystemExit
+
+
+def area_free():
+    return [free for start, total, free in gc.mem_areas()]
+
+
+def area_of(addr):
+    for i, (start, total, free) in enumerate(gc.mem_areas()):
+        if start <= addr < start + total:
+            return i
+
+
+print(gc.large_threshold())
+
+# a large buffer goes to the large area, small objects to the first one
+gc.collect()
+free0 = area_free()
+buf = bytearray(8192)
+free1 = area_free()
+print(free0[1] - free1[1] >= 8192, free0[0] - free1[0] < 1024)
+small = [i * 0.5 for i in range(10)]
+print(area_of(id(small)), area_of(id(small[3])))
+
+# with placement off the first area is tried first for everything
+gc.large_threshold(0)
+gc.collect()
+free0 = area_free()
+buf2 = bytearray(8192)
+free1 = area_free()
+print(free0[0] - free1[0] >= 8192)
+gc.large_threshold(1024)
+
+# objects referred to from another area survive collections
+big = [(i, str(i)) for i in range(1000)]
+bufs = [bytearray(2000) for i in range(20)]
+for i, b in enumerate(bufs):
+    b[0] = i
+for i in range(3):
+    gc.collect()
+    junk = [bytearray(3000) for i in range(10)] + [[i] for i in range(100)]
+junk = None
+gc.collect()
+print(all(big[i] == (i, str(i)) for i in range(1000)))
+print([b[0] for b in bufs] == list(range(20)))
+
+# freeing the buffers gives their memory back to the large area (allowing for
+# a few that stale pointers keep alive)
+free0 = area_free()
+buf = buf2 = bufs = None
+gc.collect()
+free1 = area_free()
+print(free1[1] - free0[1] >= 8192 + 10 * 2000)
@@ -42,6 +42,7 @@ class Config:
     MICROPY_LONGINT_IMPL_NONE = 0
     MICROPY_LONGINT_IMPL_LONGLONG = 1
     MICROPY_LONGINT_IMPL_MPZ = 2
+    MICROPY_OPT_SUPERINSTRUCTIONS = False
 config = Config()
 
 MP_OPCODE_BYTE = 0
@@ -58,6 +59,12 @@ MP_BC_LOAD_NAME = 0x1c
 MP_BC_LOAD_GLOBAL = 0x1d
 MP_BC_LOAD_ATTR = 0x1e
 MP_BC_STORE_ATTR = 0x26
+# superinstructions, with extra bytes:
+MP_BC_LOAD_FAST_FAST = 0x48
+MP_BC_BINARY_OP_FAST_FAST = 0x49
+MP_BC_LOAD_FAST_ATTR = 0x4a
+MP_BC_BINARY_OP_POP_JUMP_IF_TRUE = 0x4b
+MP_BC_BINARY_OP_POP_JUMP_IF_FALSE = 0x4c
 
 # load opcode names
 opcode_names = {}
@@ -99,8 +106,8 @@ def make_opcode_format():
     OC4(U, O, B, O), # 0x3c-0x3f
     OC4(O, B, B, O), # 0x40-0x43
     OC4(B, B, O, B), # 0x44-0x47
-    OC4(U, U, U, U), # 0x48-0x4b
-    OC4(U, U, U, U), # 0x4c-0x4f
+    OC4(B, B, Q, O), # 0x48-0x4b
+    OC4(O, U, U, U), # 0x4c-0x4f
     OC4(V, V, U, V), # 0x50-0x53
     OC4(B, U, V, V), # 0x54-0x57
     OC4(V, V, V, B), # 0x58-0x5b
@@ -160,6 +167,8 @@ def mp_opcode_format(bytecode, ip, opcode_format=make_opcode_format()):
     f = (opcode_format[opcode >> 2] >> (2 * (opcode & 3))) & 3
     if f == MP_OPCODE_QSTR:
         ip += 3
+        if opcode == MP_BC_LOAD_FAST_ATTR:
+            ip += 1 + config.MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
     else:
         extra_byte = (
             opcode == MP_BC_RAISE_VARARGS
@@ -171,7 +180,12 @@ def mp_opcode_format(bytecode, ip, opcode_format=make_opcode_format()):
                 or opcode == MP_BC_LOAD_ATTR
                 or opcode == MP_BC_STORE_ATTR
             )
+            or opcode == MP_BC_LOAD_FAST_FAST
+            or opcode == MP_BC_BINARY_OP_POP_JUMP_IF_TRUE
+            or opcode == MP_BC_BINARY_OP_POP_JUMP_IF_FALSE
         )
+        if opcode == MP_BC_BINARY_OP_FAST_FAST:
+            extra_byte = 2
         ip += 1
         if f == MP_OPCODE_VAR_UINT:
             while bytecode[ip] & 0x80 != 0:
@@ -286,7 +300,7 @@ class RawCode:
                 opcode = '0x%02x' % opcode
             if f == 1:
                 qst = self._unpack_qstr(ip + 1).qstr_id
-                print('    {}, {} & 0xff, {} >> 8,'.format(opcode, qst, qst))
+                print('    {}, {} & 0xff, {} >> 8,{}'.format(opcode, qst, qst, ''.join(' 0x%02x,' % self.bytecode[ip + i] for i in range(3, sz))))
             else:
                 print('    {},{}'.format(opcode, ''.join(' 0x%02x,' % self.bytecode[ip + i] for i in range(1, sz))))
             ip += sz
@@ -470,6 +484,7 @@ def read_mpy(filename):
         feature_flags = header[2]
         config.MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE = (feature_flags & 1) != 0
         config.MICROPY_PY_BUILTINS_STR_UNICODE = (feature_flags & 2) != 0
+        config.MICROPY_OPT_SUPERINSTRUCTIONS |= (feature_flags & 4) != 0
         config.mp_small_int_bits = header[3]
         return read_raw_code(f)
 
@@ -499,6 +514,12 @@ def freeze_mpy(base_qstrs, raw_codes):
     print('#endif')
     print()
 
+    if config.MICROPY_OPT_SUPERINSTRUCTIONS:
+        print('#if !MICROPY_OPT_SUPERINSTRUCTIONS')
+        print('#error "frozen bytecode uses superinstructions; build with MICROPY_OPT_SUPERINSTRUCTIONS or pass -mno-superinstructions to mpy-cross"')
+        print('#endif')
+        print()
+
     print('#if MICROPY_LONGINT_IMPL != %u' % config.MICROPY_LONGINT_IMPL)
     print('#error "incompatible MICROPY_LONGINT_IMPL"')
     print('#endif')